@@ -0,0 +1,68 @@
+-- Синтетические данные для tests/plans/test_query_plans.py: 2000 паков по 20
+-- вопросов с 4 вариантами, у каждого пака опубликована версия 1 и есть
+-- статистика.
+-- id детерминированы (md5 от номеров), чтобы тесты могли на них ссылаться.
+-- Триггеры (уведомления и внешние ключи) на время загрузки выключены.
+SET session_replication_role = replica;
+
+INSERT INTO quiz.packs (id, title, version, updated_at)
+SELECT
+    md5('pack-' || p)::UUID,
+    'Pack ' || md5(p::TEXT),
+    1,
+    '2026-01-01 00:00:00+00'::TIMESTAMPTZ + p * INTERVAL '1 minute'
+FROM generate_series(1, 2000) AS p;
+
+INSERT INTO quiz.questions (id, pack_id, text, image_url)
+SELECT
+    md5('question-' || p || '-' || q)::UUID,
+    md5('pack-' || p)::UUID,
+    'Question ' || q || ' of pack ' || p,
+    CASE
+        WHEN q % 2 = 0 THEN 'http://example.com/' || p || '/' || q || '.jpg'
+    END
+FROM generate_series(1, 2000) AS p, generate_series(1, 20) AS q;
+
+INSERT INTO quiz.variants (id, question_id, text, is_correct)
+SELECT
+    md5('variant-' || p || '-' || q || '-' || v)::UUID,
+    md5('question-' || p || '-' || q)::UUID,
+    'Variant ' || v,
+    v = 1
+FROM generate_series(1, 2000) AS p,
+    generate_series(1, 20) AS q,
+    generate_series(1, 4) AS v;
+
+INSERT INTO quiz.pack_versions (pack_id, version, title, questions, variants)
+SELECT
+    p.id,
+    p.version,
+    p.title,
+    ARRAY(
+        SELECT ROW(q.id, q.pack_id, q.text, q.image_url)::quiz.question
+        FROM quiz.questions q
+        WHERE q.pack_id = p.id
+        ORDER BY q.id
+    ),
+    ARRAY(
+        SELECT ROW(v.id, v.question_id, v.text, v.is_correct)::quiz.variant
+        FROM quiz.variants v
+        JOIN quiz.questions q ON q.id = v.question_id
+        WHERE q.pack_id = p.id
+        ORDER BY v.question_id, v.id
+    )
+FROM quiz.packs p;
+
+INSERT INTO quiz.pack_stats (pack_id, answers, players)
+SELECT id, 100, decode(repeat('00', 256), 'hex')
+FROM quiz.packs;
+
+INSERT INTO quiz.question_stats (question_id, attempts, correct, players)
+SELECT id, 10, 5, decode(repeat('00', 256), 'hex')
+FROM quiz.questions;
+
+INSERT INTO quiz.variant_stats (variant_id, picks)
+SELECT id, 3
+FROM quiz.variants;
+
+RESET session_replication_role;
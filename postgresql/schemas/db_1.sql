@@ -12,10 +12,16 @@ CREATE EXTENSION IF NOT EXISTS "uuid-ossp";
 -- Создаём схему quiz
 CREATE SCHEMA IF NOT EXISTS quiz;
 
--- Таблица packs: id UUID, генерируется автоматически
+-- Таблица packs: id UUID, сервис сам генерирует UUIDv7 (упорядочены по
+-- времени), DEFAULT остаётся для ручных вставок
 CREATE TABLE IF NOT EXISTS quiz.packs (
     id UUID PRIMARY KEY DEFAULT uuid_generate_v4(),
-    title TEXT NOT NULL
+    title TEXT NOT NULL,
+    -- Последняя опубликованная версия, 0 если пак ещё не публиковался
+    version INTEGER NOT NULL DEFAULT 0,
+    -- Время последнего изменения пака, его вопросов или вариантов,
+    -- поддерживается триггерами ниже. По нему фильтрует экспорт каталога
+    updated_at TIMESTAMPTZ NOT NULL DEFAULT now()
 );
 
 -- Таблица questions
@@ -34,9 +40,18 @@ CREATE TABLE IF NOT EXISTS quiz.variants (
     is_correct BOOLEAN NOT NULL DEFAULT FALSE
 );
 
--- Индексы для ускорения JOIN'ов и фильтрации
-CREATE INDEX idx_questions_pack_id ON quiz.questions(pack_id);
-CREATE INDEX idx_variants_question_id ON quiz.variants(question_id);
+-- Индексы для ускорения JOIN'ов и фильтрации. Планы всех запросов из
+-- src/queries проверяет tests/plans/test_query_plans.py
+-- Список паков отсортирован по title и читается только из индекса
+CREATE INDEX idx_packs_title ON quiz.packs(title) INCLUDE (id);
+-- id во втором столбце отдаёт вопросы пака уже упорядоченными по id
+CREATE INDEX idx_questions_pack_id ON quiz.questions(pack_id, id);
+-- Покрывающий: варианты вопроса читаются без обращения к таблице
+CREATE INDEX idx_variants_question_id ON quiz.variants(question_id, id)
+    INCLUDE (text, is_correct);
+-- Экспорт каталога идёт по паку в порядке изменения, инкрементальный
+-- экспорт (modified_since) читает только хвост индекса
+CREATE INDEX idx_packs_updated_at ON quiz.packs(updated_at, id);
 
 ---
 
@@ -58,3 +73,173 @@ CREATE TYPE quiz.variant AS (
     text TEXT,
     is_correct BOOLEAN
 );
+
+---
+
+-- Опубликованные версии паков: неизменяемые снимки черновика (quiz.packs,
+-- quiz.questions и quiz.variants) на момент публикации. Внешнего ключа на
+-- quiz.packs нет: удаление пака удаляет только черновик, а на опубликованные
+-- версии могут ссылаться идущие игры. id паков не переиспользуются, так что
+-- версии удалённого пака не спутать с версиями другого
+CREATE TABLE IF NOT EXISTS quiz.pack_versions (
+    pack_id UUID NOT NULL,
+    version INTEGER NOT NULL,
+    title TEXT NOT NULL,
+    questions quiz.question[] NOT NULL,
+    variants quiz.variant[] NOT NULL,
+    published_at TIMESTAMPTZ NOT NULL DEFAULT now(),
+    PRIMARY KEY (pack_id, version)
+);
+
+CREATE OR REPLACE FUNCTION quiz.forbid_pack_version_update() RETURNS trigger AS $$
+BEGIN
+    RAISE EXCEPTION 'published pack versions are immutable';
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER pack_versions_immutable
+BEFORE UPDATE ON quiz.pack_versions
+FOR EACH ROW EXECUTE FUNCTION quiz.forbid_pack_version_update();
+
+---
+
+-- Любое изменение пака, его вопросов или вариантов публикует id пака в канал
+-- quiz_pack_changed, все инстансы сервиса слушают его и сбрасывают кэши.
+-- Внутри одной транзакции одинаковые уведомления схлопываются.
+CREATE OR REPLACE FUNCTION quiz.notify_pack_changed() RETURNS trigger AS $$
+DECLARE
+    changed_pack_id UUID;
+BEGIN
+    IF TG_TABLE_NAME = 'packs' THEN
+        changed_pack_id := CASE WHEN TG_OP = 'DELETE' THEN OLD.id ELSE NEW.id END;
+    ELSIF TG_TABLE_NAME = 'questions' THEN
+        changed_pack_id := CASE WHEN TG_OP = 'DELETE' THEN OLD.pack_id ELSE NEW.pack_id END;
+    ELSE
+        SELECT pack_id INTO changed_pack_id
+        FROM quiz.questions
+        WHERE id = CASE WHEN TG_OP = 'DELETE' THEN OLD.question_id ELSE NEW.question_id END;
+    END IF;
+
+    -- При каскадном удалении вопрос уже удалён, а пак уже уведомлён
+    IF changed_pack_id IS NOT NULL THEN
+        PERFORM pg_notify('quiz_pack_changed', changed_pack_id::TEXT);
+    END IF;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER packs_notify_changed
+AFTER INSERT OR UPDATE OR DELETE ON quiz.packs
+FOR EACH ROW EXECUTE FUNCTION quiz.notify_pack_changed();
+
+CREATE TRIGGER questions_notify_changed
+AFTER INSERT OR UPDATE OR DELETE ON quiz.questions
+FOR EACH ROW EXECUTE FUNCTION quiz.notify_pack_changed();
+
+CREATE TRIGGER variants_notify_changed
+AFTER INSERT OR UPDATE OR DELETE ON quiz.variants
+FOR EACH ROW EXECUTE FUNCTION quiz.notify_pack_changed();
+
+---
+
+-- updated_at пака сдвигается при любом изменении самого пака, его вопросов
+-- или вариантов
+CREATE OR REPLACE FUNCTION quiz.set_pack_updated_at() RETURNS trigger AS $$
+BEGIN
+    NEW.updated_at := now();
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER packs_set_updated_at
+BEFORE UPDATE ON quiz.packs
+FOR EACH ROW EXECUTE FUNCTION quiz.set_pack_updated_at();
+
+-- Триггеры уровня оператора: пакетная вставка вариантов обновляет каждый
+-- затронутый пак один раз, а не по разу на строку. Транзитные таблицы
+-- new_rows и old_rows есть только у соответствующих операций, поэтому
+-- триггеров по одному на операцию
+CREATE OR REPLACE FUNCTION quiz.touch_parent_pack() RETURNS trigger AS $$
+DECLARE
+    -- pack_id у вопросов, question_id у вариантов
+    parent_ids UUID[] := '{}';
+BEGIN
+    IF TG_OP <> 'DELETE' THEN
+        IF TG_TABLE_NAME = 'questions' THEN
+            parent_ids := ARRAY(SELECT DISTINCT pack_id FROM new_rows);
+        ELSE
+            parent_ids := ARRAY(SELECT DISTINCT question_id FROM new_rows);
+        END IF;
+    END IF;
+    IF TG_OP <> 'INSERT' THEN
+        IF TG_TABLE_NAME = 'questions' THEN
+            parent_ids := parent_ids || ARRAY(SELECT DISTINCT pack_id FROM old_rows);
+        ELSE
+            parent_ids := parent_ids || ARRAY(SELECT DISTINCT question_id FROM old_rows);
+        END IF;
+    END IF;
+    IF TG_TABLE_NAME = 'variants' THEN
+        parent_ids := ARRAY(
+            SELECT DISTINCT pack_id FROM quiz.questions WHERE id = ANY(parent_ids)
+        );
+    END IF;
+
+    -- При каскадном удалении пака обновлять уже нечего
+    UPDATE quiz.packs SET updated_at = now() WHERE id = ANY(parent_ids);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER questions_insert_touch_pack
+AFTER INSERT ON quiz.questions
+REFERENCING NEW TABLE AS new_rows
+FOR EACH STATEMENT EXECUTE FUNCTION quiz.touch_parent_pack();
+
+CREATE TRIGGER questions_update_touch_pack
+AFTER UPDATE ON quiz.questions
+REFERENCING OLD TABLE AS old_rows NEW TABLE AS new_rows
+FOR EACH STATEMENT EXECUTE FUNCTION quiz.touch_parent_pack();
+
+CREATE TRIGGER questions_delete_touch_pack
+AFTER DELETE ON quiz.questions
+REFERENCING OLD TABLE AS old_rows
+FOR EACH STATEMENT EXECUTE FUNCTION quiz.touch_parent_pack();
+
+CREATE TRIGGER variants_insert_touch_pack
+AFTER INSERT ON quiz.variants
+REFERENCING NEW TABLE AS new_rows
+FOR EACH STATEMENT EXECUTE FUNCTION quiz.touch_parent_pack();
+
+CREATE TRIGGER variants_update_touch_pack
+AFTER UPDATE ON quiz.variants
+REFERENCING OLD TABLE AS old_rows NEW TABLE AS new_rows
+FOR EACH STATEMENT EXECUTE FUNCTION quiz.touch_parent_pack();
+
+CREATE TRIGGER variants_delete_touch_pack
+AFTER DELETE ON quiz.variants
+REFERENCING OLD TABLE AS old_rows
+FOR EACH STATEMENT EXECUTE FUNCTION quiz.touch_parent_pack();
+
+---
+
+-- Статистика ответов, сбрасывается из памяти инстансов раз в flush-interval
+-- (см. src/components/answer_analytics). Внешних ключей нет: удалённые паки
+-- не должны ронять сброс статистики, а шард у строки тот же, что у её сущности.
+-- players - сериализованный HyperLogLog уникальных игроков
+CREATE TABLE IF NOT EXISTS quiz.pack_stats (
+    pack_id UUID PRIMARY KEY,
+    answers BIGINT NOT NULL DEFAULT 0,
+    players BYTEA NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS quiz.question_stats (
+    question_id UUID PRIMARY KEY,
+    attempts BIGINT NOT NULL DEFAULT 0,
+    correct BIGINT NOT NULL DEFAULT 0,
+    players BYTEA NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS quiz.variant_stats (
+    variant_id UUID PRIMARY KEY,
+    picks BIGINT NOT NULL DEFAULT 0
+);
@@ -0,0 +1,73 @@
+#include "answer_analytics.hpp"
+
+#include <chrono>
+#include <exception>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/answer_stats.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultFlushInterval{1000};
+
+} // namespace
+
+AnswerAnalytics::AnswerAnalytics(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : ComponentBase(config, component_context),
+      shards_(
+          component_context.FindComponent<ShardedStorage>().GetRouter()
+      ) {
+    const auto flush_interval = config["flush-interval"].As<
+        std::chrono::milliseconds>(kDefaultFlushInterval);
+    flush_task_.Start(
+        "answer-analytics-flush",
+        userver::utils::PeriodicTask::Settings{flush_interval},
+        [this] { Flush(); }
+    );
+}
+
+AnswerAnalytics::~AnswerAnalytics() {
+    flush_task_.Stop();
+    Flush();
+}
+
+void AnswerAnalytics::Record(const AnswerAggregator::Answer& answer) {
+    aggregator_.Record(answer);
+}
+
+void AnswerAnalytics::Flush() {
+    const auto shard_deltas =
+        NStorage::SplitAnswerStatsDelta(shards_, aggregator_.CollectDelta());
+    for (const auto& shard_delta : shard_deltas) {
+        // A failed shard keeps its increments pending until the next flush
+        try {
+            NStorage::SaveAnswerStats(shards_, shard_delta);
+            aggregator_.CommitDelta(shard_delta);
+        } catch (const std::exception& e) {
+            LOG_WARNING() << "Failed to flush answer stats: " << e;
+        }
+    }
+}
+
+auto AnswerAnalytics::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: in-memory answer analytics periodically flushed to Postgres
+additionalProperties: false
+properties:
+    flush-interval:
+        type: string
+        description: how often aggregated answers are saved, 1s by default
+)");
+}
+
+} // namespace game_userver
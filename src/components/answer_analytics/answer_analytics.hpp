@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string_view>
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include "logic/analytics/answer_aggregator.hpp"
+#include "storage/shard_router.hpp"
+
+namespace game_userver {
+
+// Streaming answer analytics. Answers are aggregated in memory by an
+// AnswerAggregator and flushed to the shards every `flush-interval`, so a
+// submitted answer costs no write query and the stored stats lag behind by
+// at most one interval. Every instance flushes its own increments, the
+// stored counters are sums and the unique player sketches are unions over
+// all instances.
+//
+// What was not flushed when the process dies is lost; on a clean shutdown
+// one last flush is made.
+class AnswerAnalytics final : public userver::components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "answer-analytics";
+
+    AnswerAnalytics(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+    ~AnswerAnalytics() override;
+
+    void Record(const AnswerAggregator::Answer& answer);
+
+    // Saves everything recorded so far, public for tests
+    void Flush();
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    const NStorage::ShardRouter& shards_;
+    AnswerAggregator aggregator_;
+    userver::utils::PeriodicTask flush_task_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::AnswerAnalytics> = true;
@@ -0,0 +1,55 @@
+#include "deadline_propagation.hpp"
+
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/http/http_status.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include "utils/deadline.hpp"
+
+namespace game_userver {
+
+namespace {
+
+void SetGatewayTimeout(userver::server::http::HttpRequest& request) {
+    auto& response = request.GetHttpResponse();
+    response.SetStatus(userver::server::http::HttpStatus::kGatewayTimeout);
+    response.SetData("Deadline exceeded");
+}
+
+class DeadlinePropagationMiddleware final
+    : public userver::server::middlewares::HttpMiddlewareBase {
+private:
+    void HandleRequest(
+        userver::server::http::HttpRequest& request,
+        userver::server::request::RequestContext& context
+    ) const override {
+        if (Utils::DeadlineFromHttp(request).IsReached()) {
+            SetGatewayTimeout(request);
+            return;
+        }
+
+        try {
+            Next(request, context);
+        } catch (const Utils::DeadlineExceeded&) {
+            SetGatewayTimeout(request);
+        } catch (const userver::storages::postgres::QueryCancelled&) {
+            // The statement timeout, shrunk to what is left of the deadline
+            SetGatewayTimeout(request);
+        } catch (const userver::storages::postgres::ConnectionTimeoutError&) {
+            SetGatewayTimeout(request);
+        }
+    }
+};
+
+} // namespace
+
+auto DeadlinePropagation::Create(
+    const userver::server::handlers::HttpHandlerBase& /*handler*/,
+    userver::yaml_config::YamlConfig /*middleware_config*/
+) const -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase> {
+    return std::make_unique<DeadlinePropagationMiddleware>();
+}
+
+} // namespace game_userver
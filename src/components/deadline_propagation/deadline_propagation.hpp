@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <userver/components/component_fwd.hpp>
+#include <userver/server/middlewares/http_middleware_base.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+namespace game_userver {
+
+// HTTP counterpart of the gRPC deadline checks in Service: requests that
+// arrive with an already exhausted `X-Deadline` budget are rejected before
+// reaching the handler. Utils::DeadlineExceeded thrown by the storage layer
+// and queries cancelled by a statement timeout shrunk to the budget are
+// answered with 504 instead of a generic 500.
+class DeadlinePropagation final
+    : public userver::server::middlewares::HttpMiddlewareFactoryBase {
+public:
+    static constexpr std::string_view kName = "deadline-propagation";
+
+    using HttpMiddlewareFactoryBase::HttpMiddlewareFactoryBase;
+
+private:
+    auto Create(
+        const userver::server::handlers::HttpHandlerBase& handler,
+        userver::yaml_config::YamlConfig middleware_config
+    ) const
+        -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase>
+        override;
+};
+
+} // namespace game_userver
@@ -0,0 +1,194 @@
+#include "live_rooms.hpp"
+
+#include <mutex>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/utils/statistics/rate.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <utility>
+#include <vector>
+
+#include "models/live_room.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::size_t kDefaultMaxQueuedMessages = 64;
+
+} // namespace
+
+LiveRooms::LiveRooms(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : ComponentBase(config, component_context),
+      sessions_(component_context.FindComponent<LiveSessions>()),
+      max_queued_messages_(config["max-queued-messages"].As<std::size_t>(
+          kDefaultMaxQueuedMessages
+      )) {
+    subscription_ =
+        sessions_.Subscribe(this, kName, &LiveRooms::OnRoundChange);
+    statistics_entry_ =
+        component_context
+            .FindComponent<userver::components::StatisticsStorage>()
+            .GetStorage()
+            .RegisterWriter(
+                std::string{kName},
+                [this](userver::utils::statistics::Writer& writer) {
+                    WriteStatistics(writer);
+                }
+            );
+}
+
+LiveRooms::~LiveRooms() {
+    statistics_entry_.Unregister();
+    subscription_.Unsubscribe();
+}
+
+auto LiveRooms::Join(const boost::uuids::uuid& session_id)
+    -> std::unique_ptr<Participant> {
+    const auto session = sessions_.Get(session_id);
+    if (!session) {
+        return nullptr;
+    }
+
+    auto queue = Queue::Create(max_queued_messages_);
+    const auto id = ++next_participant_id_;
+    auto room = rooms_.Join(*session, id, queue->GetProducer());
+    if (!room) {
+        return nullptr;
+    }
+    ++participants_;
+    std::unique_ptr<Participant> participant{
+        new Participant(*this, room, id, queue->GetConsumer())
+    };
+
+    // The session may have expired before the room was there to hear it
+    if (!sessions_.Get(session_id)) {
+        const std::lock_guard lock{room->mutex};
+        Close(*room);
+    }
+    return participant;
+}
+
+void LiveRooms::OnRoundChange(const LiveSessions::RoundChange& change) {
+    const auto room = rooms_.Find(change.session.id);
+    if (!room) {
+        return;
+    }
+
+    const std::lock_guard lock{room->mutex};
+    if (room->closed) {
+        return;
+    }
+    if (change.expired) {
+        Close(*room);
+        return;
+    }
+    // Rounds skipped by the host and timed out are published by different
+    // tasks and may come out of order
+    if (change.session.question <= room->session.question) {
+        return;
+    }
+
+    std::vector<std::uint32_t> answers;
+    if (change.ended_question == room->session.question) {
+        answers = std::move(room->answers);
+    }
+    Broadcast(
+        *room, Models::MakeResultsMessage(
+                   change.session, change.ended_question, answers
+               )
+    );
+
+    room->StartRound(change.session);
+    Broadcast(*room, Models::MakeQuestionMessage(room->session));
+}
+
+void LiveRooms::Broadcast(Room& room, std::string message) {
+    const auto shared = std::make_shared<const std::string>(std::move(message));
+    for (auto it = room.participants.begin(); it != room.participants.end();) {
+        if (it->second.PushNoblock(Message{shared})) {
+            ++messages_;
+            ++it;
+            continue;
+        }
+        // Without its producer the connection ends once it sends what it has
+        ++dropped_;
+        it = room.participants.erase(it);
+    }
+    ++broadcasts_;
+}
+
+void LiveRooms::Close(Room& room) {
+    Broadcast(room, Models::MakeClosedMessage());
+    room.closed = true;
+    room.participants.clear();
+}
+
+void LiveRooms::WriteStatistics(
+    userver::utils::statistics::Writer& writer
+) const {
+    writer["rooms"] = rooms_.GetSize();
+    writer["participants"] = participants_.load();
+    writer["broadcasts"] = userver::utils::statistics::Rate{broadcasts_.load()};
+    writer["messages"] = userver::utils::statistics::Rate{messages_.load()};
+    writer["dropped-participants"] =
+        userver::utils::statistics::Rate{dropped_.load()};
+}
+
+auto LiveRooms::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: WebSocket rooms of live sessions with shared broadcasts
+additionalProperties: false
+properties:
+    max-queued-messages:
+        type: integer
+        description: messages a participant may lag behind before it is dropped
+)");
+}
+
+LiveRooms::Participant::Participant(
+    LiveRooms& rooms, std::shared_ptr<Room> room, std::uint64_t id,
+    Queue::Consumer consumer
+)
+    : rooms_(rooms), room_(std::move(room)), id_(id),
+      consumer_(std::move(consumer)) {}
+
+LiveRooms::Participant::~Participant() {
+    Leave();
+    --rooms_.participants_;
+}
+
+auto LiveRooms::Participant::Pop(Message& message) -> bool {
+    return consumer_.Pop(message);
+}
+
+auto LiveRooms::Participant::Answer(const boost::uuids::uuid& variant_id)
+    -> bool {
+    const std::lock_guard lock{room_->mutex};
+    const auto& session = room_->session;
+    if (session.IsFinished()) {
+        return false;
+    }
+    const auto& pack = *session.pack;
+    const auto first = pack.GetFirstVariant(session.question);
+    for (auto i = first; i < pack.GetLastVariant(session.question); ++i) {
+        if (pack.GetVariantId(i) != variant_id) {
+            continue;
+        }
+        if (room_->answered.insert(id_).second) {
+            ++room_->answers[i - first];
+        }
+        return true;
+    }
+    return false;
+}
+
+void LiveRooms::Participant::Leave() { rooms_.rooms_.Leave(room_, id_); }
+
+} // namespace game_userver
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/concurrent/async_event_source.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include "components/live_sessions/live_sessions.hpp"
+#include "room_registry.hpp"
+
+namespace game_userver {
+
+// Rooms of players connected to live sessions of this instance, see the
+// handler-live-room WebSocket and Models::ParseRoomCommand.
+//
+// Every event of a session is serialized once into an immutable buffer and
+// a pointer to it is queued to every participant, so a room of 10k players
+// costs one encode per event and no copies; each connection writes the
+// shared buffer out itself. A participant whose queue is full is dropped
+// instead of letting a slow client grow memory or hold the others back.
+//
+// Answers are only counted per room to be revealed with the results of the
+// round, they do not go to the answer statistics.
+class LiveRooms final : public userver::components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "live-rooms";
+
+    using Message = LiveRoomRegistry::Message;
+
+    class Participant;
+
+    LiveRooms(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+    ~LiveRooms() override;
+
+    // Returns nullptr if there is no such session on this instance. The
+    // current question is the first message queued.
+    auto Join(const boost::uuids::uuid& session_id)
+        -> std::unique_ptr<Participant>;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    using Queue = LiveRoomRegistry::Queue;
+    using Room = LiveRoomRegistry::Room;
+
+    void OnRoundChange(const LiveSessions::RoundChange& change);
+    // Both are called with the room mutex held
+    void Broadcast(Room& room, std::string message);
+    void Close(Room& room);
+    void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+    LiveSessions& sessions_;
+    const std::size_t max_queued_messages_;
+
+    LiveRoomRegistry rooms_;
+    std::atomic<std::uint64_t> next_participant_id_{0};
+
+    std::atomic<std::uint64_t> participants_{0};
+    std::atomic<std::uint64_t> broadcasts_{0};
+    std::atomic<std::uint64_t> messages_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    userver::concurrent::AsyncEventSubscriberScope subscription_;
+    userver::utils::statistics::Entry statistics_entry_;
+};
+
+// One connection in a room, leaves it when destroyed
+class LiveRooms::Participant final {
+public:
+    ~Participant();
+
+    Participant(const Participant&) = delete;
+    auto operator=(const Participant&) -> Participant& = delete;
+
+    // Waits for the next message to send. Returns false once the room is
+    // closed, the participant fell too far behind or left.
+    auto Pop(Message& message) -> bool;
+
+    // Counts the answer if it is the first one of this participant to the
+    // current question. Returns false if the variant is not in it.
+    auto Answer(const boost::uuids::uuid& variant_id) -> bool;
+
+    // Stops the messages, Pop returns false once the queued ones are taken.
+    // May be called concurrently with Pop.
+    void Leave();
+
+private:
+    friend class LiveRooms;
+
+    Participant(
+        LiveRooms& rooms, std::shared_ptr<Room> room, std::uint64_t id,
+        Queue::Consumer consumer
+    );
+
+    LiveRooms& rooms_;
+    const std::shared_ptr<Room> room_;
+    const std::uint64_t id_;
+    Queue::Consumer consumer_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::LiveRooms> = true;
@@ -0,0 +1,119 @@
+#include "room_registry.hpp"
+
+#include <mutex>
+#include <utility>
+
+#include "models/live_room.hpp"
+
+namespace game_userver {
+
+namespace {
+
+auto CountVariants(const Models::LiveSession& session) -> std::size_t {
+    if (session.IsFinished()) {
+        return 0;
+    }
+    return session.pack->GetLastVariant(session.question) -
+           session.pack->GetFirstVariant(session.question);
+}
+
+} // namespace
+
+LiveRoomRegistry::Room::Room(Models::LiveSession initial)
+    : session_id(initial.id), session(std::move(initial)),
+      answers(CountVariants(session), 0) {}
+
+void LiveRoomRegistry::Room::StartRound(Models::LiveSession next) {
+    session = std::move(next);
+    answered.clear();
+    answers.assign(CountVariants(session), 0);
+}
+
+auto LiveRoomRegistry::Find(const boost::uuids::uuid& session_id) const
+    -> std::shared_ptr<Room> {
+    const std::lock_guard lock{mutex_};
+    const auto it = rooms_.find(session_id);
+    if (it == rooms_.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+auto LiveRoomRegistry::FindOrCreate(const Models::LiveSession& session)
+    -> std::shared_ptr<Room> {
+    const std::lock_guard lock{mutex_};
+    auto& slot = rooms_[session.id];
+    if (!slot) {
+        slot = std::make_shared<Room>(session);
+    }
+    return slot;
+}
+
+auto LiveRoomRegistry::TryEnter(
+    Room& room, std::uint64_t id, Queue::Producer& producer
+) -> EnterResult {
+    const std::lock_guard lock{room.mutex};
+    if (room.removed) {
+        return EnterResult::kRemoved;
+    }
+    if (room.closed) {
+        return EnterResult::kClosed;
+    }
+    // The room may be a round behind the session if the event is on its
+    // way, the event brings the newer question then
+    producer.PushNoblock(std::make_shared<const std::string>(
+        Models::MakeQuestionMessage(room.session)
+    ));
+    room.participants.emplace(id, std::move(producer));
+    return EnterResult::kEntered;
+}
+
+auto LiveRoomRegistry::Join(
+    const Models::LiveSession& session, std::uint64_t id,
+    Queue::Producer producer
+) -> std::shared_ptr<Room> {
+    for (;;) {
+        auto room = FindOrCreate(session);
+        switch (TryEnter(*room, id, producer)) {
+            case EnterResult::kEntered:
+                return room;
+            case EnterResult::kClosed:
+                return nullptr;
+            case EnterResult::kRemoved:
+                // Its last participant left after the lookup
+                break;
+        }
+    }
+}
+
+void LiveRoomRegistry::Leave(
+    const std::shared_ptr<Room>& room, std::uint64_t id
+) {
+    {
+        const std::lock_guard lock{room->mutex};
+        room->participants.erase(id);
+        if (!room->participants.empty()) {
+            return;
+        }
+    }
+
+    const std::lock_guard lock{mutex_};
+    const auto it = rooms_.find(room->session_id);
+    if (it == rooms_.end() || it->second != room) {
+        return;
+    }
+    // Someone may have joined in between. Whoever found the room and is
+    // yet to lock it sees it removed and looks up again.
+    const std::lock_guard room_lock{room->mutex};
+    if (room->participants.empty()) {
+        room->removed = true;
+        rooms_.erase(it);
+    }
+}
+
+auto LiveRoomRegistry::GetSize() const -> std::size_t {
+    const std::lock_guard lock{mutex_};
+    return rooms_.size();
+}
+
+} // namespace game_userver
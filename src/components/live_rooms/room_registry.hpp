@@ -0,0 +1,83 @@
+#pragma once
+
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/mutex.hpp>
+#include <vector>
+
+#include "models/live_session.hpp"
+
+namespace game_userver {
+
+// The rooms of LiveRooms by session. A room is created by the first
+// participant and dropped with the last one. Joining looks a room up and
+// locks it separately, so the room may be dropped in between: it is then
+// marked `removed` and the participant has to look up again.
+class LiveRoomRegistry final {
+public:
+    using Message = std::shared_ptr<const std::string>;
+    using Queue = userver::concurrent::SpscQueue<Message>;
+
+    struct Room final {
+        explicit Room(Models::LiveSession initial);
+
+        // Moves on to the question of `next`, forgetting the answers
+        void StartRound(Models::LiveSession next);
+
+        const boost::uuids::uuid session_id;
+
+        userver::engine::Mutex mutex;
+        // As of the last event applied
+        Models::LiveSession session;
+        std::unordered_map<std::uint64_t, Queue::Producer> participants;
+        // Who answered the current question and how many times each
+        // variant was chosen
+        std::unordered_set<std::uint64_t> answered;
+        std::vector<std::uint32_t> answers;
+        bool closed = false;
+        // No longer in the registry, nobody may join it
+        bool removed = false;
+    };
+
+    enum class EnterResult { kEntered, kClosed, kRemoved };
+
+    auto Find(const boost::uuids::uuid& session_id) const
+        -> std::shared_ptr<Room>;
+    auto FindOrCreate(const Models::LiveSession& session)
+        -> std::shared_ptr<Room>;
+
+    // Queues the current question of the room to `producer` and takes it
+    // in, unless the room is closed or removed. The producer is left alone
+    // then.
+    static auto TryEnter(
+        Room& room, std::uint64_t id, Queue::Producer& producer
+    ) -> EnterResult;
+
+    // Enters the room of the session, looking up again while the one found
+    // gets removed. Returns nullptr if the room is closed.
+    auto Join(
+        const Models::LiveSession& session, std::uint64_t id,
+        Queue::Producer producer
+    ) -> std::shared_ptr<Room>;
+
+    // Drops the participant, and the room along with its last one
+    void Leave(const std::shared_ptr<Room>& room, std::uint64_t id);
+
+    auto GetSize() const -> std::size_t;
+
+private:
+    mutable userver::engine::Mutex mutex_;
+    std::unordered_map<
+        boost::uuids::uuid, std::shared_ptr<Room>,
+        boost::hash<boost::uuids::uuid>>
+        rooms_;
+};
+
+} // namespace game_userver
@@ -0,0 +1,227 @@
+#include "live_session_router.hpp"
+
+#include <boost/uuid/uuid_io.hpp>
+#include <grpcpp/client_context.h>
+#include <memory>
+#include <stdexcept>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/ugrpc/client/client_factory_component.hpp>
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+#include <utility>
+
+#include "utils/hash.hpp"
+#include "utils/uuid_v7.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::size_t kDefaultVirtualNodes = 128;
+
+auto HashSessionId(const boost::uuids::uuid& session_id) -> std::uint64_t {
+    return Utils::HashString(std::string_view{
+        reinterpret_cast<const char*>(session_id.data), session_id.size()
+    });
+}
+
+auto MakeContext(userver::engine::Deadline deadline)
+    -> std::unique_ptr<grpc::ClientContext> {
+    auto context = std::make_unique<grpc::ClientContext>();
+    if (deadline.IsReachable()) {
+        context->set_deadline(
+            std::chrono::system_clock::now() + deadline.TimeLeft()
+        );
+    }
+    return context;
+}
+
+auto ToJson(const Models::LiveSession& session)
+    -> userver::formats::json::Value {
+    return userver::formats::json::ValueBuilder{session}.ExtractValue();
+}
+
+auto FromResponse(const handlers::api::LiveSessionResponse& response)
+    -> userver::formats::json::Value {
+    return userver::formats::json::FromString(response.session_json());
+}
+
+auto MakeSessionRequest(const boost::uuids::uuid& session_id)
+    -> handlers::api::LiveSessionRequest {
+    handlers::api::LiveSessionRequest request;
+    request.set_session_id(boost::uuids::to_string(session_id));
+    return request;
+}
+
+} // namespace
+
+LiveSessionRouter::LiveSessionRouter(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : ComponentBase(config, component_context),
+      sessions_(component_context.FindComponent<LiveSessions>()) {
+    const auto& instances = config["instances"];
+    if (instances.IsMissing() || instances.GetSize() == 0) {
+        return;
+    }
+
+    const auto self = config["self"].As<std::string>();
+    std::vector<std::string> names;
+    std::vector<std::string> endpoints;
+    for (const auto& instance : instances) {
+        names.push_back(instance["name"].As<std::string>());
+        endpoints.push_back(instance["grpc-endpoint"].As<std::string>());
+    }
+    ring_.emplace(
+        names,
+        config["virtual-nodes"].As<std::size_t>(kDefaultVirtualNodes)
+    );
+
+    auto& factory =
+        component_context
+            .FindComponent<userver::ugrpc::client::ClientFactoryComponent>()
+            .GetFactory();
+    bool found_self = false;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == self) {
+            found_self = true;
+            clients_.emplace_back();
+            continue;
+        }
+        clients_.emplace_back(
+            factory.MakeClient<Client>("live-session-" + names[i], endpoints[i])
+        );
+    }
+    if (!found_self) {
+        throw std::runtime_error(
+            "live-session-router: 'self' " + self + " is not in 'instances'"
+        );
+    }
+}
+
+auto LiveSessionRouter::Start(
+    const NStorage::PackVersionPtr& pack,
+    std::optional<std::chrono::milliseconds> round_duration,
+    userver::engine::Deadline deadline
+) const -> userver::formats::json::Value {
+    const auto session_id = Utils::GenerateUuidV7();
+    const auto* owner = FindRemoteOwner(session_id);
+    if (!owner) {
+        return ToJson(sessions_.Start(session_id, pack, round_duration));
+    }
+
+    handlers::api::StartLiveSessionRequest request;
+    request.set_session_id(boost::uuids::to_string(session_id));
+    request.set_pack_id(boost::uuids::to_string(pack->GetPackId()));
+    request.set_version(pack->GetVersion());
+    request.set_round_duration_ms(
+        round_duration ? round_duration->count() : 0
+    );
+    return FromResponse(owner->StartSession(request, MakeContext(deadline)));
+}
+
+auto LiveSessionRouter::Get(
+    const boost::uuids::uuid& session_id, userver::engine::Deadline deadline
+) const -> std::optional<userver::formats::json::Value> {
+    const auto* owner = FindRemoteOwner(session_id);
+    if (!owner) {
+        const auto session = sessions_.Get(session_id);
+        if (!session) {
+            return std::nullopt;
+        }
+        return ToJson(*session);
+    }
+
+    try {
+        return FromResponse(owner->GetSession(
+            MakeSessionRequest(session_id), MakeContext(deadline)
+        ));
+    } catch (const userver::ugrpc::client::NotFoundError&) {
+        return std::nullopt;
+    }
+}
+
+auto LiveSessionRouter::NextQuestion(
+    const boost::uuids::uuid& session_id, userver::engine::Deadline deadline
+) const -> std::optional<userver::formats::json::Value> {
+    const auto* owner = FindRemoteOwner(session_id);
+    if (!owner) {
+        const auto session = sessions_.NextQuestion(session_id);
+        if (!session) {
+            return std::nullopt;
+        }
+        return ToJson(*session);
+    }
+
+    try {
+        return FromResponse(owner->NextQuestion(
+            MakeSessionRequest(session_id), MakeContext(deadline)
+        ));
+    } catch (const userver::ugrpc::client::NotFoundError&) {
+        return std::nullopt;
+    }
+}
+
+auto LiveSessionRouter::FindRemoteOwnerName(
+    const boost::uuids::uuid& session_id
+) const -> const std::string* {
+    const auto owner = FindOwner(session_id);
+    if (!owner || !clients_[*owner]) {
+        return nullptr;
+    }
+    return &ring_->GetNodes()[*owner];
+}
+
+auto LiveSessionRouter::FindRemoteOwner(const boost::uuids::uuid& session_id
+) const -> const Client* {
+    const auto owner = FindOwner(session_id);
+    if (!owner || !clients_[*owner]) {
+        return nullptr;
+    }
+    return &*clients_[*owner];
+}
+
+auto LiveSessionRouter::FindOwner(const boost::uuids::uuid& session_id) const
+    -> std::optional<std::size_t> {
+    if (!ring_) {
+        return std::nullopt;
+    }
+    return ring_->GetNode(HashSessionId(session_id));
+}
+
+auto LiveSessionRouter::GetStaticConfigSchema()
+    -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: routes live session calls to the instance owning the session
+additionalProperties: false
+properties:
+    self:
+        type: string
+        description: name of this instance in `instances`
+    instances:
+        type: array
+        description: all instances sharing live sessions, none if empty
+        items:
+            type: object
+            description: an instance
+            additionalProperties: false
+            properties:
+                name:
+                    type: string
+                    description: instance name, the same on every instance
+                grpc-endpoint:
+                    type: string
+                    description: host:port of its gRPC server
+    virtual-nodes:
+        type: integer
+        description: points per instance on the hash ring, 128 by default
+)");
+}
+
+} // namespace game_userver
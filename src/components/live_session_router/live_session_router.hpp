@@ -0,0 +1,89 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <chrono>
+#include <handlers/live_client.usrv.pb.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/yaml_config/fwd.hpp>
+#include <vector>
+
+#include "components/live_sessions/live_sessions.hpp"
+#include "storage/pack_versions.hpp"
+#include "utils/hash_ring.hpp"
+
+namespace game_userver {
+
+// Session affinity for live sessions across instances.
+//
+// A live session lives only in the memory of one instance, the owner of its
+// id on a Utils::HashRing over the `instances` of the config. Every instance
+// has the same ring, so any of them can take a session-bound call: it serves
+// the call from its own LiveSessions if it is the owner and forwards it over
+// the internal LiveSessionService gRPC otherwise. Adding an instance moves
+// only the sessions on its part of the ring.
+//
+// Without `instances` this instance owns every session. Sessions are
+// returned in the JSON of the HTTP API, as that is what gets forwarded.
+//
+// Live rooms are WebSockets and are not forwarded: a room has to be opened
+// on the owner, see FindRemoteOwnerName.
+class LiveSessionRouter final : public userver::components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "live-session-router";
+
+    LiveSessionRouter(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+
+    // Starts a session under a new id on the instance that owns it
+    auto Start(
+        const NStorage::PackVersionPtr& pack,
+        std::optional<std::chrono::milliseconds> round_duration,
+        userver::engine::Deadline deadline = {}
+    ) const -> userver::formats::json::Value;
+
+    [[nodiscard]] auto
+    Get(const boost::uuids::uuid& session_id,
+        userver::engine::Deadline deadline = {}) const
+        -> std::optional<userver::formats::json::Value>;
+
+    auto NextQuestion(
+        const boost::uuids::uuid& session_id,
+        userver::engine::Deadline deadline = {}
+    ) const -> std::optional<userver::formats::json::Value>;
+
+    // Name of the instance owning the session, nullptr if it is this one
+    [[nodiscard]] auto FindRemoteOwnerName(const boost::uuids::uuid& session_id
+    ) const -> const std::string*;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    using Client = handlers::api::LiveSessionServiceClient;
+
+    // Returns nullptr if this instance owns the session
+    [[nodiscard]] auto FindRemoteOwner(const boost::uuids::uuid& session_id
+    ) const -> const Client*;
+
+    // Ring node of the session, std::nullopt without a ring
+    [[nodiscard]] auto FindOwner(const boost::uuids::uuid& session_id) const
+        -> std::optional<std::size_t>;
+
+    LiveSessions& sessions_;
+    std::optional<Utils::HashRing> ring_;
+    // By ring node, std::nullopt for this instance
+    std::vector<std::optional<Client>> clients_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::LiveSessionRouter> = true;
@@ -0,0 +1,424 @@
+#include "live_sessions.hpp"
+
+#include <exception>
+#include <mutex>
+#include <string>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/statistics/rate.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultTick{10};
+constexpr std::chrono::milliseconds kDefaultRoundDuration{20000};
+constexpr std::chrono::milliseconds kDefaultFinishedRetention{60000};
+constexpr std::size_t kDefaultJournalSegmentSize = 64 * 1024 * 1024;
+
+using RecordKind = Models::LiveSessionRecord::Kind;
+
+void UpdateMax(std::atomic<std::int64_t>& max, std::int64_t value) {
+    auto current = max.load();
+    while (current < value && !max.compare_exchange_weak(current, value)) {
+    }
+}
+
+// Steady clock time points mean nothing after a restart
+auto ToWallClockMs(std::chrono::steady_clock::time_point time)
+    -> std::int64_t {
+    const auto wall = std::chrono::system_clock::now() +
+                      (time - std::chrono::steady_clock::now());
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               wall.time_since_epoch()
+    )
+        .count();
+}
+
+auto FromWallClockMs(std::int64_t ms, std::chrono::steady_clock::time_point now)
+    -> std::chrono::steady_clock::time_point {
+    const auto wall_now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    );
+    return now + (std::chrono::milliseconds{ms} - wall_now);
+}
+
+auto EncodeRecord(RecordKind kind, const Models::LiveSession& session)
+    -> std::string {
+    Models::LiveSessionRecord record;
+    record.kind = kind;
+    record.session_id = session.id;
+    record.pack_id = session.pack->GetPackId();
+    record.version = session.pack->GetVersion();
+    record.round_duration_ms = session.round_duration.count();
+    record.question = static_cast<std::uint32_t>(session.question);
+    record.round_ends_at_ms = ToWallClockMs(session.round_ends_at);
+    return Models::EncodeLiveSessionRecord(record);
+}
+
+} // namespace
+
+LiveSessions::LiveSessions(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : ComponentBase(config, component_context),
+      default_round_duration_(
+          config["default-round-duration"].As<std::chrono::milliseconds>(
+              kDefaultRoundDuration
+          )
+      ),
+      finished_retention_(
+          config["finished-retention"].As<std::chrono::milliseconds>(
+              kDefaultFinishedRetention
+          )
+      ),
+      channel_(kName),
+      wheel_(
+          config["tick"].As<std::chrono::milliseconds>(kDefaultTick),
+          Clock::now()
+      ) {
+    const auto journal_path = config["journal-path"].As<std::string>("");
+    if (!journal_path.empty()) {
+        journal_ = std::make_unique<SessionJournal>(
+            Utils::JournalSettings{
+                journal_path,
+                config["journal-segment-size"].As<std::size_t>(
+                    kDefaultJournalSegmentSize
+                )
+            },
+            component_context.GetTaskProcessor(
+                config["fs-task-processor"].As<std::string>(
+                    "fs-task-processor"
+                )
+            )
+        );
+        const auto& storage =
+            component_context.FindComponent<ShardedStorage>();
+        Restore(storage.GetRouter());
+        journal_->Start([this] { return Snapshot(); });
+    }
+
+    timers_task_ = userver::utils::CriticalAsync(
+        "live-sessions-timers", [this] { RunTimers(); }
+    );
+    statistics_entry_ =
+        component_context
+            .FindComponent<userver::components::StatisticsStorage>()
+            .GetStorage()
+            .RegisterWriter(
+                std::string{kName},
+                [this](userver::utils::statistics::Writer& writer) {
+                    WriteStatistics(writer);
+                }
+            );
+}
+
+LiveSessions::~LiveSessions() {
+    statistics_entry_.Unregister();
+    timers_task_.SyncCancel();
+}
+
+auto LiveSessions::Start(
+    const boost::uuids::uuid& session_id, NStorage::PackVersionPtr pack,
+    std::optional<std::chrono::milliseconds> round_duration
+) -> Models::LiveSession {
+    Entry entry;
+    entry.session.id = session_id;
+    entry.session.pack = std::move(pack);
+    entry.session.round_duration =
+        round_duration.value_or(default_round_duration_);
+
+    Models::LiveSession session;
+    std::uint64_t sequence = 0;
+    {
+        const std::lock_guard lock{mutex_};
+        if (const auto it = sessions_.find(session_id);
+            it != sessions_.end()) {
+            return it->second.session;
+        }
+        StartRound(entry, Clock::now());
+        sequence = AppendRecord(RecordKind::kStarted, entry.session);
+        session = sessions_.emplace(session_id, std::move(entry))
+                      .first->second.session;
+    }
+    WaitJournaled(sequence);
+    return session;
+}
+
+auto LiveSessions::Get(const boost::uuids::uuid& session_id) const
+    -> std::optional<Models::LiveSession> {
+    const std::lock_guard lock{mutex_};
+    const auto it = sessions_.find(session_id);
+    if (it == sessions_.end()) {
+        return std::nullopt;
+    }
+    return it->second.session;
+}
+
+auto LiveSessions::NextQuestion(const boost::uuids::uuid& session_id)
+    -> std::optional<Models::LiveSession> {
+    Models::LiveSession session;
+    std::uint64_t sequence = 0;
+    bool advanced = false;
+    {
+        const std::lock_guard lock{mutex_};
+        const auto it = sessions_.find(session_id);
+        if (it == sessions_.end()) {
+            return std::nullopt;
+        }
+        auto& entry = it->second;
+        if (!entry.session.IsFinished()) {
+            wheel_.Cancel(entry.timer);
+            ++entry.session.question;
+            StartRound(entry, Clock::now());
+            sequence = AppendRecord(RecordKind::kRound, entry.session);
+            advanced = true;
+        }
+        session = entry.session;
+    }
+    if (advanced) {
+        channel_.SendEvent({session, session.question - 1});
+    }
+    WaitJournaled(sequence);
+    return session;
+}
+
+void LiveSessions::StartRound(Entry& entry, Clock::time_point now) {
+    auto& session = entry.session;
+    if (session.IsFinished()) {
+        entry.timer = wheel_.Schedule(
+            now + finished_retention_,
+            {session.id, TimerEvent::Kind::kExpire}
+        );
+        return;
+    }
+    session.round_ends_at = now + session.round_duration;
+    entry.timer = wheel_.Schedule(
+        session.round_ends_at, {session.id, TimerEvent::Kind::kRoundTimeout}
+    );
+}
+
+void LiveSessions::OnTimer(
+    const TimerEvent& event, Clock::time_point now,
+    std::vector<RoundChange>& changes
+) {
+    const auto it = sessions_.find(event.session_id);
+    if (it == sessions_.end()) {
+        return;
+    }
+    auto& session = it->second.session;
+    switch (event.kind) {
+        case TimerEvent::Kind::kRoundTimeout:
+            ++session.question;
+            StartRound(it->second, now);
+            AppendRecord(RecordKind::kRound, session);
+            changes.push_back({session, session.question - 1});
+            break;
+        case TimerEvent::Kind::kExpire:
+            AppendRecord(RecordKind::kExpired, session);
+            changes.push_back({session, session.question, true});
+            sessions_.erase(it);
+            break;
+    }
+}
+
+auto LiveSessions::AppendRecord(
+    RecordKind kind, const Models::LiveSession& session
+) -> std::uint64_t {
+    if (!journal_) {
+        return 0;
+    }
+    return journal_->Append(EncodeRecord(kind, session));
+}
+
+void LiveSessions::WaitJournaled(std::uint64_t sequence) {
+    if (journal_ && sequence != 0) {
+        journal_->WaitWritten(sequence);
+    }
+}
+
+void LiveSessions::Restore(const NStorage::ShardRouter& shards) {
+    std::unordered_map<
+        boost::uuids::uuid, Models::LiveSessionRecord,
+        boost::hash<boost::uuids::uuid>>
+        records;
+    std::size_t malformed = 0;
+    const auto stats = journal_->Replay([&](std::string_view data) {
+        const auto record = Models::DecodeLiveSessionRecord(data);
+        if (!record) {
+            ++malformed;
+            return;
+        }
+        switch (record->kind) {
+            case RecordKind::kStarted:
+                records[record->session_id] = *record;
+                break;
+            case RecordKind::kRound: {
+                const auto it = records.find(record->session_id);
+                if (it != records.end()) {
+                    it->second.question = record->question;
+                    it->second.round_ends_at_ms = record->round_ends_at_ms;
+                }
+                break;
+            }
+            case RecordKind::kExpired:
+                records.erase(record->session_id);
+                break;
+        }
+    });
+
+    std::vector<Entry> entries;
+    for (const auto& [session_id, record] : records) {
+        NStorage::PackVersionPtr pack;
+        try {
+            pack = NStorage::GetPackVersion(
+                shards, record.pack_id, record.version
+            );
+        } catch (const std::exception& e) {
+            LOG_WARNING() << "Dropping live session " << session_id
+                          << ", cannot load its pack: " << e;
+        }
+        if (!pack) {
+            // Dropped for good, or it would be tried again on every restart
+            journal_->Append(Models::EncodeLiveSessionRecord(
+                {RecordKind::kExpired, session_id}
+            ));
+            continue;
+        }
+        Entry entry;
+        entry.session.id = session_id;
+        entry.session.pack = std::move(pack);
+        entry.session.round_duration =
+            std::chrono::milliseconds{record.round_duration_ms};
+        entry.session.question = record.question;
+        entry.session.round_ends_at =
+            FromWallClockMs(record.round_ends_at_ms, Clock::now());
+        entries.push_back(std::move(entry));
+    }
+
+    const std::lock_guard lock{mutex_};
+    const auto now = Clock::now();
+    for (auto& entry : entries) {
+        auto& session = entry.session;
+        // Skips the rounds that timed out while the instance was down
+        while (!session.IsFinished() && session.round_ends_at <= now) {
+            ++session.question;
+            session.round_ends_at += session.round_duration;
+        }
+        if (session.IsFinished()) {
+            entry.timer = wheel_.Schedule(
+                now + finished_retention_,
+                {session.id, TimerEvent::Kind::kExpire}
+            );
+        } else {
+            entry.timer = wheel_.Schedule(
+                session.round_ends_at,
+                {session.id, TimerEvent::Kind::kRoundTimeout}
+            );
+        }
+        const auto session_id = session.id;
+        sessions_.emplace(session_id, std::move(entry));
+    }
+    LOG_INFO() << "Restored " << sessions_.size() << " live sessions from "
+               << stats.records << " journal records in " << stats.segments
+               << " segments, " << stats.damaged_segments
+               << " damaged segments, " << malformed << " malformed records";
+}
+
+auto LiveSessions::Snapshot() const -> std::vector<std::string> {
+    std::vector<std::string> snapshot;
+    const std::lock_guard lock{mutex_};
+    snapshot.reserve(sessions_.size());
+    for (const auto& [session_id, entry] : sessions_) {
+        snapshot.push_back(EncodeRecord(RecordKind::kStarted, entry.session));
+    }
+    return snapshot;
+}
+
+void LiveSessions::RunTimers() {
+    while (!userver::engine::current_task::ShouldCancel()) {
+        Clock::time_point tick;
+        {
+            const std::lock_guard lock{mutex_};
+            tick = wheel_.GetNextTickTime();
+        }
+        userver::engine::InterruptibleSleepUntil(
+            userver::engine::Deadline::FromTimePoint(tick)
+        );
+        if (userver::engine::current_task::ShouldCancel()) {
+            break;
+        }
+
+        const auto now = Clock::now();
+        const auto lag_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(now - tick)
+                .count();
+        last_lag_us_ = lag_us;
+        UpdateMax(max_lag_us_, lag_us);
+
+        std::vector<RoundChange> changes;
+        {
+            const std::lock_guard lock{mutex_};
+            fired_ += wheel_.Advance(now, [&](TimerEvent&& event) {
+                OnTimer(event, now, changes);
+            });
+        }
+        for (const auto& change : changes) {
+            channel_.SendEvent(change);
+        }
+    }
+}
+
+void LiveSessions::WriteStatistics(
+    userver::utils::statistics::Writer& writer
+) const {
+    {
+        const std::lock_guard lock{mutex_};
+        writer["sessions"] = sessions_.size();
+        writer["timers"] = wheel_.Size();
+    }
+    writer["timers-fired"] = userver::utils::statistics::Rate{fired_.load()};
+    // The maximum is over the time since the previous collection
+    auto lag = writer["timer-lag-ms"];
+    lag["last"] = static_cast<double>(last_lag_us_.load()) / 1000;
+    lag["max"] = static_cast<double>(max_lag_us_.exchange(0)) / 1000;
+}
+
+auto LiveSessions::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: in-memory live quiz sessions with timed rounds
+additionalProperties: false
+properties:
+    tick:
+        type: string
+        description: resolution of round timers, 10ms by default
+    default-round-duration:
+        type: string
+        description: time per question if not set on start, 20s by default
+    finished-retention:
+        type: string
+        description: how long finished sessions are kept, 1m by default
+    journal-path:
+        type: string
+        description: directory of the session journal, no journal if empty
+    journal-segment-size:
+        type: integer
+        description: bytes per journal segment, 64MiB by default
+    fs-task-processor:
+        type: string
+        description: task processor for the journal I/O
+)");
+}
+
+} // namespace game_userver
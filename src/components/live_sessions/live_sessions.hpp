@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/concurrent/async_event_channel.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/yaml_config/fwd.hpp>
+#include <vector>
+
+#include "models/live_session.hpp"
+#include "models/live_session_record.hpp"
+#include "session_journal.hpp"
+#include "storage/pack_versions.hpp"
+#include "utils/timer_wheel.hpp"
+
+namespace game_userver {
+
+// In-memory live quiz sessions of this instance.
+//
+// Round timeouts of all sessions share one Utils::TimerWheel driven by a
+// single task that wakes up once per `tick`, instead of a sleeping task per
+// session: starting, skipping and ending a round are O(1) and thousands of
+// concurrent sessions cost one wakeup per tick. When a round times out the
+// session moves to the next question; finished sessions are kept for
+// `finished-retention` so players can see the end, then dropped.
+//
+// How late the driver wakes up is reported as `live-sessions.timer-lag-ms`:
+// timers fire that much after their time, on top of the tick.
+//
+// With `journal-path` set every change of a session is appended to a
+// SessionJournal and the sessions are restored from it on startup, with the
+// rounds that timed out while the instance was down skipped. Start and
+// NextQuestion return only once their change is on disk; rounds advanced by
+// timers are not waited for, replay recomputes them from the wall clock.
+//
+// Every round that ends is published to subscribers as a RoundChange once
+// the lock is released, see LiveRooms.
+class LiveSessions final : public userver::components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "live-sessions";
+
+    struct RoundChange final {
+        // The session after the change
+        Models::LiveSession session;
+        std::size_t ended_question = 0;
+        // The finished session was dropped, `session` is its last state
+        bool expired = false;
+    };
+
+    LiveSessions(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+    ~LiveSessions() override;
+
+    // Starts the first round right away. `round_duration` defaults to
+    // `default-round-duration`. Starting an existing session returns it
+    // as is.
+    auto Start(
+        const boost::uuids::uuid& session_id, NStorage::PackVersionPtr pack,
+        std::optional<std::chrono::milliseconds> round_duration
+    ) -> Models::LiveSession;
+
+    [[nodiscard]] auto Get(const boost::uuids::uuid& session_id) const
+        -> std::optional<Models::LiveSession>;
+
+    // Ends the current round ahead of its timeout. Returns std::nullopt if
+    // there is no such session.
+    auto NextQuestion(const boost::uuids::uuid& session_id)
+        -> std::optional<Models::LiveSession>;
+
+    template <typename Class>
+    [[nodiscard]] auto Subscribe(
+        Class* obj, std::string_view name,
+        void (Class::*func)(const RoundChange&)
+    ) -> userver::concurrent::AsyncEventSubscriberScope {
+        return channel_.AddListener(obj, name, func);
+    }
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct TimerEvent final {
+        enum class Kind {
+            kRoundTimeout,
+            kExpire
+        };
+
+        boost::uuids::uuid session_id;
+        Kind kind = Kind::kRoundTimeout;
+    };
+
+    using Wheel = Utils::TimerWheel<TimerEvent>;
+
+    struct Entry final {
+        Models::LiveSession session;
+        Wheel::TimerId timer;
+    };
+
+    using Sessions = std::unordered_map<
+        boost::uuids::uuid, Entry, boost::hash<boost::uuids::uuid>>;
+
+    // All three are called with `mutex_` held
+    void StartRound(Entry& entry, Clock::time_point now);
+    void OnTimer(
+        const TimerEvent& event, Clock::time_point now,
+        std::vector<RoundChange>& changes
+    );
+    // Returns the journal sequence number to wait for, 0 without a journal
+    auto AppendRecord(
+        Models::LiveSessionRecord::Kind kind,
+        const Models::LiveSession& session
+    ) -> std::uint64_t;
+
+    void WaitJournaled(std::uint64_t sequence);
+    void Restore(const NStorage::ShardRouter& shards);
+    auto Snapshot() const -> std::vector<std::string>;
+
+    void RunTimers();
+    void WriteStatistics(userver::utils::statistics::Writer& writer) const;
+
+    const std::chrono::milliseconds default_round_duration_;
+    const std::chrono::milliseconds finished_retention_;
+    userver::concurrent::AsyncEventChannel<const RoundChange&> channel_;
+
+    mutable userver::engine::Mutex mutex_;
+    Wheel wheel_;
+    Sessions sessions_;
+    // Declared after the sessions: its writer reads them for snapshots
+    std::unique_ptr<SessionJournal> journal_;
+
+    std::atomic<std::int64_t> last_lag_us_{0};
+    mutable std::atomic<std::int64_t> max_lag_us_{0};
+    std::atomic<std::uint64_t> fired_{0};
+
+    userver::engine::TaskWithResult<void> timers_task_;
+    userver::utils::statistics::Entry statistics_entry_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::LiveSessions> = true;
@@ -0,0 +1,100 @@
+#include "session_journal.hpp"
+
+#include <exception>
+#include <mutex>
+#include <userver/logging/log.hpp>
+#include <userver/utils/async.hpp>
+#include <utility>
+
+namespace game_userver {
+
+SessionJournal::SessionJournal(
+    Utils::JournalSettings settings,
+    userver::engine::TaskProcessor& fs_task_processor
+)
+    : journal_(std::move(settings)), fs_task_processor_(fs_task_processor) {}
+
+SessionJournal::~SessionJournal() {
+    if (!writer_.IsValid()) {
+        return;
+    }
+    {
+        const std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    queued_.NotifyAll();
+    writer_.Get();
+}
+
+auto SessionJournal::Replay(const std::function<void(std::string_view)>& apply)
+    -> Utils::Journal::ReplayStats {
+    return userver::utils::Async(
+               fs_task_processor_, "session-journal-replay",
+               [this, &apply] { return journal_.Replay(apply); }
+    )
+        .Get();
+}
+
+void SessionJournal::Start(Snapshot snapshot) {
+    snapshot_ = std::move(snapshot);
+    writer_ = userver::utils::CriticalAsync(
+        fs_task_processor_, "session-journal-writer", [this] { Run(); }
+    );
+}
+
+auto SessionJournal::Append(std::string record) -> std::uint64_t {
+    std::uint64_t sequence = 0;
+    {
+        const std::lock_guard lock{mutex_};
+        queue_.push_back(std::move(record));
+        sequence = ++queued_sequence_;
+    }
+    queued_.NotifyOne();
+    return sequence;
+}
+
+void SessionJournal::WaitWritten(std::uint64_t sequence) {
+    std::unique_lock lock{mutex_};
+    [[maybe_unused]] const auto written = written_.Wait(lock, [&] {
+        return written_sequence_ >= sequence;
+    });
+}
+
+void SessionJournal::Run() {
+    while (true) {
+        std::vector<std::string> batch;
+        std::uint64_t sequence = 0;
+        {
+            std::unique_lock lock{mutex_};
+            [[maybe_unused]] const auto woken = queued_.Wait(lock, [this] {
+                return !queue_.empty() || stopping_;
+            });
+            if (queue_.empty()) {
+                return;
+            }
+            batch.swap(queue_);
+            sequence = queued_sequence_;
+        }
+
+        try {
+            if (journal_.NeedsRotation()) {
+                // The snapshot is taken after the batch was queued, so it
+                // already covers it
+                journal_.Rotate(snapshot_());
+            } else {
+                journal_.Append(batch);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR() << "Failed to write " << batch.size()
+                        << " live session records: " << e;
+        }
+
+        {
+            const std::lock_guard lock{mutex_};
+            written_sequence_ = sequence;
+        }
+        written_.NotifyAll();
+    }
+}
+
+} // namespace game_userver
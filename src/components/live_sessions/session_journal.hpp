@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <vector>
+
+#include "utils/journal.hpp"
+
+namespace game_userver {
+
+// Group commit on top of Utils::Journal. Append only queues a record; one
+// writer task on the fs task processor takes whatever has queued up while
+// the previous batch was being written and makes it durable with a single
+// write and fdatasync, so a burst of changes costs one fsync, not one each.
+//
+// A failed write is logged and its records are lost: a live game goes on
+// without durability rather than stalling.
+class SessionJournal final {
+public:
+    using Snapshot = std::function<std::vector<std::string>()>;
+
+    SessionJournal(
+        Utils::JournalSettings settings,
+        userver::engine::TaskProcessor& fs_task_processor
+    );
+    // Writes out everything queued
+    ~SessionJournal();
+
+    // Replays the journal on the fs task processor, must precede Start
+    auto Replay(const std::function<void(std::string_view)>& apply)
+        -> Utils::Journal::ReplayStats;
+
+    // Starts the writer. `snapshot` is called on it to rotate a segment
+    // that grew too big and must describe the whole current state; it is
+    // written instead of the queued batch.
+    void Start(Snapshot snapshot);
+
+    // Never blocks on I/O. Returns the sequence number of the record.
+    auto Append(std::string record) -> std::uint64_t;
+
+    // Waits until the write of record `sequence` is over
+    void WaitWritten(std::uint64_t sequence);
+
+private:
+    void Run();
+
+    Utils::Journal journal_;
+    userver::engine::TaskProcessor& fs_task_processor_;
+    Snapshot snapshot_;
+
+    userver::engine::Mutex mutex_;
+    userver::engine::ConditionVariable queued_;
+    userver::engine::ConditionVariable written_;
+    std::vector<std::string> queue_;
+    std::uint64_t queued_sequence_ = 0;
+    std::uint64_t written_sequence_ = 0;
+    bool stopping_ = false;
+
+    userver::engine::TaskWithResult<void> writer_;
+};
+
+} // namespace game_userver
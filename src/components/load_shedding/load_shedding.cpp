@@ -0,0 +1,230 @@
+#include "load_shedding.hpp"
+
+#include <chrono>
+#include <userver/components/component_config.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/http/http_status.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+#include <vector>
+
+#include "utils/deadline.hpp"
+
+namespace game_userver {
+
+namespace {
+
+auto ParseSettings(
+    const userver::yaml_config::YamlConfig& config,
+    Utils::AdaptiveLimiterSettings settings
+) -> Utils::AdaptiveLimiterSettings {
+    settings.initial_limit =
+        config["initial-limit"].As<std::size_t>(settings.initial_limit);
+    settings.min_limit = config["min-limit"].As<std::size_t>(settings.min_limit);
+    settings.max_limit = config["max-limit"].As<std::size_t>(settings.max_limit);
+    settings.tolerance = config["tolerance"].As<double>(settings.tolerance);
+    settings.backoff = config["backoff"].As<double>(settings.backoff);
+    settings.baseline_window =
+        config["baseline-window"].As<std::chrono::milliseconds>(
+            settings.baseline_window
+        );
+    return settings;
+}
+
+auto GetRequestClass(const userver::server::http::HttpRequest& request)
+    -> RequestClass {
+    using userver::server::http::HttpMethod;
+
+    const auto method = request.GetMethod();
+    if (method == HttpMethod::kGet || method == HttpMethod::kHead) {
+        return RequestClass::kRead;
+    }
+    return RequestClass::kWrite;
+}
+
+// Fast failures would drag the baseline down, while a timeout is the very
+// congestion the limiter is after
+auto IsLatencySample(userver::server::http::HttpStatus status) -> bool {
+    return static_cast<int>(status) < 400 ||
+           status == userver::server::http::HttpStatus::kGatewayTimeout;
+}
+
+class LoadSheddingMiddleware final
+    : public userver::server::middlewares::HttpMiddlewareBase {
+public:
+    // A null limiter turns the middleware into a pass-through
+    LoadSheddingMiddleware(
+        const LoadShedding& load_shedding,
+        std::unique_ptr<Utils::AdaptiveLimiter> limiter
+    )
+        : load_shedding_(load_shedding), limiter_(std::move(limiter)) {}
+
+private:
+    void HandleRequest(
+        userver::server::http::HttpRequest& request,
+        userver::server::request::RequestContext& context
+    ) const override {
+        if (!limiter_) {
+            Next(request, context);
+            return;
+        }
+
+        auto admission =
+            load_shedding_.Admit(*limiter_, GetRequestClass(request));
+        auto& response = request.GetHttpResponse();
+        if (!admission) {
+            response.SetStatus(
+                userver::server::http::HttpStatus::kTooManyRequests
+            );
+            response.SetData("Too many requests");
+            return;
+        }
+
+        try {
+            Next(request, context);
+        } catch (const Utils::DeadlineExceeded&) {
+            throw;
+        } catch (...) {
+            admission->Cancel();
+            throw;
+        }
+        if (!IsLatencySample(response.GetStatus())) {
+            admission->Cancel();
+        }
+    }
+
+    const LoadShedding& load_shedding_;
+    const std::unique_ptr<Utils::AdaptiveLimiter> limiter_;
+};
+
+} // namespace
+
+LoadShedding::LoadShedding(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpMiddlewareFactoryBase(config, component_context),
+      endpoint_settings_(ParseSettings(config["endpoint"], {})),
+      skip_handlers_([&config] {
+          const auto handlers =
+              config["skip-handlers"].As<std::vector<std::string>>(
+                  std::vector<std::string>{}
+              );
+          return std::unordered_set<std::string>(
+              handlers.begin(), handlers.end()
+          );
+      }()),
+      reads_(ParseSettings(
+          config["reads"],
+          {.initial_limit = 256, .min_limit = 16, .max_limit = 1024}
+      )),
+      writes_(ParseSettings(
+          config["writes"],
+          {.initial_limit = 64, .min_limit = 8, .max_limit = 256}
+      )) {}
+
+auto LoadShedding::MakeEndpointLimiter() const
+    -> std::unique_ptr<Utils::AdaptiveLimiter> {
+    return std::make_unique<Utils::AdaptiveLimiter>(endpoint_settings_);
+}
+
+auto LoadShedding::Admit(
+    Utils::AdaptiveLimiter& endpoint, RequestClass request_class
+) const -> std::optional<Admission> {
+    auto& class_limiter =
+        request_class == RequestClass::kRead ? reads_ : writes_;
+
+    return endpoint.TryAcquire(&class_limiter);
+}
+
+auto LoadShedding::Create(
+    const userver::server::handlers::HttpHandlerBase& handler,
+    userver::yaml_config::YamlConfig /*middleware_config*/
+) const -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase> {
+    if (skip_handlers_.count(handler.HandlerName()) != 0) {
+        return std::make_unique<LoadSheddingMiddleware>(*this, nullptr);
+    }
+    return std::make_unique<LoadSheddingMiddleware>(
+        *this, MakeEndpointLimiter()
+    );
+}
+
+auto LoadShedding::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<HttpMiddlewareFactoryBase>(R"(
+type: object
+description: adaptive concurrency limiting for HTTP handlers and gRPC methods
+additionalProperties: false
+properties:
+    skip-handlers:
+        type: array
+        description: handler names that are never shed
+        items:
+            type: string
+            description: handler name
+    endpoint:
+        type: object
+        description: limiter settings for every single handler or gRPC method
+        additionalProperties: false
+        properties:
+            initial-limit:
+                type: integer
+                description: concurrency limit at startup
+            min-limit:
+                type: integer
+                description: the limit never goes below this value
+            max-limit:
+                type: integer
+                description: the limit never goes above this value
+            tolerance:
+                type: number
+                description: latency to baseline ratio that counts as congestion
+            backoff:
+                type: number
+                description: multiplier applied to the limit on congestion
+            baseline-window:
+                type: string
+                description: |
+                    the baseline is the best latency of the last one to two
+                    windows, 10s by default
+    reads:
+        type: object
+        description: budget shared by all read requests
+        additionalProperties: false
+        properties:
+            initial-limit:
+                type: integer
+                description: concurrency limit at startup
+            min-limit:
+                type: integer
+                description: the limit never goes below this value
+            max-limit:
+                type: integer
+                description: the limit never goes above this value
+            backoff:
+                type: number
+                description: multiplier applied to the limit on congestion
+    writes:
+        type: object
+        description: budget shared by all write requests
+        additionalProperties: false
+        properties:
+            initial-limit:
+                type: integer
+                description: concurrency limit at startup
+            min-limit:
+                type: integer
+                description: the limit never goes below this value
+            max-limit:
+                type: integer
+                description: the limit never goes above this value
+            backoff:
+                type: number
+                description: multiplier applied to the limit on congestion
+)");
+}
+
+} // namespace game_userver
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <userver/components/component_fwd.hpp>
+#include <userver/server/middlewares/http_middleware_base.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include "utils/adaptive_limiter.hpp"
+
+namespace game_userver {
+
+enum class RequestClass {
+    kRead,
+    kWrite
+};
+
+// Adaptive concurrency limiting for HTTP handlers and gRPC methods.
+//
+// Every endpoint gets its own AdaptiveLimiter, and on top of that reads and
+// writes draw from two separate class budgets, so a flood of list requests
+// cannot starve writes. A request is admitted only if both its endpoint and
+// its class have a free slot; otherwise it is shed right away with
+// 429 / RESOURCE_EXHAUSTED instead of queueing until the Postgres statement
+// timeout fires. Latency is only judged against the baseline of the endpoint,
+// the class budgets follow those verdicts.
+//
+// As an HTTP middleware factory it is enabled for all handlers through
+// `default-server-middleware-pipeline-builder`; GET/HEAD requests are
+// treated as reads, everything else as writes.
+class LoadShedding final
+    : public userver::server::middlewares::HttpMiddlewareFactoryBase {
+public:
+    static constexpr std::string_view kName = "load-shedding";
+
+    // Holds the endpoint and class slots of an admitted request. Cancel it
+    // for a request that failed: a fast error is no latency sample.
+    using Admission = Utils::AdaptiveLimiter::Slot;
+
+    LoadShedding(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+
+    [[nodiscard]] auto MakeEndpointLimiter() const
+        -> std::unique_ptr<Utils::AdaptiveLimiter>;
+
+    [[nodiscard]] auto
+    Admit(Utils::AdaptiveLimiter& endpoint, RequestClass request_class)
+        const -> std::optional<Admission>;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    auto Create(
+        const userver::server::handlers::HttpHandlerBase& handler,
+        userver::yaml_config::YamlConfig middleware_config
+    ) const
+        -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase>
+        override;
+
+    const Utils::AdaptiveLimiterSettings endpoint_settings_;
+    const std::unordered_set<std::string> skip_handlers_;
+    // Limiters are thread-safe, so admitting is logically const
+    mutable Utils::AdaptiveLimiter reads_;
+    mutable Utils::AdaptiveLimiter writes_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::LoadShedding> = true;
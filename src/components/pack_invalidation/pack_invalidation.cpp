@@ -0,0 +1,95 @@
+#include "pack_invalidation.hpp"
+
+#include <chrono>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/notify.hpp>
+#include <userver/utils/async.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "utils/constants.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::chrono::seconds kReconnectDelay{1};
+
+} // namespace
+
+PackInvalidation::PackInvalidation(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : ComponentBase(config, component_context),
+      stale_stores_(component_context.FindComponent<ShardedStorage>()
+                        .GetRouter()
+                        .GetStaleStores()),
+      channel_(kName) {
+    stale_subscription_ =
+        Subscribe(this, "stale-stores", &PackInvalidation::DropStale);
+
+    const auto& shards =
+        component_context.FindComponent<ShardedStorage>().GetRouter().GetAll();
+    for (const auto& pg_cluster : shards) {
+        listen_tasks_.push_back(userver::utils::CriticalAsync(
+            "pack-invalidation-listen",
+            [this, pg_cluster] { Listen(pg_cluster); }
+        ));
+    }
+}
+
+PackInvalidation::~PackInvalidation() {
+    for (auto& task : listen_tasks_) {
+        task.SyncCancel();
+    }
+    stale_subscription_.Unsubscribe();
+}
+
+void PackInvalidation::Listen(
+    const userver::storages::postgres::ClusterPtr& pg_cluster
+) {
+    while (!userver::engine::current_task::ShouldCancel()) {
+        try {
+            auto scope = pg_cluster->Listen(Constants::kPackChangedChannel);
+            // Whatever changed while we were not listening is unknown
+            channel_.SendEvent(PackChange{});
+
+            for (;;) {
+                const auto notification =
+                    scope.WaitNotify(userver::engine::Deadline{});
+                Dispatch(notification.payload);
+            }
+        } catch (const std::exception& e) {
+            if (userver::engine::current_task::ShouldCancel()) {
+                return;
+            }
+            LOG_WARNING() << "LISTEN " << Constants::kPackChangedChannel
+                          << " failed, reconnecting: " << e;
+            userver::engine::InterruptibleSleepFor(kReconnectDelay);
+        }
+    }
+}
+
+void PackInvalidation::Dispatch(const std::optional<std::string>& payload) {
+    const auto pack_id = Utils::StringToUuid(payload.value_or(""));
+    if (pack_id.is_nil()) {
+        LOG_WARNING() << "Unexpected " << Constants::kPackChangedChannel
+                      << " payload, invalidating all packs";
+        channel_.SendEvent(PackChange{});
+        return;
+    }
+
+    LOG_DEBUG() << "Pack changed: " << payload.value();
+    channel_.SendEvent(PackChange{pack_id});
+}
+
+void PackInvalidation::DropStale(const PackChange& change) {
+    stale_stores_.Invalidate(change.pack_id);
+}
+
+} // namespace game_userver
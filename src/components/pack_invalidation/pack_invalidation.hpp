@@ -0,0 +1,65 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/concurrent/async_event_channel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+
+#include "storage/stale_stores.hpp"
+
+namespace game_userver {
+
+// Cluster-wide invalidation of pack data. A trigger (see
+// postgresql/schemas/db_1.sql) NOTIFYs Constants::kPackChangedChannel with
+// the pack id on every change of a pack, its questions or its variants, no
+// matter which instance or tool made it. Every instance LISTENs on the channel
+// of every shard here and forwards the ids to local subscribers, so caches are
+// dropped within milliseconds of the commit instead of waiting for a TTL.
+//
+// Notifications sent while the LISTEN connection is down are lost, so after
+// every (re)connect subscribers get a PackChange without a pack id and must
+// drop everything.
+//
+// The stale results of the ShardRouter are dropped here as well, so a
+// degraded read never serves content older than a known change.
+class PackInvalidation final : public userver::components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "pack-invalidation";
+
+    struct PackChange final {
+        // std::nullopt if any pack could have changed
+        std::optional<boost::uuids::uuid> pack_id;
+    };
+
+    PackInvalidation(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+    ~PackInvalidation() override;
+
+    template <typename Class>
+    [[nodiscard]] auto Subscribe(
+        Class* obj, std::string_view name,
+        void (Class::*func)(const PackChange&)
+    ) -> userver::concurrent::AsyncEventSubscriberScope {
+        return channel_.AddListener(obj, name, func);
+    }
+
+private:
+    void Listen(const userver::storages::postgres::ClusterPtr& pg_cluster);
+    void Dispatch(const std::optional<std::string>& payload);
+    void DropStale(const PackChange& change);
+
+    NStorage::StaleStores& stale_stores_;
+    userver::concurrent::AsyncEventChannel<const PackChange&> channel_;
+    userver::concurrent::AsyncEventSubscriberScope stale_subscription_;
+    // One per shard
+    std::vector<userver::engine::TaskWithResult<void>> listen_tasks_;
+};
+
+} // namespace game_userver
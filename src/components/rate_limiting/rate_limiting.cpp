@@ -0,0 +1,214 @@
+#include "rate_limiting.hpp"
+
+#include <grpcpp/server_context.h>
+
+#include <vector>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/dynamic_config/snapshot.hpp>
+#include <userver/dynamic_config/storage/component.hpp>
+#include <userver/dynamic_config/value.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/http/http_status.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::string_view kPlayerHeader = "X-Player-Id";
+constexpr std::string_view kPlayerMetadata = "x-player-id";
+
+const userver::dynamic_config::Key<RateLimitsConfig> kRateLimitsConfig{
+    "QUIZ_RATE_LIMITS",
+    userver::dynamic_config::DefaultAsJsonString{R"(
+{
+    "default": {"rate": 0, "burst": 1},
+    "routes": {}
+}
+)"}
+};
+
+auto ParseLimit(const userver::formats::json::Value& value)
+    -> Utils::TokenBucketSettings {
+    return Utils::TokenBucketSettings{
+        .rate = value["rate"].As<double>(),
+        .burst = value["burst"].As<double>(1),
+    };
+}
+
+auto GetClient(const userver::server::http::HttpRequest& request)
+    -> RateLimiting::Client {
+    return RateLimiting::Client{
+        request.GetRemoteAddress().PrimaryAddressString(),
+        request.GetHeader(kPlayerHeader),
+    };
+}
+
+// "route\naddress" for the address as a whole, "route\naddress\nplayer"
+// for one player behind it, including the one without an id
+auto MakeKey(
+    std::string_view route, std::string_view address,
+    const std::string* player
+) -> std::string {
+    std::string key;
+    key.reserve(
+        route.size() + address.size() + 2 + (player ? player->size() : 0)
+    );
+    key.append(route).append(1, '\n').append(address);
+    if (player) {
+        key.append(1, '\n').append(*player);
+    }
+    return key;
+}
+
+class RateLimitingMiddleware final
+    : public userver::server::middlewares::HttpMiddlewareBase {
+public:
+    // An empty route turns the middleware into a pass-through
+    RateLimitingMiddleware(const RateLimiting& rate_limiting, std::string route)
+        : rate_limiting_(rate_limiting), route_(std::move(route)) {}
+
+private:
+    void HandleRequest(
+        userver::server::http::HttpRequest& request,
+        userver::server::request::RequestContext& context
+    ) const override {
+        if (!route_.empty() &&
+            !rate_limiting_.Allow(route_, GetClient(request))) {
+            auto& response = request.GetHttpResponse();
+            response.SetStatus(
+                userver::server::http::HttpStatus::kTooManyRequests
+            );
+            response.SetData("Rate limit exceeded");
+            return;
+        }
+
+        Next(request, context);
+    }
+
+    const RateLimiting& rate_limiting_;
+    const std::string route_;
+};
+
+} // namespace
+
+auto RateLimitsConfig::GetLimit(std::string_view route) const
+    -> const Utils::TokenBucketSettings& {
+    const auto it = routes.find(std::string{route});
+    return it == routes.end() ? default_limit : it->second;
+}
+
+auto Parse(
+    const userver::formats::json::Value& value,
+    userver::formats::parse::To<RateLimitsConfig>
+    /*unused*/
+) -> RateLimitsConfig {
+    RateLimitsConfig config;
+    config.default_limit = ParseLimit(value["default"]);
+    config.address_factor =
+        value["address_factor"].As<double>(config.address_factor);
+    for (const auto& [route, limit] :
+         userver::formats::common::Items(value["routes"])) {
+        config.routes.emplace(route, ParseLimit(limit));
+    }
+    return config;
+}
+
+RateLimiting::RateLimiting(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpMiddlewareFactoryBase(config, component_context),
+      skip_handlers_([&config] {
+          const auto handlers =
+              config["skip-handlers"].As<std::vector<std::string>>(
+                  std::vector<std::string>{}
+              );
+          return std::unordered_set<std::string>(
+              handlers.begin(), handlers.end()
+          );
+      }()),
+      config_source_(component_context
+                         .FindComponent<userver::components::DynamicConfig>()
+                         .GetSource()),
+      buckets_(config["shards"].As<std::size_t>(64)) {}
+
+auto RateLimiting::Allow(std::string_view route, const Client& client)
+    const -> bool {
+    const auto snapshot = config_source_.GetSnapshot();
+    const auto& config = snapshot[kRateLimitsConfig];
+    const auto& limit = config.GetLimit(route);
+    if (limit.rate <= 0) {
+        return true;
+    }
+
+    const Utils::TokenBucketSettings address_limit{
+        .rate = limit.rate * config.address_factor,
+        .burst = limit.burst * config.address_factor,
+    };
+    if (!buckets_.TryAcquire(
+            MakeKey(route, client.address, nullptr), address_limit
+        )) {
+        return false;
+    }
+    return buckets_.TryAcquire(
+        MakeKey(route, client.address, &client.player), limit
+    );
+}
+
+auto RateLimiting::GetClient(const grpc::ServerContext& context) -> Client {
+    // "ipv4:127.0.0.1:12345" -> "ipv4:127.0.0.1", the port changes with
+    // every connection
+    Client client{context.peer(), {}};
+    const auto port = client.address.rfind(':');
+    if (port != std::string::npos) {
+        client.address.resize(port);
+    }
+
+    const auto& metadata = context.client_metadata();
+    const auto it = metadata.find(
+        grpc::string_ref{kPlayerMetadata.data(), kPlayerMetadata.size()}
+    );
+    if (it != metadata.end()) {
+        client.player.assign(it->second.data(), it->second.size());
+    }
+    return client;
+}
+
+auto RateLimiting::Create(
+    const userver::server::handlers::HttpHandlerBase& handler,
+    userver::yaml_config::YamlConfig /*middleware_config*/
+) const -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase> {
+    if (skip_handlers_.count(handler.HandlerName()) != 0) {
+        return std::make_unique<RateLimitingMiddleware>(*this, std::string{});
+    }
+    return std::make_unique<RateLimitingMiddleware>(
+        *this, std::string{handler.HandlerName()}
+    );
+}
+
+auto RateLimiting::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<HttpMiddlewareFactoryBase>(R"(
+type: object
+description: per-player token bucket rate limiting, see QUIZ_RATE_LIMITS
+additionalProperties: false
+properties:
+    skip-handlers:
+        type: array
+        description: handler names that are never limited
+        items:
+            type: string
+            description: handler name
+    shards:
+        type: integer
+        description: number of lock-striped shards of the bucket table
+)");
+}
+
+} // namespace game_userver
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <userver/components/component_fwd.hpp>
+#include <userver/dynamic_config/source.hpp>
+#include <userver/formats/json_fwd.hpp>
+#include <userver/server/middlewares/http_middleware_base.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include "utils/token_bucket_table.hpp"
+
+namespace grpc {
+class ServerContext;
+} // namespace grpc
+
+namespace game_userver {
+
+// QUIZ_RATE_LIMITS dynamic config: token bucket settings per HTTP handler
+// name or gRPC method name, `default` applies to everything else. An
+// address as a whole gets `address_factor` times the limit of one player.
+struct RateLimitsConfig final {
+    Utils::TokenBucketSettings default_limit;
+    std::unordered_map<std::string, Utils::TokenBucketSettings> routes;
+    double address_factor = 4;
+
+    [[nodiscard]] auto GetLimit(std::string_view route) const
+        -> const Utils::TokenBucketSettings&;
+};
+
+auto Parse(
+    const userver::formats::json::Value& value,
+    userver::formats::parse::To<RateLimitsConfig>
+) -> RateLimitsConfig;
+
+// Per-player rate limiting for HTTP handlers and gRPC methods.
+//
+// Player ids are not authenticated, so the client address is what a
+// request is charged to: every address gets a token bucket per route,
+// `address_factor` times the route limit. The `X-Player-Id` header
+// (`x-player-id` gRPC metadata) only splits it further into per-player
+// buckets with the route limit, for players sharing an address. Sending a
+// new id with every request thus never escapes the address bucket.
+//
+// Limits come from the QUIZ_RATE_LIMITS dynamic config and may be changed
+// without a restart; a request over the limit is rejected with 429 /
+// RESOURCE_EXHAUSTED before it reaches the database.
+//
+// As an HTTP middleware factory it is enabled for all handlers through
+// `default-server-middleware-pipeline-builder`.
+class RateLimiting final
+    : public userver::server::middlewares::HttpMiddlewareFactoryBase {
+public:
+    static constexpr std::string_view kName = "rate-limiting";
+
+    struct Client final {
+        std::string address;
+        // Empty if the client did not send one
+        std::string player;
+    };
+
+    RateLimiting(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+
+    // Returns false if the client exhausted the limit of `route`
+    [[nodiscard]] auto Allow(std::string_view route, const Client& client)
+        const -> bool;
+
+    [[nodiscard]] static auto GetClient(const grpc::ServerContext& context)
+        -> Client;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    auto Create(
+        const userver::server::handlers::HttpHandlerBase& handler,
+        userver::yaml_config::YamlConfig middleware_config
+    ) const
+        -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase>
+        override;
+
+    const std::unordered_set<std::string> skip_handlers_;
+    const userver::dynamic_config::Source config_source_;
+    // The table is thread-safe, so checking is logically const
+    mutable Utils::TokenBucketTable buckets_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::RateLimiting> = true;
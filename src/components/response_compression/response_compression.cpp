@@ -0,0 +1,145 @@
+#include "response_compression.hpp"
+
+#include <userver/components/component_config.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/server/http/http_status.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include "utils/hash.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::string_view kAcceptEncodingHeader = "Accept-Encoding";
+constexpr std::string_view kContentEncodingHeader = "Content-Encoding";
+constexpr std::string_view kVaryHeader = "Vary";
+
+constexpr std::size_t kCacheWays = 16;
+
+class ResponseCompressionMiddleware final
+    : public userver::server::middlewares::HttpMiddlewareBase {
+public:
+    explicit ResponseCompressionMiddleware(
+        const ResponseCompression& compression
+    )
+        : compression_(compression) {}
+
+private:
+    void HandleRequest(
+        userver::server::http::HttpRequest& request,
+        userver::server::request::RequestContext& context
+    ) const override {
+        Next(request, context);
+
+        auto& response = request.GetHttpResponse();
+        if (response.GetStatus() != userver::server::http::HttpStatus::kOk ||
+            response.GetData().size() < compression_.GetMinSize() ||
+            !response.GetHeader(kContentEncodingHeader).empty()) {
+            return;
+        }
+
+        // Caches in between must not mix up encodings of the same URL
+        response.SetHeader(std::string{kVaryHeader}, "Accept-Encoding");
+        const auto encoding = Utils::NegotiateEncoding(
+            request.GetHeader(kAcceptEncodingHeader)
+        );
+        if (encoding == Utils::ContentEncoding::kIdentity) {
+            return;
+        }
+
+        const bool cacheable =
+            request.GetMethod() == userver::server::http::HttpMethod::kGet;
+        const auto compressed =
+            compression_.Compress(response.GetData(), encoding, cacheable);
+        response.SetHeader(
+            std::string{kContentEncodingHeader},
+            std::string{Utils::ToString(encoding)}
+        );
+        response.SetData(*compressed);
+    }
+
+    const ResponseCompression& compression_;
+};
+
+} // namespace
+
+auto ResponseCompression::CacheKeyHash::operator()(const CacheKey& key) const
+    -> std::size_t {
+    return Utils::Mix64(
+        key.hash ^ key.size ^ static_cast<std::uint64_t>(key.encoding)
+    );
+}
+
+ResponseCompression::ResponseCompression(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpMiddlewareFactoryBase(config, component_context),
+      min_size_(config["min-size"].As<std::size_t>(1024)),
+      gzip_level_(config["gzip-level"].As<int>(6)),
+      zstd_level_(config["zstd-level"].As<int>(3)),
+      cache_(kCacheWays, config["cache-way-size"].As<std::size_t>(64)) {}
+
+auto ResponseCompression::GetMinSize() const -> std::size_t {
+    return min_size_;
+}
+
+auto ResponseCompression::Compress(
+    std::string_view body, Utils::ContentEncoding encoding, bool cacheable
+) const -> std::shared_ptr<const std::string> {
+    const auto level = encoding == Utils::ContentEncoding::kZstd
+                           ? zstd_level_
+                           : gzip_level_;
+    if (!cacheable) {
+        return std::make_shared<const std::string>(
+            Utils::Compress(body, encoding, level)
+        );
+    }
+
+    // 64 bits of hash plus the size make a collision practically impossible
+    const CacheKey key{Utils::HashString(body), body.size(), encoding};
+    if (auto cached = cache_.Get(key)) {
+        return *std::move(cached);
+    }
+    auto compressed = std::make_shared<const std::string>(
+        Utils::Compress(body, encoding, level)
+    );
+    cache_.Put(key, compressed);
+    return compressed;
+}
+
+auto ResponseCompression::Create(
+    const userver::server::handlers::HttpHandlerBase& /*handler*/,
+    userver::yaml_config::YamlConfig /*middleware_config*/
+) const -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase> {
+    return std::make_unique<ResponseCompressionMiddleware>(*this);
+}
+
+auto ResponseCompression::GetStaticConfigSchema()
+    -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<HttpMiddlewareFactoryBase>(R"(
+type: object
+description: zstd/gzip compression of HTTP responses with a compressed cache
+additionalProperties: false
+properties:
+    min-size:
+        type: integer
+        description: responses smaller than this are not compressed
+    gzip-level:
+        type: integer
+        description: zlib compression level, 1-9
+    zstd-level:
+        type: integer
+        description: zstd compression level, 1-19
+    cache-way-size:
+        type: integer
+        description: compressed bodies kept per each of the 16 cache ways
+)");
+}
+
+} // namespace game_userver
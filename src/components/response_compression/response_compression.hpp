@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/server/middlewares/http_middleware_base.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include "utils/compression.hpp"
+
+namespace game_userver {
+
+// Compresses HTTP responses with zstd or gzip, whichever the client prefers
+// according to `Accept-Encoding`. Small and non-200 responses are sent as
+// is.
+//
+// Compressed bodies of GET responses are cached by the hash of the
+// uncompressed body. A popular pack is thus compressed once per content
+// version: any change of the pack changes the body and misses the cache,
+// while unchanged content is only hashed, which is far cheaper than
+// compressing it again.
+//
+// As an HTTP middleware factory it is enabled for all handlers through
+// `default-server-middleware-pipeline-builder`.
+class ResponseCompression final
+    : public userver::server::middlewares::HttpMiddlewareFactoryBase {
+public:
+    static constexpr std::string_view kName = "response-compression";
+
+    ResponseCompression(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+
+    [[nodiscard]] auto GetMinSize() const -> std::size_t;
+
+    // Compressed `body`, from the cache if the same body was compressed
+    // before. Only `cacheable` bodies are put into the cache.
+    [[nodiscard]] auto Compress(
+        std::string_view body, Utils::ContentEncoding encoding, bool cacheable
+    ) const -> std::shared_ptr<const std::string>;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    struct CacheKey final {
+        std::uint64_t hash;
+        std::size_t size;
+        Utils::ContentEncoding encoding;
+
+        auto operator==(const CacheKey&) const -> bool = default;
+    };
+
+    struct CacheKeyHash final {
+        auto operator()(const CacheKey& key) const -> std::size_t;
+    };
+
+    auto Create(
+        const userver::server::handlers::HttpHandlerBase& handler,
+        userver::yaml_config::YamlConfig middleware_config
+    ) const
+        -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase>
+        override;
+
+    const std::size_t min_size_;
+    const int gzip_level_;
+    const int zstd_level_;
+    // The cache is thread-safe, so compressing is logically const
+    mutable userver::cache::NWayLRU<
+        CacheKey, std::shared_ptr<const std::string>, CacheKeyHash>
+        cache_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::ResponseCompression> =
+        true;
@@ -0,0 +1,149 @@
+#include "sharded_storage.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+namespace game_userver {
+
+namespace {
+
+auto FindShards(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+) -> std::vector<NStorage::ClusterPtr> {
+    std::vector<NStorage::ClusterPtr> shards;
+    for (const auto& name :
+         config["shards"].As<std::vector<std::string>>()) {
+        shards.push_back(component_context
+                             .FindComponent<userver::components::Postgres>(name)
+                             .GetCluster());
+    }
+    return shards;
+}
+
+auto ParseHedging(const userver::yaml_config::YamlConfig& config)
+    -> NStorage::HedgingSettings {
+    using std::chrono::milliseconds;
+
+    NStorage::HedgingSettings settings;
+    settings.enabled = config["enabled"].As<bool>(settings.enabled);
+    auto& delay = settings.delay;
+    delay.percentile = config["percentile"].As<double>(delay.percentile);
+    delay.min_delay = config["min-delay"].As<milliseconds>(
+        std::chrono::duration_cast<milliseconds>(delay.min_delay)
+    );
+    delay.max_delay = config["max-delay"].As<milliseconds>(
+        std::chrono::duration_cast<milliseconds>(delay.max_delay)
+    );
+    delay.window = config["window"].As<std::size_t>(delay.window);
+    settings.budget_ratio =
+        config["budget-ratio"].As<double>(settings.budget_ratio);
+    settings.budget_burst =
+        config["budget-burst"].As<double>(settings.budget_burst);
+    return settings;
+}
+
+auto ParseStaleFallback(const userver::yaml_config::YamlConfig& config)
+    -> NStorage::StaleFallbackSettings {
+    NStorage::StaleFallbackSettings settings;
+    settings.enabled = config["enabled"].As<bool>(settings.enabled);
+    settings.max_staleness = config["max-staleness"].As<std::chrono::seconds>(
+        settings.max_staleness
+    );
+    auto& breaker = settings.breaker;
+    breaker.failure_threshold = config["failure-threshold"].As<std::size_t>(
+        breaker.failure_threshold
+    );
+    breaker.open_duration =
+        config["open-duration"].As<std::chrono::milliseconds>(
+            breaker.open_duration
+        );
+    return settings;
+}
+
+} // namespace
+
+ShardedStorage::ShardedStorage(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : ComponentBase(config, component_context),
+      router_(
+          FindShards(config, component_context),
+          ParseHedging(config["hedging"]),
+          ParseStaleFallback(config["stale-fallback"])
+      ) {}
+
+auto ShardedStorage::GetRouter() const -> const NStorage::ShardRouter& {
+    return router_;
+}
+
+auto ShardedStorage::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: quiz content partitioned by pack across Postgres clusters
+additionalProperties: false
+properties:
+    shards:
+        type: array
+        description: names of the Postgres components, in shard order
+        items:
+            type: string
+            description: Postgres component name
+    hedging:
+        type: object
+        description: hedged replica reads, see NStorage::HedgedReads
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: off by default
+            percentile:
+                type: number
+                description: latency percentile after which a read is hedged
+            min-delay:
+                type: string
+                description: the hedge delay never goes below this, 2ms
+            max-delay:
+                type: string
+                description: |
+                    the hedge delay never goes above this, also used until
+                    enough reads are seen, 50ms
+            window:
+                type: integer
+                description: reads the percentile is computed over
+            budget-ratio:
+                type: number
+                description: share of reads that may be hedged, 0.05
+            budget-burst:
+                type: number
+                description: unused hedges that may be saved up
+    stale-fallback:
+        type: object
+        description: |
+            serving last known good reads while a shard fails, see
+            NStorage::StaleFallback
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: off by default
+            max-staleness:
+                type: string
+                description: older results are never served, 10m
+            failure-threshold:
+                type: integer
+                description: consecutive failures that open a shard breaker
+            open-duration:
+                type: string
+                description: how long an open breaker waits before a probe, 5s
+)");
+}
+
+} // namespace game_userver
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string_view>
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include "storage/shard_router.hpp"
+
+namespace game_userver {
+
+// Owns the NStorage::ShardRouter over the Postgres components listed in the
+// `shards` option. The order of the list defines shard numbers and must be
+// the same on all instances; appending a shard requires migrating the data,
+// see ShardRouter. The `hedging` and `stale-fallback` options configure
+// hedged replica reads and the degraded mode.
+class ShardedStorage final : public userver::components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "sharded-storage";
+
+    ShardedStorage(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+
+    [[nodiscard]] auto GetRouter() const -> const NStorage::ShardRouter&;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    const NStorage::ShardRouter router_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::ShardedStorage> = true;
@@ -0,0 +1,50 @@
+#include "stale_content.hpp"
+
+#include <string>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include "storage/stale_fallback.hpp"
+
+namespace game_userver {
+
+namespace {
+
+class StaleContentMiddleware final
+    : public userver::server::middlewares::HttpMiddlewareBase {
+private:
+    void HandleRequest(
+        userver::server::http::HttpRequest& request,
+        userver::server::request::RequestContext& context
+    ) const override {
+        // The handler runs in this task, so the mark is not left over from
+        // another request
+        NStorage::TakeServedStaleAge();
+        Next(request, context);
+
+        const auto age = NStorage::TakeServedStaleAge();
+        if (!age) {
+            return;
+        }
+        auto& response = request.GetHttpResponse();
+        response.SetHeader(
+            std::string{StaleContent::kStaleAgeHeader},
+            std::to_string(age->count())
+        );
+        response.SetHeader(
+            std::string{"Warning"}, "110 - \"Response is Stale\""
+        );
+    }
+};
+
+} // namespace
+
+auto StaleContent::Create(
+    const userver::server::handlers::HttpHandlerBase& /*handler*/,
+    userver::yaml_config::YamlConfig /*middleware_config*/
+) const -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase> {
+    return std::make_unique<StaleContentMiddleware>();
+}
+
+} // namespace game_userver
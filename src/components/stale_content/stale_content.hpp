@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <userver/components/component_fwd.hpp>
+#include <userver/server/middlewares/http_middleware_base.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+namespace game_userver {
+
+// Marks responses built from stale results of NStorage::StaleFallback:
+// such responses get `X-Stale-Age` with the age of the oldest stale result
+// in seconds and the standard `Warning: 110` header.
+class StaleContent final
+    : public userver::server::middlewares::HttpMiddlewareFactoryBase {
+public:
+    static constexpr std::string_view kName = "stale-content";
+
+    static constexpr std::string_view kStaleAgeHeader = "X-Stale-Age";
+
+    using HttpMiddlewareFactoryBase::HttpMiddlewareFactoryBase;
+
+private:
+    auto Create(
+        const userver::server::handlers::HttpHandlerBase& handler,
+        userver::yaml_config::YamlConfig middleware_config
+    ) const
+        -> std::unique_ptr<userver::server::middlewares::HttpMiddlewareBase>
+        override;
+};
+
+} // namespace game_userver
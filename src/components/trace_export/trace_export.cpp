@@ -0,0 +1,147 @@
+#include "trace_export.hpp"
+
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <utility>
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultFlushInterval{1000};
+constexpr std::size_t kDefaultMaxQueuedSpans = 100000;
+
+} // namespace
+
+TraceExport::Span::Span(TraceExport& exporter, std::string name)
+    : name_(std::move(name)), span_(name_), exporter_(nullptr),
+      start_(std::chrono::system_clock::now()) {
+    if (!exporter.path_.empty() &&
+        Utils::IsTraceSampled(span_.GetTraceId(), exporter.sample_rate_)) {
+        exporter_ = &exporter;
+    }
+}
+
+TraceExport::Span::~Span() {
+    if (exporter_ == nullptr) {
+        return;
+    }
+    exporter_->Record(
+        {std::move(name_), std::string{span_.GetTraceId()},
+         std::string{span_.GetSpanId()}, std::string{span_.GetParentId()},
+         start_, std::chrono::system_clock::now(), std::move(attributes_)}
+    );
+}
+
+void TraceExport::Span::AddAttribute(std::string key, std::string value) {
+    span_.AddTag(key, value);
+    if (exporter_ != nullptr) {
+        attributes_.emplace_back(std::move(key), std::move(value));
+    }
+}
+
+TraceExport::TraceExport(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : ComponentBase(config, component_context),
+      path_(config["path"].As<std::string>("")),
+      service_name_(config["service-name"].As<std::string>("game_userver")),
+      sample_rate_(config["sample-rate"].As<double>(0.01)),
+      max_queued_spans_(config["max-queued-spans"].As<std::size_t>(
+          kDefaultMaxQueuedSpans
+      )) {
+    if (path_.empty()) {
+        return;
+    }
+
+    // Writing the file blocks, so it is done on the fs task processor
+    userver::utils::PeriodicTask::Settings settings{
+        config["flush-interval"].As<std::chrono::milliseconds>(
+            kDefaultFlushInterval
+        )
+    };
+    settings.task_processor = &component_context.GetTaskProcessor(
+        config["fs-task-processor"].As<std::string>("fs-task-processor")
+    );
+    flush_task_.Start("trace-export-flush", settings, [this] { Flush(); });
+}
+
+TraceExport::~TraceExport() {
+    flush_task_.Stop();
+    Flush();
+}
+
+auto TraceExport::StartSpan(std::string name) -> Span {
+    return Span{*this, std::move(name)};
+}
+
+void TraceExport::Record(Utils::TraceSpanRecord&& span) {
+    const std::lock_guard lock{mutex_};
+    if (queue_.size() >= max_queued_spans_) {
+        ++dropped_;
+        return;
+    }
+    queue_.push_back(std::move(span));
+}
+
+void TraceExport::Flush() {
+    std::vector<Utils::TraceSpanRecord> spans;
+    {
+        const std::lock_guard lock{mutex_};
+        spans.swap(queue_);
+    }
+    if (const auto dropped = dropped_.exchange(0)) {
+        LOG_WARNING() << "Trace export queue overflowed, dropped " << dropped
+                      << " spans";
+    }
+    if (spans.empty()) {
+        return;
+    }
+
+    try {
+        std::ofstream file{path_, std::ios::app};
+        file << Utils::FormatOtlpJson(service_name_, spans) << '\n';
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("cannot write to " + path_);
+        }
+    } catch (const std::exception& e) {
+        LOG_WARNING() << "Failed to export " << spans.size()
+                      << " trace spans: " << e;
+    }
+}
+
+auto TraceExport::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: exports sampled trace spans to a local OTLP/JSON file
+additionalProperties: false
+properties:
+    path:
+        type: string
+        description: file the spans are appended to, export is off if empty
+    service-name:
+        type: string
+        description: service.name resource attribute, game_userver by default
+    sample-rate:
+        type: number
+        description: share of traces exported, 0.01 by default
+    flush-interval:
+        type: string
+        description: how often queued spans are written, 1s by default
+    max-queued-spans:
+        type: integer
+        description: spans over this limit are dropped until the next flush
+    fs-task-processor:
+        type: string
+        description: task processor the file is written on
+)");
+}
+
+} // namespace game_userver
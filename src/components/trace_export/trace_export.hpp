@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/yaml_config/fwd.hpp>
+#include <vector>
+
+#include "utils/trace_spans.hpp"
+
+namespace game_userver {
+
+// Exports sampled request timelines to a local file in the OTLP/JSON
+// format, so they can be loaded into Jaeger, Tempo or any OTLP-aware viewer
+// (or replayed into a collector) without running an APM service next to
+// the instance.
+//
+// Spans are started with StartSpan around the interesting parts of a
+// request. Each one is also a regular userver tracing span, so it nests
+// under the span of the request, shows up in the logs with the same trace
+// id and becomes the parent of the spans userver starts inside it, e.g.
+// around Postgres queries. Only spans of sampled traces are queued; they
+// are appended to `path` as one ExportTraceServiceRequest per line every
+// `flush-interval`. With an empty `path` export is off and StartSpan only
+// starts the userver span.
+class TraceExport final : public userver::components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "trace-export";
+
+    class Span final {
+    public:
+        Span(const Span&) = delete;
+        Span(Span&&) = delete;
+        auto operator=(const Span&) -> Span& = delete;
+        auto operator=(Span&&) -> Span& = delete;
+        ~Span();
+
+        // Also added as a tag of the userver span
+        void AddAttribute(std::string key, std::string value);
+
+    private:
+        friend class TraceExport;
+
+        Span(TraceExport& exporter, std::string name);
+
+        std::string name_;
+        userver::tracing::Span span_;
+        // nullptr if the trace is not sampled
+        TraceExport* exporter_;
+        std::chrono::system_clock::time_point start_;
+        std::vector<std::pair<std::string, std::string>> attributes_;
+    };
+
+    TraceExport(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+    ~TraceExport() override;
+
+    [[nodiscard]] auto StartSpan(std::string name) -> Span;
+
+    // Writes out the queued spans, public for tests
+    void Flush();
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    void Record(Utils::TraceSpanRecord&& span);
+
+    const std::string path_;
+    const std::string service_name_;
+    const double sample_rate_;
+    const std::size_t max_queued_spans_;
+
+    std::mutex mutex_;
+    std::vector<Utils::TraceSpanRecord> queue_;
+    std::atomic<std::size_t> dropped_{0};
+    userver::utils::PeriodicTask flush_task_;
+};
+
+} // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::TraceExport> = true;
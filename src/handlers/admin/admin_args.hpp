@@ -0,0 +1,26 @@
+#pragma once
+
+#include <charconv>
+#include <optional>
+#include <string>
+
+namespace game_userver::admin {
+
+// Reads an integer query argument, `fallback` if it is missing. Returns
+// std::nullopt if it is malformed or outside [min, max].
+inline auto ParseIntArg(
+    const std::string& arg, int fallback, int min, int max
+) -> std::optional<int> {
+    if (arg.empty()) {
+        return fallback;
+    }
+    int value = 0;
+    const auto* last = arg.data() + arg.size();
+    const auto [end, error] = std::from_chars(arg.data(), last, value);
+    if (error != std::errc{} || end != last || value < min || value > max) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+} // namespace game_userver::admin
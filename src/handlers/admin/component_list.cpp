@@ -0,0 +1,14 @@
+#include "component_list.hpp"
+
+#include "cpu_profile.hpp"
+#include "task_processors.hpp"
+
+namespace game_userver {
+
+auto GetAdminComponentList() -> userver::components::ComponentList {
+    return userver::components::ComponentList()
+        .Append<AdminCpuProfile>()
+        .Append<AdminTaskProcessors>();
+}
+
+} // namespace game_userver
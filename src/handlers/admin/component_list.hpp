@@ -0,0 +1,9 @@
+#pragma once
+
+#include <userver/components/component_list.hpp>
+
+namespace game_userver {
+
+auto GetAdminComponentList() -> userver::components::ComponentList;
+
+} // namespace game_userver
@@ -0,0 +1,107 @@
+#include "cpu_profile.hpp"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/http/content_type.hpp>
+
+#include "admin_args.hpp"
+#include "utils/compression.hpp"
+#include "utils/cpu_profiler.hpp"
+#include "utils/task_processor_metrics.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr int kGzipLevel = 6;
+
+// Task processor state is attached as comments: `pprof -comments` prints
+// it next to the samples it explains
+void AddTaskProcessorComments(
+    Utils::CpuProfile& profile,
+    const std::map<std::string, Utils::TaskProcessorMetrics>& before,
+    const std::map<std::string, Utils::TaskProcessorMetrics>& after
+) {
+    const auto rates = Utils::GetCounterRates(before, after, profile.duration);
+    for (const auto& [taskProcessor, metrics] : after) {
+        for (const auto& [path, metric] : metrics) {
+            profile.comments.push_back(
+                taskProcessor + " " + path + " = " +
+                std::to_string(metric.value)
+            );
+        }
+        if (const auto it = rates.find(taskProcessor); it != rates.end()) {
+            for (const auto& [path, rate] : it->second) {
+                profile.comments.push_back(
+                    taskProcessor + " " + path + " = " +
+                    std::to_string(rate) + "/s"
+                );
+            }
+        }
+    }
+}
+
+} // namespace
+
+struct AdminCpuProfile::Impl {
+    const userver::utils::statistics::Storage& storage;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : storage(context
+                      .FindComponent<userver::components::StatisticsStorage>()
+                      .GetStorage()) {}
+};
+
+AdminCpuProfile::AdminCpuProfile(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context, /*is_monitor=*/true),
+      impl_(component_context) {}
+
+AdminCpuProfile::~AdminCpuProfile() = default;
+
+auto AdminCpuProfile::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    auto& response = request.GetHttpResponse();
+    const auto seconds =
+        admin::ParseIntArg(request.GetArg("seconds"), 10, 1, 60);
+    const auto frequency =
+        admin::ParseIntArg(request.GetArg("frequency"), 100, 1, 1000);
+    if (!seconds || !frequency) {
+        response.SetStatus(userver::server::http::HttpStatus::kBadRequest);
+        return "seconds must be within [1, 60], frequency within [1, 1000]";
+    }
+
+    const auto before = Utils::ReadTaskProcessorMetrics(impl_->storage);
+    if (!Utils::StartCpuProfile(*frequency)) {
+        response.SetStatus(userver::server::http::HttpStatus::kConflict);
+        return "Another profile is being taken";
+    }
+    // Stops early if the request is cancelled, the profile is still returned
+    userver::engine::InterruptibleSleepFor(std::chrono::seconds{*seconds});
+    auto profile = Utils::StopCpuProfile();
+    AddTaskProcessorComments(
+        profile, before, Utils::ReadTaskProcessorMetrics(impl_->storage)
+    );
+
+    response.SetContentType(
+        userver::http::content_type::kApplicationOctetStream
+    );
+    response.SetHeader(
+        std::string{"Content-Disposition"},
+        "attachment; filename=\"cpu.pb.gz\""
+    );
+    return Utils::Compress(
+        Utils::EncodePprof(profile), Utils::ContentEncoding::kGzip, kGzipLevel
+    );
+}
+
+} // namespace game_userver
@@ -0,0 +1,74 @@
+#include "task_processors.hpp"
+
+#include <chrono>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include "admin_args.hpp"
+#include "utils/task_processor_metrics.hpp"
+
+namespace game_userver {
+
+struct AdminTaskProcessors::Impl {
+    const userver::utils::statistics::Storage& storage;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : storage(context
+                      .FindComponent<userver::components::StatisticsStorage>()
+                      .GetStorage()) {}
+};
+
+AdminTaskProcessors::AdminTaskProcessors(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context, /*is_monitor=*/true),
+      impl_(component_context) {}
+
+AdminTaskProcessors::~AdminTaskProcessors() = default;
+
+auto AdminTaskProcessors::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    // Counters are read twice, `interval_ms` apart, to turn them into rates
+    const auto intervalMs =
+        admin::ParseIntArg(request.GetArg("interval_ms"), 1000, 10, 10000);
+    if (!intervalMs) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "interval_ms must be within [10, 10000]";
+    }
+
+    const auto before = Utils::ReadTaskProcessorMetrics(impl_->storage);
+    const auto startedAt = std::chrono::steady_clock::now();
+    userver::engine::InterruptibleSleepFor(
+        std::chrono::milliseconds{*intervalMs}
+    );
+    const auto after = Utils::ReadTaskProcessorMetrics(impl_->storage);
+    const auto rates = Utils::GetCounterRates(
+        before, after, std::chrono::steady_clock::now() - startedAt
+    );
+
+    userver::formats::json::ValueBuilder result{
+        userver::formats::common::Type::kObject
+    };
+    for (const auto& [taskProcessor, metrics] : after) {
+        auto item = result[taskProcessor];
+        for (const auto& [path, metric] : metrics) {
+            item["metrics"][path] = metric.value;
+        }
+        if (const auto it = rates.find(taskProcessor); it != rates.end()) {
+            for (const auto& [path, rate] : it->second) {
+                item["rates_per_second"][path] = rate;
+            }
+        }
+    }
+    return userver::formats::json::ToPrettyString(result.ExtractValue());
+}
+
+} // namespace game_userver
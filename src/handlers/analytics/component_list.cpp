@@ -0,0 +1,16 @@
+#include "component_list.hpp"
+
+#include "get_pack_stats.hpp"
+#include "get_question_stats.hpp"
+#include "submit_answer.hpp"
+
+namespace game_userver {
+
+auto GetAnalyticsComponentList() -> userver::components::ComponentList {
+    return userver::components::ComponentList()
+        .Append<SubmitAnswer>()
+        .Append<GetQuestionStats>()
+        .Append<GetPackStats>();
+}
+
+} // namespace game_userver
@@ -0,0 +1,56 @@
+#include "get_pack_stats.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/answer_stats.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+struct GetPackStats::Impl {
+    const NStorage::ShardRouter& shards;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
+};
+
+GetPackStats::GetPackStats(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+GetPackStats::~GetPackStats() = default;
+
+auto GetPackStats::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    const auto uuid = Utils::StringToUuid(request.GetArg("pack_id"));
+    if (uuid.is_nil()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect uuid";
+    }
+
+    const auto statsOpt = NStorage::GetPackStats(
+        impl_->shards, uuid, Utils::DeadlineFromHttp(request)
+    );
+    if (!statsOpt) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Pack not found";
+    }
+
+    return userver::formats::json::ToPrettyString(
+        userver::formats::json::ValueBuilder{*statsOpt}.ExtractValue()
+    );
+}
+
+} // namespace game_userver
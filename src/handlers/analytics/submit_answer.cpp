@@ -0,0 +1,88 @@
+#include "submit_answer.hpp"
+
+#include <optional>
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include "components/answer_analytics/answer_analytics.hpp"
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/answer_stats.hpp"
+#include "storage/pack_versions.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+struct SubmitAnswer::Impl {
+    const NStorage::ShardRouter& shards;
+    AnswerAnalytics& analytics;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()),
+          analytics(context.FindComponent<AnswerAnalytics>()) {}
+};
+
+SubmitAnswer::SubmitAnswer(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+SubmitAnswer::~SubmitAnswer() = default;
+
+auto SubmitAnswer::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    const auto& playerId = request.GetArg("player_id");
+    const auto variantId = Utils::StringToUuid(request.GetArg("variant_id"));
+    if (playerId.empty() || variantId.is_nil()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect player_id or variant_id";
+    }
+
+    // With `ref` (<pack_id>@<version> or <pack_id>) the answer is checked
+    // against the cached published version instead of the database
+    const auto deadline = Utils::DeadlineFromHttp(request);
+    std::optional<Models::AnswerKey> answerKey;
+    if (!request.HasArg("ref")) {
+        answerKey = NStorage::CheckAnswer(impl_->shards, variantId, deadline);
+    } else {
+        const auto ref = Models::ParsePackVersionRef(request.GetArg("ref"));
+        if (!ref) {
+            request.GetHttpResponse().SetStatus(
+                userver::server::http::HttpStatus::kBadRequest
+            );
+            return "Incorrect pack version reference";
+        }
+        const auto packVersion =
+            NStorage::GetPackVersion(impl_->shards, *ref, deadline);
+        if (!packVersion) {
+            request.GetHttpResponse().SetStatus(
+                userver::server::http::HttpStatus::kNotFound
+            );
+            return "Pack version not found";
+        }
+        answerKey = packVersion->FindAnswer(variantId);
+    }
+    if (!answerKey) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Variant not found";
+    }
+
+    impl_->analytics.Record(
+        {answerKey->pack_id, answerKey->question_id, variantId,
+         answerKey->is_correct, playerId}
+    );
+
+    userver::formats::json::ValueBuilder response;
+    response["is_correct"] = answerKey->is_correct;
+    return userver::formats::json::ToPrettyString(response.ExtractValue());
+}
+
+} // namespace game_userver
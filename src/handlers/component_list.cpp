@@ -1,18 +1,24 @@
 #include "component_list.hpp"
 
+#include "admin/component_list.hpp"
+#include "analytics/component_list.hpp"
 #include "content_handling/component_list.hpp"
 #include "grpc/component_list.hpp"
 #include "hello/component_list.hpp"
 #include "hello_postgres/component_list.hpp"
+#include "live/component_list.hpp"
 
 namespace game_userver {
 
 auto GetHandlersComponentList() -> userver::components::ComponentList {
     return userver::components::ComponentList()
+        .AppendComponentList(game_userver::GetAdminComponentList())
+        .AppendComponentList(game_userver::GetAnalyticsComponentList())
         .AppendComponentList(game_userver::GetContentHandlingComponentList())
         .AppendComponentList(game_userver::GetGrpcComponentList())
         .AppendComponentList(game_userver::GetHelloComponentList())
-        .AppendComponentList(game_userver::GetHelloPostgresComponentList());
+        .AppendComponentList(game_userver::GetHelloPostgresComponentList())
+        .AppendComponentList(game_userver::GetLiveComponentList());
 }
 
 } // namespace game_userver
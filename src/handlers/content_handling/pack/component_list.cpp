@@ -1,8 +1,14 @@
 #include "component_list.hpp"
 
 #include "create_pack.hpp"
+#include "delete_pack.hpp"
+#include "export_catalog.hpp"
 #include "get_all_packs.hpp"
 #include "get_pack_by_id.hpp"
+#include "get_pack_content.hpp"
+#include "get_pack_version.hpp"
+#include "publish_pack.hpp"
+#include "update_pack_title.hpp"
 
 namespace game_userver::pack {
 
@@ -10,7 +16,13 @@ auto GetPackHandlersComponentList() -> userver::components::ComponentList {
     return userver::components::ComponentList()
         .Append<CreatePack>()
         .Append<GetAllPacks>()
-        .Append<GetPack>();
+        .Append<GetPack>()
+        .Append<GetPackContent>()
+        .Append<UpdatePackTitle>()
+        .Append<DeletePack>()
+        .Append<PublishPack>()
+        .Append<GetPackVersion>()
+        .Append<ExportCatalog>();
 }
 
 } // namespace game_userver::pack
@@ -5,24 +5,19 @@
 #include <sql_queries/sql_queries.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/logging/log.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
 
+#include "components/sharded_storage/sharded_storage.hpp"
 #include "storage/packs.hpp"
 
-#include "utils/constants.hpp"
+#include "utils/deadline.hpp"
 
 namespace game_userver {
 
 struct CreatePack::Impl {
-    userver::storages::postgres::ClusterPtr pg_cluster;
+    const NStorage::ShardRouter& shards;
 
     explicit Impl(const userver::components::ComponentContext& context)
-        : pg_cluster(context
-                         .FindComponent<userver::components::Postgres>(
-                             Constants::kDatabaseName
-                         )
-                         .GetCluster()) {}
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
 };
 
 CreatePack::CreatePack(
@@ -43,7 +38,9 @@ auto CreatePack::HandleRequestThrow(
     const auto& title = request.GetArg("title");
     LOG(kDebug) << "title: " << title;
 
-    const auto createdPackOpt = NStorage::CreatePack(impl_->pg_cluster, title);
+    const auto createdPackOpt = NStorage::CreatePack(
+        impl_->shards, title, Utils::DeadlineFromHttp(request)
+    );
     if (!createdPackOpt) {
         request.GetHttpResponse().SetStatus(
             userver::server::http::HttpStatus::kInternalServerError
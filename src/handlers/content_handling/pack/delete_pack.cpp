@@ -0,0 +1,53 @@
+#include "delete_pack.hpp"
+
+#include <userver/components/component_context.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/packs.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+struct DeletePack::Impl {
+    const NStorage::ShardRouter& shards;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
+};
+
+DeletePack::DeletePack(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+DeletePack::~DeletePack() = default;
+
+auto DeletePack::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    const auto uuid = Utils::StringToUuid(request.GetArg("uuid"));
+    if (uuid.is_nil()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect uuid";
+    }
+
+    const auto deleted = NStorage::DeletePack(
+        impl_->shards, uuid, Utils::DeadlineFromHttp(request)
+    );
+    if (!deleted) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Pack not found";
+    }
+
+    return {};
+}
+
+} // namespace game_userver
@@ -0,0 +1,109 @@
+#include "export_catalog.hpp"
+
+#include <string>
+#include <userver/components/component_context.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
+#include <userver/utils/datetime.hpp>
+#include <utility>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "models/catalog_export.hpp"
+#include "storage/catalog_export.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+namespace {
+
+using userver::server::http::HttpStatus;
+using userver::server::http::ResponseBodyStream;
+
+// Records are pushed to the client in chunks of about this size
+constexpr std::size_t kChunkSize = 64 * 1024;
+
+void Reject(ResponseBodyStream& response_body_stream, std::string message) {
+    response_body_stream.SetStatusCode(HttpStatus::kBadRequest);
+    response_body_stream.SetEndOfHeaders();
+    response_body_stream.PushBodyChunk(std::move(message), {});
+}
+
+} // namespace
+
+struct ExportCatalog::Impl {
+    const NStorage::ShardRouter& shards;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
+};
+
+ExportCatalog::ExportCatalog(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+ExportCatalog::~ExportCatalog() = default;
+
+void ExportCatalog::HandleStreamRequest(
+    userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext& /*context*/,
+    ResponseBodyStream& response_body_stream
+) const {
+    const auto format = Models::ParseExportFormat(request.GetArg("format"));
+    if (!format) {
+        Reject(response_body_stream, "Unknown format");
+        return;
+    }
+
+    NStorage::CatalogExportFilter filter;
+    if (request.HasArg("pack_id")) {
+        filter.pack_id = Utils::StringToUuid(request.GetArg("pack_id"));
+        if (filter.pack_id->is_nil()) {
+            Reject(response_body_stream, "Incorrect pack_id");
+            return;
+        }
+    }
+    if (request.HasArg("modified_since")) {
+        try {
+            filter.modified_since = userver::storages::postgres::TimePointTz{
+                userver::utils::datetime::Stringtime(
+                    request.GetArg("modified_since")
+                )
+            };
+        } catch (const userver::utils::datetime::DateParseError&) {
+            Reject(response_body_stream, "modified_since must be RFC 3339");
+            return;
+        }
+    }
+
+    response_body_stream.SetStatusCode(HttpStatus::kOk);
+    response_body_stream.SetHeader(
+        std::string{"Content-Type"},
+        std::string{Models::GetExportContentType(*format)}
+    );
+    response_body_stream.SetEndOfHeaders();
+
+    // Past this point a failure can no longer change the status, it only
+    // cuts the body short
+    const auto deadline = Utils::DeadlineFromHttp(request);
+    std::string chunk{Models::GetExportHeader(*format)};
+    NStorage::ExportCatalog(
+        impl_->shards, filter,
+        [&](const Models::ExportedPack& pack,
+            const std::vector<Models::ExportedQuestionRow>& rows) {
+            Models::AppendExportedPack(chunk, *format, pack, rows);
+            if (chunk.size() >= kChunkSize) {
+                response_body_stream.PushBodyChunk(
+                    std::exchange(chunk, {}), deadline
+                );
+            }
+        },
+        deadline
+    );
+    if (!chunk.empty()) {
+        response_body_stream.PushBodyChunk(std::move(chunk), deadline);
+    }
+}
+
+} // namespace game_userver
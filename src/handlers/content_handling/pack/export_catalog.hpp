@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <userver/components/component_fwd.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+namespace game_userver {
+
+// Streams the whole catalog (or one pack, or packs changed since a moment)
+// as NDJSON or CSV in chunks, see NStorage::ExportCatalog. Needs
+// `response-body-stream: true` in its static config.
+class ExportCatalog final : public userver::server::handlers::HttpHandlerBase {
+public:
+    static constexpr std::string_view kName = "handler-export-catalog";
+
+    ExportCatalog(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+    ~ExportCatalog() override;
+
+    void HandleStreamRequest(
+        userver::server::http::HttpRequest& request,
+        userver::server::request::RequestContext& context,
+        userver::server::http::ResponseBodyStream& response_body_stream
+    ) const override;
+
+private:
+    struct Impl;
+    static constexpr size_t kSize = 16;
+    static constexpr size_t kAlignment = 8;
+    userver::utils::FastPimpl<Impl, kSize, kAlignment> impl_;
+};
+
+} // namespace game_userver
@@ -3,23 +3,18 @@
 #include <sql_queries/sql_queries.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/logging/log.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
 
+#include "components/sharded_storage/sharded_storage.hpp"
 #include "storage/packs.hpp"
-#include "utils/constants.hpp"
+#include "utils/deadline.hpp"
 
 namespace game_userver {
 
 struct GetAllPacks::Impl {
-    userver::storages::postgres::ClusterPtr pg_cluster;
+    const NStorage::ShardRouter& shards;
 
     explicit Impl(const userver::components::ComponentContext& context)
-        : pg_cluster(context
-                         .FindComponent<userver::components::Postgres>(
-                             Constants::kDatabaseName
-                         )
-                         .GetCluster()) {}
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
 };
 
 GetAllPacks::GetAllPacks(
@@ -31,21 +26,14 @@ GetAllPacks::GetAllPacks(
 GetAllPacks::~GetAllPacks() = default;
 
 std::string GetAllPacks::HandleRequestThrow(
-    const userver::server::http::HttpRequest& /*request*/,
+    const userver::server::http::HttpRequest& request,
     userver::server::request::RequestContext&
     /*context*/
 ) const {
-    const auto packs = NStorage::GetAllPacks(impl_->pg_cluster);
-
-    userver::formats::json::ValueBuilder result{
-        userver::formats::common::Type::kArray
-    };
-
-    for (const auto& pack : packs) {
-        result.PushBack(pack);
-    }
-
-    return userver::formats::json::ToPrettyString(result.ExtractValue());
+    // Rendered by Postgres, passed through without parsing
+    return NStorage::GetAllPacksJson(
+        impl_->shards, Utils::DeadlineFromHttp(request)
+    );
 }
 
 } // namespace game_userver
@@ -2,24 +2,19 @@
 
 #include <sql_queries/sql_queries.hpp>
 #include <userver/components/component_context.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
 
+#include "components/sharded_storage/sharded_storage.hpp"
 #include "storage/packs.hpp"
-#include "utils/constants.hpp"
+#include "utils/deadline.hpp"
 #include "utils/string_to_uuid.hpp"
 
 namespace game_userver {
 
 struct GetPack::Impl {
-    userver::storages::postgres::ClusterPtr pg_cluster;
+    const NStorage::ShardRouter& shards;
 
     explicit Impl(const userver::components::ComponentContext& context)
-        : pg_cluster(context
-                         .FindComponent<userver::components::Postgres>(
-                             Constants::kDatabaseName
-                         )
-                         .GetCluster()) {}
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
 };
 
 GetPack::GetPack(
@@ -42,7 +37,9 @@ auto GetPack::HandleRequestThrow(
         return "Incorrect uuid";
     }
 
-    const auto packOpt = NStorage::GetPackById(impl_->pg_cluster, uuid);
+    const auto packOpt = NStorage::GetPackById(
+        impl_->shards, uuid, Utils::DeadlineFromHttp(request)
+    );
     if (!packOpt) {
         return {};
     }
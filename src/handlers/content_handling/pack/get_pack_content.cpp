@@ -0,0 +1,54 @@
+#include "get_pack_content.hpp"
+
+#include <userver/components/component_context.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/packs.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+struct GetPackContent::Impl {
+    const NStorage::ShardRouter& shards;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
+};
+
+GetPackContent::GetPackContent(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+GetPackContent::~GetPackContent() = default;
+
+auto GetPackContent::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    const auto packId = Utils::StringToUuid(request.GetArg("id"));
+    if (packId.is_nil()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect id";
+    }
+
+    // The whole pack is rendered by Postgres in one query and passed
+    // through without parsing
+    auto content = NStorage::GetPackContentJson(
+        impl_->shards, packId, Utils::DeadlineFromHttp(request)
+    );
+    if (!content) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Pack not found";
+    }
+    return *std::move(content);
+}
+
+} // namespace game_userver
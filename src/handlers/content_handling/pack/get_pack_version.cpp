@@ -0,0 +1,57 @@
+#include "get_pack_version.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "models/pack_version.hpp"
+#include "storage/pack_versions.hpp"
+#include "utils/deadline.hpp"
+
+namespace game_userver {
+
+struct GetPackVersion::Impl {
+    const NStorage::ShardRouter& shards;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
+};
+
+GetPackVersion::GetPackVersion(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+GetPackVersion::~GetPackVersion() = default;
+
+auto GetPackVersion::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    // `ref` is <pack_id>@<version>, or just <pack_id> for the latest version
+    const auto ref = Models::ParsePackVersionRef(request.GetArg("ref"));
+    if (!ref) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect pack version reference";
+    }
+
+    const auto pack_version = NStorage::GetPackVersion(
+        impl_->shards, *ref, Utils::DeadlineFromHttp(request)
+    );
+    if (!pack_version) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Pack version not found";
+    }
+
+    return userver::formats::json::ToPrettyString(
+        userver::formats::json::ValueBuilder{*pack_version}.ExtractValue()
+    );
+}
+
+} // namespace game_userver
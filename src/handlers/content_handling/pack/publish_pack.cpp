@@ -0,0 +1,56 @@
+#include "publish_pack.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/pack_versions.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+struct PublishPack::Impl {
+    const NStorage::ShardRouter& shards;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
+};
+
+PublishPack::PublishPack(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+PublishPack::~PublishPack() = default;
+
+auto PublishPack::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    const auto uuid = Utils::StringToUuid(request.GetArg("uuid"));
+    if (uuid.is_nil()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect uuid";
+    }
+
+    const auto published = NStorage::PublishPack(
+        impl_->shards, uuid, Utils::DeadlineFromHttp(request)
+    );
+    if (!published) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Pack not found";
+    }
+
+    return userver::formats::json::ToPrettyString(
+        userver::formats::json::ValueBuilder{*published}.ExtractValue()
+    );
+}
+
+} // namespace game_userver
@@ -0,0 +1,61 @@
+#include "update_pack_title.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/packs.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+struct UpdatePackTitle::Impl {
+    const NStorage::ShardRouter& shards;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
+};
+
+UpdatePackTitle::UpdatePackTitle(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+UpdatePackTitle::~UpdatePackTitle() = default;
+
+auto UpdatePackTitle::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    const auto uuid = Utils::StringToUuid(request.GetArg("uuid"));
+    if (uuid.is_nil()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect uuid";
+    }
+
+    const auto& title = request.GetArg("title");
+
+    // Caches of other instances are invalidated by the NOTIFY the update
+    // triggers, see PackInvalidation
+    const auto updatedPackOpt = NStorage::UpdatePackTitle(
+        impl_->shards, uuid, title, Utils::DeadlineFromHttp(request)
+    );
+    if (!updatedPackOpt) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Pack not found";
+    }
+
+    return userver::formats::json::ToPrettyString(
+        userver::formats::json::ValueBuilder{updatedPackOpt.value()}
+            .ExtractValue()
+    );
+}
+
+} // namespace game_userver
@@ -1,6 +1,7 @@
 #include "component_list.hpp"
 
 #include "create_question.hpp"
+#include "create_question_with_variants.hpp"
 #include "get_question_by_id.hpp"
 #include "get_questions_by_pack_id.hpp"
 
@@ -9,6 +10,7 @@ namespace game_userver::question {
 auto GetQuestionHandlersComponentList() -> userver::components::ComponentList {
     return userver::components::ComponentList()
         .Append<CreateQuestion>()
+        .Append<CreateQuestionWithVariants>()
         .Append<GetQuestionById>()
         .Append<GetQuestionsByPackId>();
 }
@@ -2,24 +2,19 @@
 
 #include <sql_queries/sql_queries.hpp>
 #include <userver/components/component_context.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
 
+#include "components/sharded_storage/sharded_storage.hpp"
 #include "storage/questions.hpp"
-#include "utils/constants.hpp"
+#include "utils/deadline.hpp"
 #include "utils/string_to_uuid.hpp"
 
 namespace game_userver {
 
 struct CreateQuestion::Impl {
-    userver::storages::postgres::ClusterPtr pg_cluster;
+    const NStorage::ShardRouter& shards;
 
     explicit Impl(const userver::components::ComponentContext& context)
-        : pg_cluster(context
-                         .FindComponent<userver::components::Postgres>(
-                             Constants::kDatabaseName
-                         )
-                         .GetCluster()) {}
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
 };
 
 CreateQuestion::CreateQuestion(
@@ -40,7 +35,8 @@ auto CreateQuestion::HandleRequestThrow(
     const auto& image_url = request.GetArg("image_url");
 
     const auto createdQuestionOpt = NStorage::CreateQuestion(
-        impl_->pg_cluster, Utils::StringToUuid(pack_id), text, image_url
+        impl_->shards, Utils::StringToUuid(pack_id), text, image_url,
+        Utils::DeadlineFromHttp(request)
     );
 
     if (!createdQuestionOpt) {
@@ -0,0 +1,82 @@
+#include "create_question_with_variants.hpp"
+
+#include <sql_queries/sql_queries.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "models/question_with_variants.hpp"
+#include "storage/questions.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+struct CreateQuestionWithVariants::Impl {
+    const NStorage::ShardRouter& shards;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
+};
+
+CreateQuestionWithVariants::CreateQuestionWithVariants(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+CreateQuestionWithVariants::~CreateQuestionWithVariants() = default;
+
+auto CreateQuestionWithVariants::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    // {"pack_id": ..., "text": ..., "image_url": ...,
+    //  "variants": [{"text": ..., "is_correct": ...}, ...]}
+    boost::uuids::uuid pack_id;
+    std::string text;
+    std::string image_url;
+    std::vector<Models::VariantDraft> variants;
+    try {
+        const auto body =
+            userver::formats::json::FromString(request.RequestBody());
+        pack_id = Utils::StringToUuid(body["pack_id"].As<std::string>());
+        text = body["text"].As<std::string>();
+        image_url = body["image_url"].As<std::string>("");
+        variants = body["variants"].As<std::vector<Models::VariantDraft>>(
+            std::vector<Models::VariantDraft>{}
+        );
+    } catch (const userver::formats::json::Exception& e) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return e.what();
+    }
+
+    if (pack_id.is_nil()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect pack_id";
+    }
+
+    const auto createdOpt = NStorage::CreateQuestionWithVariants(
+        impl_->shards, pack_id, text, image_url, variants,
+        Utils::DeadlineFromHttp(request)
+    );
+
+    if (!createdOpt) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kInternalServerError
+        );
+        throw std::runtime_error("Failed to create question with variants");
+    }
+
+    return userver::formats::json::ToPrettyString(
+        userver::formats::json::ValueBuilder{createdOpt.value()}.ExtractValue()
+    );
+}
+
+} // namespace game_userver
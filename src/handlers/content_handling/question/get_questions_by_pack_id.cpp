@@ -2,24 +2,19 @@
 
 #include <sql_queries/sql_queries.hpp>
 #include <userver/components/component_context.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
 
+#include "components/sharded_storage/sharded_storage.hpp"
 #include "storage/questions.hpp"
-#include "utils/constants.hpp"
+#include "utils/deadline.hpp"
 #include "utils/string_to_uuid.hpp"
 
 namespace game_userver {
 
 struct GetQuestionsByPackId::Impl {
-    userver::storages::postgres::ClusterPtr pg_cluster;
+    const NStorage::ShardRouter& shards;
 
     explicit Impl(const userver::components::ComponentContext& context)
-        : pg_cluster(context
-                         .FindComponent<userver::components::Postgres>(
-                             Constants::kDatabaseName
-                         )
-                         .GetCluster()) {}
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
 };
 
 GetQuestionsByPackId::GetQuestionsByPackId(
@@ -37,19 +32,11 @@ auto GetQuestionsByPackId::HandleRequestThrow(
 ) const -> std::string {
     const auto& stringPackId = request.GetArg("pack_id");
 
-    const auto questions = NStorage::GetQuestionsByPackId(
-        impl_->pg_cluster, Utils::StringToUuid(stringPackId)
+    // Rendered by Postgres, passed through without parsing
+    return NStorage::GetQuestionsByPackIdJson(
+        impl_->shards, Utils::StringToUuid(stringPackId),
+        Utils::DeadlineFromHttp(request)
     );
-
-    userver::formats::json::ValueBuilder result{
-        userver::formats::common::Type::kArray
-    };
-
-    for (const auto& question : questions) {
-        result.PushBack(question);
-    }
-
-    return userver::formats::json::ToPrettyString(result.ExtractValue());
 }
 
 } // namespace game_userver
@@ -3,24 +3,19 @@
 #include <sql_queries/sql_queries.hpp>
 #include <stdexcept>
 #include <userver/components/component_context.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
 
+#include "components/sharded_storage/sharded_storage.hpp"
 #include "storage/variants.hpp"
-#include "utils/constants.hpp"
+#include "utils/deadline.hpp"
 #include "utils/string_to_uuid.hpp"
 
 namespace game_userver {
 
 struct CreateVariant::Impl {
-    userver::storages::postgres::ClusterPtr pg_cluster;
+    const NStorage::ShardRouter& shards;
 
     explicit Impl(const userver::components::ComponentContext& context)
-        : pg_cluster(context
-                         .FindComponent<userver::components::Postgres>(
-                             Constants::kDatabaseName
-                         )
-                         .GetCluster()) {}
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
 };
 
 CreateVariant::CreateVariant(
@@ -41,8 +36,8 @@ auto CreateVariant::HandleRequestThrow(
     const auto& is_correct = request.GetArg("is_correct");
 
     const auto createdVariantOpt = NStorage::CreateVariant(
-        impl_->pg_cluster, Utils::StringToUuid(question_id), text,
-        Utils::StringToBool(is_correct)
+        impl_->shards, Utils::StringToUuid(question_id), text,
+        Utils::StringToBool(is_correct), Utils::DeadlineFromHttp(request)
     );
 
     if (!createdVariantOpt) {
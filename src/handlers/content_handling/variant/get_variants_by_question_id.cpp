@@ -2,24 +2,19 @@
 
 #include <sql_queries/sql_queries.hpp>
 #include <userver/components/component_context.hpp>
-#include <userver/storages/postgres/cluster.hpp>
-#include <userver/storages/postgres/component.hpp>
 
+#include "components/sharded_storage/sharded_storage.hpp"
 #include "storage/variants.hpp"
-#include "utils/constants.hpp"
+#include "utils/deadline.hpp"
 #include "utils/string_to_uuid.hpp"
 
 namespace game_userver {
 
 struct GetVariantsByQuestionId::Impl {
-    userver::storages::postgres::ClusterPtr pg_cluster;
+    const NStorage::ShardRouter& shards;
 
     explicit Impl(const userver::components::ComponentContext& context)
-        : pg_cluster(context
-                         .FindComponent<userver::components::Postgres>(
-                             Constants::kDatabaseName
-                         )
-                         .GetCluster()) {}
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()) {}
 };
 
 GetVariantsByQuestionId::GetVariantsByQuestionId(
@@ -38,7 +33,8 @@ auto GetVariantsByQuestionId::HandleRequestThrow(
     const auto& stringQuestionId = request.GetArg("question_id");
 
     const auto variants = NStorage::GetVariantsByQuestionId(
-        impl_->pg_cluster, Utils::StringToUuid(stringQuestionId)
+        impl_->shards, Utils::StringToUuid(stringQuestionId),
+        Utils::DeadlineFromHttp(request)
     );
 
     userver::formats::json::ValueBuilder result{
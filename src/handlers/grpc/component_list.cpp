@@ -1,11 +1,14 @@
 #include "component_list.hpp"
 
+#include "live_session_service.hpp"
 #include "service.hpp"
 
 namespace game_userver {
 
 auto GetGrpcComponentList() -> userver::components::ComponentList {
-    return userver::components::ComponentList().Append<game_userver::Service>();
+    return userver::components::ComponentList()
+        .Append<game_userver::Service>()
+        .Append<game_userver::LiveSessionService>();
 }
 
 } // namespace game_userver
@@ -0,0 +1,103 @@
+#include "live_session_service.hpp"
+
+#include <chrono>
+#include <optional>
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <utils/deadline.hpp>
+#include <utils/string_to_uuid.hpp>
+
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/pack_versions.hpp"
+
+namespace game_userver {
+
+namespace {
+
+auto InvalidId() -> grpc::Status {
+    return grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "Incorrect id"};
+}
+
+auto SessionNotFound() -> grpc::Status {
+    return grpc::Status{grpc::StatusCode::NOT_FOUND, "Session not found"};
+}
+
+auto MakeResponse(const Models::LiveSession& session)
+    -> handlers::api::LiveSessionResponse {
+    handlers::api::LiveSessionResponse response;
+    response.set_session_json(userver::formats::json::ToString(
+        userver::formats::json::ValueBuilder{session}.ExtractValue()
+    ));
+    return response;
+}
+
+} // namespace
+
+LiveSessionService::LiveSessionService(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : handlers::api::LiveSessionServiceBase::Component(
+          config, component_context
+      ),
+      shards_(component_context.FindComponent<ShardedStorage>().GetRouter()),
+      sessions_(component_context.FindComponent<LiveSessions>()) {}
+
+auto LiveSessionService::StartSession(
+    CallContext& context, handlers::api::StartLiveSessionRequest&& request
+) -> LiveSessionService::StartSessionResult {
+    const auto sessionId = Utils::StringToUuid(request.session_id());
+    const auto packId = Utils::StringToUuid(request.pack_id());
+    if (sessionId.is_nil() || packId.is_nil()) {
+        return InvalidId();
+    }
+
+    auto packVersion = NStorage::GetPackVersion(
+        shards_, packId, request.version(),
+        Utils::DeadlineFromGrpc(context.GetServerContext())
+    );
+    if (!packVersion) {
+        return grpc::Status{
+            grpc::StatusCode::NOT_FOUND, "Pack version not found"
+        };
+    }
+
+    std::optional<std::chrono::milliseconds> roundDuration;
+    if (request.round_duration_ms() > 0) {
+        roundDuration = std::chrono::milliseconds{request.round_duration_ms()};
+    }
+    return MakeResponse(
+        sessions_.Start(sessionId, std::move(packVersion), roundDuration)
+    );
+}
+
+auto LiveSessionService::GetSession(
+    CallContext& /*context*/, handlers::api::LiveSessionRequest&& request
+) -> LiveSessionService::GetSessionResult {
+    const auto sessionId = Utils::StringToUuid(request.session_id());
+    if (sessionId.is_nil()) {
+        return InvalidId();
+    }
+    const auto session = sessions_.Get(sessionId);
+    if (!session) {
+        return SessionNotFound();
+    }
+    return MakeResponse(*session);
+}
+
+auto LiveSessionService::NextQuestion(
+    CallContext& /*context*/, handlers::api::LiveSessionRequest&& request
+) -> LiveSessionService::NextQuestionResult {
+    const auto sessionId = Utils::StringToUuid(request.session_id());
+    if (sessionId.is_nil()) {
+        return InvalidId();
+    }
+    const auto session = sessions_.NextQuestion(sessionId);
+    if (!session) {
+        return SessionNotFound();
+    }
+    return MakeResponse(*session);
+}
+
+} // namespace game_userver
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <handlers/live_service.usrv.pb.hpp>
+#include <string_view>
+#include <userver/components/component.hpp>
+
+#include "components/live_sessions/live_sessions.hpp"
+#include "storage/shard_router.hpp"
+
+namespace game_userver {
+
+// Serves live session calls forwarded by LiveSessionRouter of other
+// instances from the LiveSessions of this one, never forwarding them again
+class LiveSessionService final
+    : public handlers::api::LiveSessionServiceBase::Component {
+public:
+    static constexpr std::string_view kName = "handler-live-session-grpc";
+
+    LiveSessionService(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+
+    auto StartSession(
+        CallContext& /*context*/,
+        handlers::api::StartLiveSessionRequest&& /*request*/
+    ) -> StartSessionResult override;
+
+    auto GetSession(
+        CallContext& /*context*/,
+        handlers::api::LiveSessionRequest&& /*request*/
+    ) -> GetSessionResult override;
+
+    auto NextQuestion(
+        CallContext& /*context*/,
+        handlers::api::LiveSessionRequest&& /*request*/
+    ) -> NextQuestionResult override;
+
+private:
+    const NStorage::ShardRouter& shards_;
+    LiveSessions& sessions_;
+};
+
+} // namespace game_userver
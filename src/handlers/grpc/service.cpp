@@ -3,291 +3,850 @@
 #include <models/models.pb.h> // proto model Pack
 
 #include <boost/uuid/uuid_io.hpp> // for responce
-#include <models/pack.hpp>        // cpp model Pack
+#include <models/compact_pack_version.hpp>
+#include <models/pack.hpp> // cpp model Pack
+#include <models/pack_version.hpp>
 #include <models/question.hpp>
+#include <models/question_with_variants.hpp>
 #include <models/variant.hpp>
-#include <userver/storages/postgres/component.hpp>
+#include <stdexcept>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <utils/deadline.hpp>
 #include <utils/string_to_uuid.hpp>
 
+#include "components/answer_analytics/answer_analytics.hpp"
+#include "components/load_shedding/load_shedding.hpp"
+#include "components/rate_limiting/rate_limiting.hpp"
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "storage/answer_stats.hpp"
+#include "storage/pack_versions.hpp"
 #include "storage/packs.hpp" // for db request CreatePack
 #include "storage/questions.hpp"
 #include "storage/variants.hpp"
-#include "utils/constants.hpp"
 
 namespace game_userver {
 
+namespace {
+
+constexpr std::string_view kMethods[] = {
+    "CreatePack",
+    "GetPackById",
+    "GetAllPacks",
+    "UpdatePackTitle",
+    "DeletePack",
+    "PublishPack",
+    "GetPackVersion",
+    "CreateQuestion",
+    "CreateQuestionWithVariants",
+    "GetQuestionById",
+    "GetQuestionsByPackId",
+    "CreateVariant",
+    "GetVariantById",
+    "GetVariantsByQuestionId",
+    "SubmitAnswer",
+    "GetQuestionStats",
+    "GetPackStats",
+};
+
+using userver::engine::Deadline;
+
+// Thrown by the methods for a malformed request, becomes INVALID_ARGUMENT
+class InvalidArgument final : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+auto ParseUuid(const std::string& value) -> boost::uuids::uuid {
+    const auto uuid = Utils::StringToUuid(value);
+    if (uuid.is_nil()) {
+        throw InvalidArgument("Invalid UUID format: " + value);
+    }
+    return uuid;
+}
+
+auto DeadlineExceeded() -> grpc::Status {
+    return grpc::Status{
+        grpc::StatusCode::DEADLINE_EXCEEDED, "Deadline exceeded"
+    };
+}
+
+auto ResourceExhausted() -> grpc::Status {
+    return grpc::Status{
+        grpc::StatusCode::RESOURCE_EXHAUSTED, "Too many requests"
+    };
+}
+
+void FillPackVersion(
+    const Models::CompactPackVersion& pack_version,
+    Models::Proto::PackVersion& response
+) {
+    const auto packId = boost::uuids::to_string(pack_version.GetPackId());
+    response.set_pack_id(packId);
+    response.set_version(pack_version.GetVersion());
+    response.set_title(std::string{pack_version.GetTitle()});
+
+    for (std::size_t i = 0; i < pack_version.GetQuestionCount(); ++i) {
+        const auto questionId =
+            boost::uuids::to_string(pack_version.GetQuestionId(i));
+        auto* newQuestion = response.add_questions();
+        newQuestion->set_id(questionId);
+        newQuestion->set_pack_id(packId);
+        newQuestion->set_text(std::string{pack_version.GetQuestionText(i)});
+        auto imageUrl = pack_version.GetImageUrl(i);
+        if (!imageUrl.empty()) {
+            newQuestion->set_image_url(std::move(imageUrl));
+        }
+
+        for (auto j = pack_version.GetFirstVariant(i);
+             j < pack_version.GetLastVariant(i); ++j) {
+            auto* newVariant = response.add_variants();
+            newVariant->set_id(
+                boost::uuids::to_string(pack_version.GetVariantId(j))
+            );
+            newVariant->set_question_id(questionId);
+            newVariant->set_text(std::string{pack_version.GetVariantText(j)});
+            newVariant->set_is_correct(pack_version.IsCorrect(j));
+        }
+    }
+}
+
+} // namespace
+
 Service::Service(
     const userver::components::ComponentConfig& config,
     const userver::components::ComponentContext& component_context
 )
     : handlers::api::QuizServiceBase::Component(config, component_context),
-      pg_cluster_(component_context
-                      .FindComponent<userver::components::Postgres>(
-                          Constants::kDatabaseName
-                      )
-                      .GetCluster()) {}
-
-auto Service::CreatePack(
-    CallContext&, handlers::api::CreatePackRequest&& request
-) -> Service::CreatePackResult {
-    if (request.title().empty()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT, "Title cannot be empty"
-        };
+      shards_(component_context.FindComponent<ShardedStorage>().GetRouter()),
+      load_shedding_(component_context.FindComponent<LoadShedding>()),
+      rate_limiting_(component_context.FindComponent<RateLimiting>()),
+      analytics_(component_context.FindComponent<AnswerAnalytics>()),
+      trace_export_(component_context.FindComponent<TraceExport>()),
+      bulk_task_processor_(component_context.GetTaskProcessor(
+          config["bulk-task-processor"].As<std::string>("bulk-task-processor")
+      )) {
+    for (const auto method : kMethods) {
+        method_limiters_.emplace(method, load_shedding_.MakeEndpointLimiter());
     }
+}
 
-    auto createdPackOpt = NStorage::CreatePack(pg_cluster_, request.title());
+auto Service::Admit(
+    CallContext& context, std::string_view method, RequestClass request_class
+) const -> std::optional<LoadShedding::Admission> {
+    // Per-player limits go first, rejecting a flood costs no limiter slot
+    const auto client = RateLimiting::GetClient(context.GetServerContext());
+    if (!rate_limiting_.Allow(method, client)) {
+        return std::nullopt;
+    }
+    return load_shedding_.Admit(*method_limiters_.at(method), request_class);
+}
 
-    if (!createdPackOpt.has_value()) {
-        return grpc::Status{
-            grpc::StatusCode::INTERNAL, "Failed to create pack"
-        };
+template <typename Result, typename Func>
+auto Service::Call(
+    CallContext& context, std::string_view method, RequestClass request_class,
+    Func&& func
+) const -> Result {
+    const auto trace = trace_export_.StartSpan("grpc." + std::string{method});
+    auto admission = Admit(context, method, request_class);
+    if (!admission) {
+        return ResourceExhausted();
     }
-    auto createdPack = createdPackOpt.value();
 
-    handlers::api::CreatePackResponse responce;
-    auto* mutualPack = responce.mutable_pack();
-    mutualPack->set_id(boost::uuids::to_string(createdPack.id));
-    mutualPack->set_title(std::move(createdPack.title));
-    return responce;
-}
+    const auto deadline = Utils::DeadlineFromGrpc(context.GetServerContext());
+    if (deadline.IsReached()) {
+        admission->Cancel();
+        return DeadlineExceeded();
+    }
 
-auto Service::GetPackById(
-    CallContext& /*context*/, handlers::api::GetPackByIdRequest&& request
-) -> Service::GetPackByIdResult {
-    auto pack_id = Utils::StringToUuid(request.id());
-    if (pack_id.is_nil()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT,
-            "Invalid UUID format: " + request.id()
-        };
+    std::optional<Result> result;
+    try {
+        result.emplace(std::forward<Func>(func)(deadline));
+    } catch (const InvalidArgument& ex) {
+        result.emplace(
+            grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, ex.what()}
+        );
+    } catch (const Utils::DeadlineExceeded&) {
+        result.emplace(DeadlineExceeded());
+    } catch (const userver::storages::postgres::QueryCancelled&) {
+        // The statement timeout, shrunk to what is left of the deadline
+        result.emplace(DeadlineExceeded());
+    } catch (const userver::storages::postgres::ConnectionTimeoutError&) {
+        result.emplace(DeadlineExceeded());
+    } catch (...) {
+        admission->Cancel();
+        throw;
     }
-    auto getPackByIdOpt = NStorage::GetPackById(pg_cluster_, pack_id);
 
-    if (!getPackByIdOpt.has_value()) {
-        return grpc::Status{grpc::StatusCode::NOT_FOUND, "Pack not found"};
+    // Only successes and timeouts tell how loaded the method is, an error
+    // that came back right away is no latency sample
+    if (!result->IsSuccess() &&
+        result->GetErrorStatus().error_code() !=
+            grpc::StatusCode::DEADLINE_EXCEEDED) {
+        admission->Cancel();
     }
+    return std::move(*result);
+}
 
-    auto getPackById = getPackByIdOpt.value();
+auto Service::CreatePack(
+    CallContext& context, handlers::api::CreatePackRequest&& request
+) -> Service::CreatePackResult {
+    return Call<CreatePackResult>(
+        context, "CreatePack", RequestClass::kWrite,
+        [&](Deadline deadline) -> CreatePackResult {
+            if (request.title().empty()) {
+                return grpc::Status{
+                    grpc::StatusCode::INVALID_ARGUMENT,
+                    "Title cannot be empty"
+                };
+            }
+
+            auto createdPackOpt = Traced("storage.CreatePack", [&] {
+                return NStorage::CreatePack(
+                    shards_, request.title(), deadline
+                );
+            });
+
+            if (!createdPackOpt.has_value()) {
+                return grpc::Status{
+                    grpc::StatusCode::INTERNAL, "Failed to create pack"
+                };
+            }
+            auto createdPack = createdPackOpt.value();
+
+            handlers::api::CreatePackResponse responce;
+            auto* mutualPack = responce.mutable_pack();
+            mutualPack->set_id(boost::uuids::to_string(createdPack.id));
+            mutualPack->set_title(std::move(createdPack.title));
+            return responce;
+        }
+    );
+}
 
-    handlers::api::GetPackByIdResponse responce;
-    auto* mutualPack = responce.mutable_pack();
-    mutualPack->set_id(boost::uuids::to_string(getPackById.id));
-    mutualPack->set_title(std::move(getPackById.title));
-    return responce;
+auto Service::GetPackById(
+    CallContext& context, handlers::api::GetPackByIdRequest&& request
+) -> Service::GetPackByIdResult {
+    return Call<GetPackByIdResult>(
+        context, "GetPackById", RequestClass::kRead,
+        [&](Deadline deadline) -> GetPackByIdResult {
+            const auto pack_id = ParseUuid(request.id());
+            auto getPackByIdOpt = Traced("storage.GetPackById", [&] {
+                return NStorage::GetPackById(shards_, pack_id, deadline);
+            });
+
+            if (!getPackByIdOpt.has_value()) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Pack not found"
+                };
+            }
+
+            auto getPackById = getPackByIdOpt.value();
+
+            handlers::api::GetPackByIdResponse responce;
+            auto* mutualPack = responce.mutable_pack();
+            mutualPack->set_id(boost::uuids::to_string(getPackById.id));
+            mutualPack->set_title(std::move(getPackById.title));
+            return responce;
+        }
+    );
 }
 
 auto Service::GetAllPacks(
-    CallContext& /*context*/, handlers::api::GetAllPacksRequest&& request
+    CallContext& context, handlers::api::GetAllPacksRequest&& /*request*/
 ) -> Service::GetAllPacksResult {
-    auto getAllPacks = NStorage::GetAllPacks(pg_cluster_);
-
-    handlers::api::GetAllPacksResponse responce;
-    auto* mutualPacks = responce.mutable_packs();
-    for (auto&& pack : getAllPacks) {
-        Models::Proto::Pack packResponse;
-        packResponse.set_id(boost::uuids::to_string(pack.id));
-        packResponse.set_title(std::move(pack.title));
+    return Call<GetAllPacksResult>(
+        context, "GetAllPacks", RequestClass::kRead,
+        [&](Deadline deadline) -> GetAllPacksResult {
+            return OnBulk("bulk.GetAllPacks", [&] {
+                auto getAllPacks = Traced("storage.GetAllPacks", [&] {
+                    return NStorage::GetAllPacks(shards_, deadline);
+                });
+
+                handlers::api::GetAllPacksResponse responce;
+                auto* mutualPacks = responce.mutable_packs();
+                Traced("serialize.Packs", [&] {
+                    for (auto&& pack : getAllPacks) {
+                        Models::Proto::Pack packResponse;
+                        packResponse.set_id(boost::uuids::to_string(pack.id));
+                        packResponse.set_title(std::move(pack.title));
+
+                        mutualPacks->Add(std::move(packResponse));
+                    }
+                });
+                return responce;
+            });
+        }
+    );
+}
 
-        mutualPacks->Add(std::move(packResponse));
-    }
-    return responce;
+auto Service::UpdatePackTitle(
+    CallContext& context, handlers::api::UpdatePackTitleRequest&& request
+) -> Service::UpdatePackTitleResult {
+    return Call<UpdatePackTitleResult>(
+        context, "UpdatePackTitle", RequestClass::kWrite,
+        [&](Deadline deadline) -> UpdatePackTitleResult {
+            const auto pack_id = ParseUuid(request.id());
+            auto updatedPackOpt = Traced("storage.UpdatePackTitle", [&] {
+                return NStorage::UpdatePackTitle(
+                    shards_, pack_id, request.title(), deadline
+                );
+            });
+
+            if (!updatedPackOpt.has_value()) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Pack not found"
+                };
+            }
+
+            auto updatedPack = updatedPackOpt.value();
+
+            handlers::api::UpdatePackTitleResponse responce;
+            auto* mutualPack = responce.mutable_pack();
+            mutualPack->set_id(boost::uuids::to_string(updatedPack.id));
+            mutualPack->set_title(std::move(updatedPack.title));
+            return responce;
+        }
+    );
 }
 
-auto Service::CreateQuestion(
-    CallContext& /*context*/, handlers::api::CreateQuestionRequest&& request
-) -> Service::CreateQuestionResult {
-    if (request.text().empty()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT, "Question text cannot be empty"
-        };
-    }
+auto Service::DeletePack(
+    CallContext& context, handlers::api::DeletePackRequest&& request
+) -> Service::DeletePackResult {
+    return Call<DeletePackResult>(
+        context, "DeletePack", RequestClass::kWrite,
+        [&](Deadline deadline) -> DeletePackResult {
+            const auto pack_id = ParseUuid(request.id());
+            const auto deleted = Traced("storage.DeletePack", [&] {
+                return NStorage::DeletePack(shards_, pack_id, deadline);
+            });
+            if (!deleted) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Pack not found"
+                };
+            }
+            return handlers::api::DeletePackResponse{};
+        }
+    );
+}
 
-    auto pack_id = Utils::StringToUuid(request.pack_id());
-    if (pack_id.is_nil()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT,
-            "Invalid UUID format: " + request.pack_id()
-        };
-    }
-    auto createdQuestionOpt = NStorage::CreateQuestion(
-        pg_cluster_, pack_id, request.text(), request.image_url()
+auto Service::PublishPack(
+    CallContext& context, handlers::api::PublishPackRequest&& request
+) -> Service::PublishPackResult {
+    return Call<PublishPackResult>(
+        context, "PublishPack", RequestClass::kWrite,
+        [&](Deadline deadline) -> PublishPackResult {
+            const auto pack_id = ParseUuid(request.id());
+            const auto published = Traced("storage.PublishPack", [&] {
+                return NStorage::PublishPack(shards_, pack_id, deadline);
+            });
+            if (!published) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Pack not found"
+                };
+            }
+
+            handlers::api::PublishPackResponse response;
+            Traced("serialize.PackVersion", [&] {
+                FillPackVersion(*published, *response.mutable_pack_version());
+            });
+            return response;
+        }
     );
+}
 
-    if (!createdQuestionOpt.has_value()) {
-        return grpc::Status{
-            grpc::StatusCode::INTERNAL, "Failed to create question"
-        };
-    }
-    auto createdQuestion = createdQuestionOpt.value();
+auto Service::GetPackVersion(
+    CallContext& context, handlers::api::GetPackVersionRequest&& request
+) -> Service::GetPackVersionResult {
+    return Call<GetPackVersionResult>(
+        context, "GetPackVersion", RequestClass::kRead,
+        [&](Deadline deadline) -> GetPackVersionResult {
+            const auto pack_id = ParseUuid(request.pack_id());
+            if (request.version() < 0) {
+                return grpc::Status{
+                    grpc::StatusCode::INVALID_ARGUMENT,
+                    "Version cannot be negative"
+                };
+            }
+
+            // Version 0 stands for the latest one
+            Models::PackVersionRef ref{pack_id, std::nullopt};
+            if (request.version() != 0) {
+                ref.version = request.version();
+            }
+            const auto pack_version = Traced("storage.GetPackVersion", [&] {
+                return NStorage::GetPackVersion(shards_, ref, deadline);
+            });
+            if (!pack_version) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Pack version not found"
+                };
+            }
+
+            handlers::api::GetPackVersionResponse response;
+            Traced("serialize.PackVersion", [&] {
+                FillPackVersion(
+                    *pack_version, *response.mutable_pack_version()
+                );
+            });
+            return response;
+        }
+    );
+}
 
-    handlers::api::CreateQuestionResponse response;
-    auto* mutableQuestion = response.mutable_question();
-    mutableQuestion->set_id(boost::uuids::to_string(createdQuestion.id));
-    mutableQuestion->set_pack_id(
-        boost::uuids::to_string(createdQuestion.pack_id)
+auto Service::CreateQuestion(
+    CallContext& context, handlers::api::CreateQuestionRequest&& request
+) -> Service::CreateQuestionResult {
+    return Call<CreateQuestionResult>(
+        context, "CreateQuestion", RequestClass::kWrite,
+        [&](Deadline deadline) -> CreateQuestionResult {
+            if (request.text().empty()) {
+                return grpc::Status{
+                    grpc::StatusCode::INVALID_ARGUMENT,
+                    "Question text cannot be empty"
+                };
+            }
+
+            const auto pack_id = ParseUuid(request.pack_id());
+            auto createdQuestionOpt = Traced("storage.CreateQuestion", [&] {
+                return NStorage::CreateQuestion(
+                    shards_, pack_id, request.text(), request.image_url(),
+                    deadline
+                );
+            });
+
+            if (!createdQuestionOpt.has_value()) {
+                return grpc::Status{
+                    grpc::StatusCode::INTERNAL, "Failed to create question"
+                };
+            }
+            auto createdQuestion = createdQuestionOpt.value();
+
+            handlers::api::CreateQuestionResponse response;
+            auto* mutableQuestion = response.mutable_question();
+            mutableQuestion->set_id(
+                boost::uuids::to_string(createdQuestion.id)
+            );
+            mutableQuestion->set_pack_id(
+                boost::uuids::to_string(createdQuestion.pack_id)
+            );
+            mutableQuestion->set_text(std::move(createdQuestion.text));
+            if (!createdQuestion.image_url.empty()) {
+                mutableQuestion->set_image_url(createdQuestion.image_url);
+            }
+
+            return response;
+        }
     );
-    mutableQuestion->set_text(std::move(createdQuestion.text));
-    if (!createdQuestion.image_url.empty()) {
-        mutableQuestion->set_image_url(createdQuestion.image_url);
-    }
+}
 
-    return response;
+auto Service::CreateQuestionWithVariants(
+    CallContext& context,
+    handlers::api::CreateQuestionWithVariantsRequest&& request
+) -> Service::CreateQuestionWithVariantsResult {
+    return Call<CreateQuestionWithVariantsResult>(
+        context, "CreateQuestionWithVariants", RequestClass::kWrite,
+        [&](Deadline deadline) -> CreateQuestionWithVariantsResult {
+            if (request.text().empty()) {
+                return grpc::Status{
+                    grpc::StatusCode::INVALID_ARGUMENT,
+                    "Question text cannot be empty"
+                };
+            }
+
+            const auto pack_id = ParseUuid(request.pack_id());
+
+            std::vector<Models::VariantDraft> drafts;
+            drafts.reserve(request.variants_size());
+            for (auto& variant : *request.mutable_variants()) {
+                if (variant.text().empty()) {
+                    return grpc::Status{
+                        grpc::StatusCode::INVALID_ARGUMENT,
+                        "Variant text cannot be empty"
+                    };
+                }
+                drafts.push_back(
+                    {std::move(*variant.mutable_text()), variant.is_correct()}
+                );
+            }
+
+            auto createdOpt =
+                Traced("storage.CreateQuestionWithVariants", [&] {
+                    return NStorage::CreateQuestionWithVariants(
+                        shards_, pack_id, request.text(),
+                        request.image_url(), drafts, deadline
+                    );
+                });
+
+            if (!createdOpt.has_value()) {
+                return grpc::Status{
+                    grpc::StatusCode::INTERNAL, "Failed to create question"
+                };
+            }
+            auto& [createdQuestion, createdVariants] = createdOpt.value();
+
+            handlers::api::CreateQuestionWithVariantsResponse response;
+            auto* mutableQuestion = response.mutable_question();
+            mutableQuestion->set_id(
+                boost::uuids::to_string(createdQuestion.id)
+            );
+            mutableQuestion->set_pack_id(
+                boost::uuids::to_string(createdQuestion.pack_id)
+            );
+            mutableQuestion->set_text(std::move(createdQuestion.text));
+            if (!createdQuestion.image_url.empty()) {
+                mutableQuestion->set_image_url(
+                    std::move(createdQuestion.image_url)
+                );
+            }
+
+            auto* mutableVariants = response.mutable_variants();
+            for (auto&& variant : createdVariants) {
+                auto* newVariant = mutableVariants->Add();
+                newVariant->set_id(boost::uuids::to_string(variant.id));
+                newVariant->set_question_id(
+                    boost::uuids::to_string(variant.question_id)
+                );
+                newVariant->set_text(std::move(variant.text));
+                newVariant->set_is_correct(variant.is_correct);
+            }
+
+            return response;
+        }
+    );
 }
 
 auto Service::GetQuestionById(
-    CallContext& /*context*/, handlers::api::GetQuestionByIdRequest&& request
+    CallContext& context, handlers::api::GetQuestionByIdRequest&& request
 ) -> Service::GetQuestionByIdResult {
-    auto question_id = Utils::StringToUuid(request.id());
-    if (question_id.is_nil()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT,
-            "Invalid UUID format: " + request.id()
-        };
-    }
-    auto questionOpt = NStorage::GetQuestionById(pg_cluster_, question_id);
-
-    if (!questionOpt.has_value()) {
-        return grpc::Status{grpc::StatusCode::NOT_FOUND, "Question not found"};
-    }
-    auto question = questionOpt.value();
-
-    handlers::api::GetQuestionByIdResponse response;
-    auto* mutableQuestion = response.mutable_question();
-    mutableQuestion->set_id(boost::uuids::to_string(question.id));
-    mutableQuestion->set_pack_id(boost::uuids::to_string(question.pack_id));
-    mutableQuestion->set_text(std::move(question.text));
-    if (!question.image_url.empty()) {
-        mutableQuestion->set_image_url(std::move(question.image_url));
-    }
-
-    return response;
+    return Call<GetQuestionByIdResult>(
+        context, "GetQuestionById", RequestClass::kRead,
+        [&](Deadline deadline) -> GetQuestionByIdResult {
+            const auto question_id = ParseUuid(request.id());
+            auto questionOpt = Traced("storage.GetQuestionById", [&] {
+                return NStorage::GetQuestionById(
+                    shards_, question_id, deadline
+                );
+            });
+
+            if (!questionOpt.has_value()) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Question not found"
+                };
+            }
+            auto question = questionOpt.value();
+
+            handlers::api::GetQuestionByIdResponse response;
+            auto* mutableQuestion = response.mutable_question();
+            mutableQuestion->set_id(boost::uuids::to_string(question.id));
+            mutableQuestion->set_pack_id(
+                boost::uuids::to_string(question.pack_id)
+            );
+            mutableQuestion->set_text(std::move(question.text));
+            if (!question.image_url.empty()) {
+                mutableQuestion->set_image_url(std::move(question.image_url));
+            }
+
+            return response;
+        }
+    );
 }
 
 auto Service::GetQuestionsByPackId(
-    CallContext& /*context*/,
+    CallContext& context,
     handlers::api::GetQuestionsByPackIdRequest&& request
 ) -> Service::GetQuestionsByPackIdResult {
-    auto pack_id = Utils::StringToUuid(request.pack_id());
-    if (pack_id.is_nil()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT,
-            "Invalid UUID format: " + request.pack_id()
-        };
-    }
-    auto questions = NStorage::GetQuestionsByPackId(pg_cluster_, pack_id);
-
-    handlers::api::GetQuestionsByPackIdResponse response;
-    auto* mutableQuestions = response.mutable_questions();
-
-    for (auto&& question : questions) {
-        auto* newQuestion = mutableQuestions->Add();
-        newQuestion->set_id(boost::uuids::to_string(question.id));
-        newQuestion->set_pack_id(boost::uuids::to_string(question.pack_id));
-        newQuestion->set_text(std::move(question.text));
-        if (!question.image_url.empty()) {
-            newQuestion->set_image_url(std::move(question.image_url));
+    return Call<GetQuestionsByPackIdResult>(
+        context, "GetQuestionsByPackId", RequestClass::kRead,
+        [&](Deadline deadline) -> GetQuestionsByPackIdResult {
+            const auto pack_id = ParseUuid(request.pack_id());
+            return OnBulk("bulk.GetQuestionsByPackId", [&] {
+                auto questions = Traced("storage.GetQuestionsByPackId", [&] {
+                    return NStorage::GetQuestionsByPackId(
+                        shards_, pack_id, deadline
+                    );
+                });
+
+                handlers::api::GetQuestionsByPackIdResponse response;
+                auto* mutableQuestions = response.mutable_questions();
+
+                Traced("serialize.Questions", [&] {
+                    for (auto&& question : questions) {
+                        auto* newQuestion = mutableQuestions->Add();
+                        newQuestion->set_id(
+                            boost::uuids::to_string(question.id)
+                        );
+                        newQuestion->set_pack_id(
+                            boost::uuids::to_string(question.pack_id)
+                        );
+                        newQuestion->set_text(std::move(question.text));
+                        if (!question.image_url.empty()) {
+                            newQuestion->set_image_url(
+                                std::move(question.image_url)
+                            );
+                        }
+                    }
+                });
+
+                return response;
+            });
         }
-    }
-
-    return response;
+    );
 }
 
 auto Service::CreateVariant(
-    CallContext& /*context*/, handlers::api::CreateVariantRequest&& request
+    CallContext& context, handlers::api::CreateVariantRequest&& request
 ) -> Service::CreateVariantResult {
-    if (request.text().empty()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT, "Variant text cannot be empty"
-        };
-    }
-
-    auto question_id = Utils::StringToUuid(request.question_id());
-    if (question_id.is_nil()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT,
-            "Invalid UUID format: " + request.question_id()
-        };
-    }
-    auto createdVariantOpt = NStorage::CreateVariant(
-        pg_cluster_, question_id, request.text(), request.is_correct()
-    );
-
-    if (!createdVariantOpt.has_value()) {
-        return grpc::Status{
-            grpc::StatusCode::INTERNAL, "Failed to create variant"
-        };
-    }
-    auto createdVariant = createdVariantOpt.value();
-
-    handlers::api::CreateVariantResponse response;
-    auto* mutableVariant = response.mutable_variant();
-    mutableVariant->set_id(boost::uuids::to_string(createdVariant.id));
-    mutableVariant->set_question_id(
-        boost::uuids::to_string(createdVariant.question_id)
+    return Call<CreateVariantResult>(
+        context, "CreateVariant", RequestClass::kWrite,
+        [&](Deadline deadline) -> CreateVariantResult {
+            if (request.text().empty()) {
+                return grpc::Status{
+                    grpc::StatusCode::INVALID_ARGUMENT,
+                    "Variant text cannot be empty"
+                };
+            }
+
+            const auto question_id = ParseUuid(request.question_id());
+            auto createdVariantOpt = Traced("storage.CreateVariant", [&] {
+                return NStorage::CreateVariant(
+                    shards_, question_id, request.text(),
+                    request.is_correct(), deadline
+                );
+            });
+
+            if (!createdVariantOpt.has_value()) {
+                return grpc::Status{
+                    grpc::StatusCode::INTERNAL, "Failed to create variant"
+                };
+            }
+            auto createdVariant = createdVariantOpt.value();
+
+            handlers::api::CreateVariantResponse response;
+            auto* mutableVariant = response.mutable_variant();
+            mutableVariant->set_id(boost::uuids::to_string(createdVariant.id));
+            mutableVariant->set_question_id(
+                boost::uuids::to_string(createdVariant.question_id)
+            );
+            mutableVariant->set_text(std::move(createdVariant.text));
+            mutableVariant->set_is_correct(createdVariant.is_correct);
+
+            return response;
+        }
     );
-    mutableVariant->set_text(std::move(createdVariant.text));
-    mutableVariant->set_is_correct(createdVariant.is_correct);
-
-    return response;
 }
 
 auto Service::GetVariantById(
-    CallContext& /*context*/, handlers::api::GetVariantByIdRequest&& request
+    CallContext& context, handlers::api::GetVariantByIdRequest&& request
 ) -> Service::GetVariantByIdResult {
-    auto variant_id = Utils::StringToUuid(request.id());
-    if (variant_id.is_nil()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT,
-            "Invalid UUID format: " + request.id()
-        };
-    }
-    auto variantOpt = NStorage::GetVariantById(pg_cluster_, variant_id);
-
-    if (!variantOpt.has_value()) {
-        return grpc::Status{grpc::StatusCode::NOT_FOUND, "Variant not found"};
-    }
-    auto variant = variantOpt.value();
-
-    handlers::api::GetVariantByIdResponse response;
-    auto* mutableVariant = response.mutable_variant();
-    mutableVariant->set_id(boost::uuids::to_string(variant.id));
-    mutableVariant->set_question_id(
-        boost::uuids::to_string(variant.question_id)
+    return Call<GetVariantByIdResult>(
+        context, "GetVariantById", RequestClass::kRead,
+        [&](Deadline deadline) -> GetVariantByIdResult {
+            const auto variant_id = ParseUuid(request.id());
+            auto variantOpt = Traced("storage.GetVariantById", [&] {
+                return NStorage::GetVariantById(shards_, variant_id, deadline);
+            });
+
+            if (!variantOpt.has_value()) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Variant not found"
+                };
+            }
+            auto variant = variantOpt.value();
+
+            handlers::api::GetVariantByIdResponse response;
+            auto* mutableVariant = response.mutable_variant();
+            mutableVariant->set_id(boost::uuids::to_string(variant.id));
+            mutableVariant->set_question_id(
+                boost::uuids::to_string(variant.question_id)
+            );
+            mutableVariant->set_text(std::move(variant.text));
+            mutableVariant->set_is_correct(variant.is_correct);
+
+            return response;
+        }
     );
-    mutableVariant->set_text(std::move(variant.text));
-    mutableVariant->set_is_correct(variant.is_correct);
-
-    return response;
 }
 
 auto Service::GetVariantsByQuestionId(
-    CallContext& /*context*/,
+    CallContext& context,
     handlers::api::GetVariantsByQuestionIdRequest&& request
 ) -> Service::GetVariantsByQuestionIdResult {
-    auto question_id = Utils::StringToUuid(request.question_id());
-    if (question_id.is_nil()) {
-        return grpc::Status{
-            grpc::StatusCode::INVALID_ARGUMENT,
-            "Invalid UUID format: " + request.question_id()
-        };
-    }
-    auto variants = NStorage::GetVariantsByQuestionId(pg_cluster_, question_id);
+    return Call<GetVariantsByQuestionIdResult>(
+        context, "GetVariantsByQuestionId", RequestClass::kRead,
+        [&](Deadline deadline) -> GetVariantsByQuestionIdResult {
+            const auto question_id = ParseUuid(request.question_id());
+            return OnBulk("bulk.GetVariantsByQuestionId", [&] {
+                auto variants = Traced("storage.GetVariantsByQuestionId", [&] {
+                    return NStorage::GetVariantsByQuestionId(
+                        shards_, question_id, deadline
+                    );
+                });
+
+                handlers::api::GetVariantsByQuestionIdResponse response;
+                auto* mutableVariants = response.mutable_variants();
+
+                Traced("serialize.Variants", [&] {
+                    for (auto&& variant : variants) {
+                        auto* newVariant = mutableVariants->Add();
+                        newVariant->set_id(boost::uuids::to_string(variant.id));
+                        newVariant->set_question_id(
+                            boost::uuids::to_string(variant.question_id)
+                        );
+                        newVariant->set_text(std::move(variant.text));
+                        newVariant->set_is_correct(variant.is_correct);
+                    }
+                });
+
+                return response;
+            });
+        }
+    );
+}
 
-    handlers::api::GetVariantsByQuestionIdResponse response;
-    auto* mutableVariants = response.mutable_variants();
+auto Service::SubmitAnswer(
+    CallContext& context, handlers::api::SubmitAnswerRequest&& request
+) -> Service::SubmitAnswerResult {
+    return Call<SubmitAnswerResult>(
+        context, "SubmitAnswer", RequestClass::kWrite,
+        [&](Deadline deadline) -> SubmitAnswerResult {
+            if (request.player_id().empty()) {
+                return grpc::Status{
+                    grpc::StatusCode::INVALID_ARGUMENT,
+                    "Player id cannot be empty"
+                };
+            }
+            const auto variant_id = ParseUuid(request.variant_id());
+
+            // With a published version at hand the answer is checked
+            // against the cached copy instead of the database
+            std::optional<Models::AnswerKey> answerKey;
+            if (request.pack_ref().empty()) {
+                answerKey = Traced("storage.CheckAnswer", [&] {
+                    return NStorage::CheckAnswer(shards_, variant_id, deadline);
+                });
+            } else {
+                const auto ref =
+                    Models::ParsePackVersionRef(request.pack_ref());
+                if (!ref) {
+                    return grpc::Status{
+                        grpc::StatusCode::INVALID_ARGUMENT,
+                        "Invalid pack version reference: " +
+                            request.pack_ref()
+                    };
+                }
+                const auto pack_version =
+                    Traced("storage.GetPackVersion", [&] {
+                        return NStorage::GetPackVersion(
+                            shards_, *ref, deadline
+                        );
+                    });
+                if (!pack_version) {
+                    return grpc::Status{
+                        grpc::StatusCode::NOT_FOUND, "Pack version not found"
+                    };
+                }
+                answerKey = pack_version->FindAnswer(variant_id);
+            }
+            if (!answerKey) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Variant not found"
+                };
+            }
+
+            analytics_.Record(
+                {answerKey->pack_id, answerKey->question_id, variant_id,
+                 answerKey->is_correct, request.player_id()}
+            );
+
+            handlers::api::SubmitAnswerResponse response;
+            response.set_is_correct(answerKey->is_correct);
+            return response;
+        }
+    );
+}
 
-    for (auto&& variant : variants) {
-        auto* newVariant = mutableVariants->Add();
-        newVariant->set_id(boost::uuids::to_string(variant.id));
-        newVariant->set_question_id(
-            boost::uuids::to_string(variant.question_id)
-        );
-        newVariant->set_text(std::move(variant.text));
-        newVariant->set_is_correct(variant.is_correct);
-    }
+auto Service::GetQuestionStats(
+    CallContext& context, handlers::api::GetQuestionStatsRequest&& request
+) -> Service::GetQuestionStatsResult {
+    return Call<GetQuestionStatsResult>(
+        context, "GetQuestionStats", RequestClass::kRead,
+        [&](Deadline deadline) -> GetQuestionStatsResult {
+            const auto question_id = ParseUuid(request.question_id());
+            auto statsOpt = Traced("storage.GetQuestionStats", [&] {
+                return NStorage::GetQuestionStats(
+                    shards_, question_id, deadline
+                );
+            });
+            if (!statsOpt) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Question not found"
+                };
+            }
+
+            handlers::api::GetQuestionStatsResponse response;
+            response.set_question_id(
+                boost::uuids::to_string(statsOpt->question_id)
+            );
+            response.set_attempts(statsOpt->attempts);
+            response.set_correct(statsOpt->correct);
+            response.set_unique_players(statsOpt->unique_players);
+            for (const auto& variant : statsOpt->variants) {
+                auto* newVariant = response.add_variants();
+                newVariant->set_variant_id(
+                    boost::uuids::to_string(variant.variant_id)
+                );
+                newVariant->set_picks(variant.picks);
+                if (statsOpt->attempts != 0) {
+                    newVariant->set_pick_rate(
+                        static_cast<double>(variant.picks) /
+                        static_cast<double>(statsOpt->attempts)
+                    );
+                }
+            }
+            return response;
+        }
+    );
+}
+
+auto Service::GetPackStats(
+    CallContext& context, handlers::api::GetPackStatsRequest&& request
+) -> Service::GetPackStatsResult {
+    return Call<GetPackStatsResult>(
+        context, "GetPackStats", RequestClass::kRead,
+        [&](Deadline deadline) -> GetPackStatsResult {
+            const auto pack_id = ParseUuid(request.pack_id());
+            auto statsOpt = Traced("storage.GetPackStats", [&] {
+                return NStorage::GetPackStats(shards_, pack_id, deadline);
+            });
+            if (!statsOpt) {
+                return grpc::Status{
+                    grpc::StatusCode::NOT_FOUND, "Pack not found"
+                };
+            }
+
+            handlers::api::GetPackStatsResponse response;
+            response.set_pack_id(boost::uuids::to_string(statsOpt->pack_id));
+            response.set_answers(statsOpt->answers);
+            response.set_unique_players(statsOpt->unique_players);
+            return response;
+        }
+    );
+}
 
-    return response;
+auto Service::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<
+        handlers::api::QuizServiceBase::Component>(R"(
+type: object
+description: quiz gRPC service
+additionalProperties: false
+properties:
+    bulk-task-processor:
+        type: string
+        description: |
+            task processor list RPCs run on, bulk-task-processor by default
+)");
 }
 
 } // namespace game_userver
@@ -3,9 +3,23 @@
 #include <handlers/cruds.pb.h> // for responce
 
 #include <handlers/cruds_service.usrv.pb.hpp>
+#include <memory>
 #include <models/pack.hpp> // for responce
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <userver/components/component.hpp>
-#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/yaml_config/fwd.hpp>
+#include <utility>
+
+#include "components/answer_analytics/answer_analytics.hpp"
+#include "components/load_shedding/load_shedding.hpp"
+#include "components/rate_limiting/rate_limiting.hpp"
+#include "components/trace_export/trace_export.hpp"
+#include "storage/shard_router.hpp"
 
 namespace game_userver {
 
@@ -32,11 +46,35 @@ public:
         handlers::api::GetAllPacksRequest&& /*request*/
     ) -> GetAllPacksResult override;
 
+    auto UpdatePackTitle(
+        CallContext& /*context*/,
+        handlers::api::UpdatePackTitleRequest&& /*request*/
+    ) -> UpdatePackTitleResult override;
+
+    auto DeletePack(
+        CallContext& /*context*/, handlers::api::DeletePackRequest&& /*request*/
+    ) -> DeletePackResult override;
+
+    auto PublishPack(
+        CallContext& /*context*/,
+        handlers::api::PublishPackRequest&& /*request*/
+    ) -> PublishPackResult override;
+
+    auto GetPackVersion(
+        CallContext& /*context*/,
+        handlers::api::GetPackVersionRequest&& /*request*/
+    ) -> GetPackVersionResult override;
+
     auto CreateQuestion(
         CallContext& /*context*/, handlers::api::CreateQuestionRequest&&
         /*request*/
     ) -> CreateQuestionResult override;
 
+    auto CreateQuestionWithVariants(
+        CallContext& /*context*/,
+        handlers::api::CreateQuestionWithVariantsRequest&& /*request*/
+    ) -> CreateQuestionWithVariantsResult override;
+
     auto GetQuestionById(
         CallContext& /*context*/, handlers::api::GetQuestionByIdRequest&&
         /*request*/
@@ -64,8 +102,74 @@ public:
         /*request*/
     ) -> GetVariantsByQuestionIdResult override;
 
+    // === Answer analytics ===
+    auto SubmitAnswer(
+        CallContext& /*context*/,
+        handlers::api::SubmitAnswerRequest&& /*request*/
+    ) -> SubmitAnswerResult override;
+
+    auto GetQuestionStats(
+        CallContext& /*context*/,
+        handlers::api::GetQuestionStatsRequest&& /*request*/
+    ) -> GetQuestionStatsResult override;
+
+    auto GetPackStats(
+        CallContext& /*context*/,
+        handlers::api::GetPackStatsRequest&& /*request*/
+    ) -> GetPackStatsResult override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
 private:
-    userver::storages::postgres::ClusterPtr pg_cluster_;
+    // Checks the rate limit of the caller, then the method and class
+    // concurrency limits
+    auto Admit(
+        CallContext& context, std::string_view method,
+        RequestClass request_class
+    ) const -> std::optional<LoadShedding::Admission>;
+
+    // One call of `method`: its span, the limits of Admit and the deadline
+    // of the caller, which `func(deadline)` gets to build the result.
+    // Running out of the deadline inside it ends the call with
+    // DEADLINE_EXCEEDED instead of an unknown error.
+    template <typename Result, typename Func>
+    auto Call(
+        CallContext& context, std::string_view method,
+        RequestClass request_class, Func&& func
+    ) const -> Result;
+
+    // Runs `func` in a span exported by TraceExport, a child of the span of
+    // the method
+    template <typename Func>
+    auto Traced(std::string name, Func&& func) const {
+        const auto span = trace_export_.StartSpan(std::move(name));
+        return std::forward<Func>(func)();
+    }
+
+    // Runs `func` on the bulk task processor and waits for it, so list RPCs
+    // queue behind each other instead of in front of gameplay calls
+    template <typename Func>
+    auto OnBulk(std::string name, Func&& func) const {
+        return userver::utils::Async(
+                   bulk_task_processor_, std::move(name),
+                   std::forward<Func>(func)
+        )
+            .Get();
+    }
+
+    const NStorage::ShardRouter& shards_;
+    const LoadShedding& load_shedding_;
+    const RateLimiting& rate_limiting_;
+    AnswerAnalytics& analytics_;
+    TraceExport& trace_export_;
+    userver::engine::TaskProcessor& bulk_task_processor_;
+    std::unordered_map<
+        std::string_view, std::unique_ptr<Utils::AdaptiveLimiter>>
+        method_limiters_;
 };
 
 } // namespace game_userver
+
+template <>
+inline constexpr bool
+    userver::components::kHasValidate<game_userver::Service> = true;
@@ -0,0 +1,18 @@
+#include "component_list.hpp"
+
+#include "get_session.hpp"
+#include "next_question.hpp"
+#include "room.hpp"
+#include "start_session.hpp"
+
+namespace game_userver {
+
+auto GetLiveComponentList() -> userver::components::ComponentList {
+    return userver::components::ComponentList()
+        .Append<StartLiveSession>()
+        .Append<GetLiveSession>()
+        .Append<NextLiveQuestion>()
+        .Append<LiveRoom>();
+}
+
+} // namespace game_userver
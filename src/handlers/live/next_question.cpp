@@ -0,0 +1,52 @@
+#include "next_question.hpp"
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/serialize.hpp>
+
+#include "components/live_session_router/live_session_router.hpp"
+#include "utils/deadline.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+struct NextLiveQuestion::Impl {
+    const LiveSessionRouter& router;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : router(context.FindComponent<LiveSessionRouter>()) {}
+};
+
+NextLiveQuestion::NextLiveQuestion(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+NextLiveQuestion::~NextLiveQuestion() = default;
+
+auto NextLiveQuestion::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    const auto sessionId = Utils::StringToUuid(request.GetArg("id"));
+    if (sessionId.is_nil()) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect id";
+    }
+
+    const auto session = impl_->router.NextQuestion(
+        sessionId, Utils::DeadlineFromHttp(request)
+    );
+    if (!session) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Session not found";
+    }
+    return userver::formats::json::ToPrettyString(*session);
+}
+
+} // namespace game_userver
@@ -0,0 +1,115 @@
+#include "room.hpp"
+
+#include <boost/uuid/uuid.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+#include "components/live_rooms/live_rooms.hpp"
+#include "components/live_session_router/live_session_router.hpp"
+#include "components/live_sessions/live_sessions.hpp"
+#include "models/live_room.hpp"
+#include "utils/string_to_uuid.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr std::string_view kSessionIdData = "live_room_session_id";
+
+} // namespace
+
+struct LiveRoom::Impl {
+    const LiveSessionRouter& router;
+    LiveSessions& sessions;
+    LiveRooms& rooms;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : router(context.FindComponent<LiveSessionRouter>()),
+          sessions(context.FindComponent<LiveSessions>()),
+          rooms(context.FindComponent<LiveRooms>()) {}
+};
+
+LiveRoom::LiveRoom(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : WebsocketHandlerBase(config, component_context),
+      impl_(component_context) {}
+
+LiveRoom::~LiveRoom() = default;
+
+auto LiveRoom::HandleHandshake(
+    const userver::server::http::HttpRequest& request,
+    userver::server::http::HttpResponse& response,
+    userver::server::request::RequestContext& context
+) const -> bool {
+    const auto sessionId = Utils::StringToUuid(request.GetArg("id"));
+    if (sessionId.is_nil()) {
+        response.SetStatus(userver::server::http::HttpStatus::kBadRequest);
+        return false;
+    }
+    if (const auto* owner = impl_->router.FindRemoteOwnerName(sessionId)) {
+        response.SetStatus(
+            userver::server::http::HttpStatus::kMisdirectedRequest
+        );
+        response.SetHeader(std::string{kOwnerHeader}, *owner);
+        return false;
+    }
+    if (!impl_->sessions.Get(sessionId)) {
+        response.SetStatus(userver::server::http::HttpStatus::kNotFound);
+        return false;
+    }
+
+    context.SetData(std::string{kSessionIdData}, sessionId);
+    return true;
+}
+
+void LiveRoom::Handle(
+    userver::server::websocket::WebSocketConnection& websocket,
+    userver::server::request::RequestContext& context
+) const {
+    using userver::server::websocket::CloseStatus;
+
+    const auto sessionId =
+        context.GetData<boost::uuids::uuid>(std::string{kSessionIdData});
+
+    const auto participant = impl_->rooms.Join(sessionId);
+    if (!participant) {
+        websocket.Close(CloseStatus::kGoingAway);
+        return;
+    }
+
+    // Commands are read by a subtask while this one writes the broadcasts
+    auto reader = userver::utils::Async("live-room-reader", [&] {
+        const userver::utils::ScopeGuard leave{[&] { participant->Leave(); }};
+        userver::server::websocket::Message message;
+        while (true) {
+            websocket.Recv(message);
+            if (message.close_status) {
+                return *message.close_status;
+            }
+            const auto command = Models::ParseRoomCommand(message.data);
+            if (command) {
+                participant->Answer(command->variant_id);
+            }
+        }
+    });
+
+    LiveRooms::Message message;
+    while (!reader.IsFinished() && participant->Pop(message)) {
+        // The buffer is shared by the whole room
+        websocket.SendText(*message);
+    }
+
+    if (reader.IsFinished()) {
+        // Rethrows if the connection broke
+        websocket.Close(reader.Get());
+        return;
+    }
+    // The room closed or this participant fell behind
+    websocket.Close(CloseStatus::kGoingAway);
+    reader.SyncCancel();
+}
+
+} // namespace game_userver
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string_view>
+#include <userver/components/component_fwd.hpp>
+#include <userver/server/websocket/websocket_handler.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+namespace game_userver {
+
+// WebSocket of a live room, `id` names the session. Players only answer over
+// it, the host skips questions with /live/next-question. A WebSocket is not
+// forwarded: for a session LiveSessionRouter places elsewhere the handshake
+// fails with 421 and kOwnerHeader names the instance to connect to. See
+// Models::ParseRoomCommand for the messages and LiveRooms for the fan-out.
+class LiveRoom final
+    : public userver::server::websocket::WebsocketHandlerBase {
+public:
+    static constexpr std::string_view kName = "handler-live-room";
+    static constexpr std::string_view kOwnerHeader = "X-Live-Session-Owner";
+
+    LiveRoom(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+    ~LiveRoom() override;
+
+    auto HandleHandshake(
+        const userver::server::http::HttpRequest& /*request*/,
+        userver::server::http::HttpResponse& /*response*/,
+        userver::server::request::RequestContext& /*context*/
+    ) const -> bool override;
+
+    void Handle(
+        userver::server::websocket::WebSocketConnection& /*websocket*/,
+        userver::server::request::RequestContext& /*context*/
+    ) const override;
+
+private:
+    struct Impl;
+    static constexpr size_t kSize = 24;
+    static constexpr size_t kAlignment = 8;
+    userver::utils::FastPimpl<Impl, kSize, kAlignment> impl_;
+};
+
+} // namespace game_userver
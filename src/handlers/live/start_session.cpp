@@ -0,0 +1,82 @@
+#include "start_session.hpp"
+
+#include <chrono>
+#include <optional>
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/serialize.hpp>
+
+#include "components/live_session_router/live_session_router.hpp"
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "handlers/admin/admin_args.hpp"
+#include "storage/pack_versions.hpp"
+#include "utils/deadline.hpp"
+
+namespace game_userver {
+
+namespace {
+
+constexpr int kMaxRoundSeconds = 600;
+
+} // namespace
+
+struct StartLiveSession::Impl {
+    const NStorage::ShardRouter& shards;
+    const LiveSessionRouter& router;
+
+    explicit Impl(const userver::components::ComponentContext& context)
+        : shards(context.FindComponent<ShardedStorage>().GetRouter()),
+          router(context.FindComponent<LiveSessionRouter>()) {}
+};
+
+StartLiveSession::StartLiveSession(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context), impl_(component_context) {}
+
+StartLiveSession::~StartLiveSession() = default;
+
+auto StartLiveSession::HandleRequestThrow(
+    const userver::server::http::HttpRequest& request,
+    userver::server::request::RequestContext&
+    /*context*/
+) const -> std::string {
+    const auto ref = Models::ParsePackVersionRef(request.GetArg("ref"));
+    std::optional<std::chrono::milliseconds> roundDuration;
+    if (request.HasArg("round_seconds")) {
+        const auto seconds = admin::ParseIntArg(
+            request.GetArg("round_seconds"), 0, 1, kMaxRoundSeconds
+        );
+        if (seconds) {
+            roundDuration = std::chrono::seconds{*seconds};
+        }
+    }
+    if (!ref || (request.HasArg("round_seconds") && !roundDuration)) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Incorrect ref or round_seconds";
+    }
+
+    const auto packVersion = NStorage::GetPackVersion(
+        impl_->shards, *ref, Utils::DeadlineFromHttp(request)
+    );
+    if (!packVersion) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kNotFound
+        );
+        return "Pack version not found";
+    }
+    if (packVersion->GetQuestionCount() == 0) {
+        request.GetHttpResponse().SetStatus(
+            userver::server::http::HttpStatus::kBadRequest
+        );
+        return "Pack version has no questions";
+    }
+
+    return userver::formats::json::ToPrettyString(impl_->router.Start(
+        packVersion, roundDuration, Utils::DeadlineFromHttp(request)
+    ));
+}
+
+} // namespace game_userver
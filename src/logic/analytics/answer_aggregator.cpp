@@ -0,0 +1,131 @@
+#include "answer_aggregator.hpp"
+
+namespace game_userver {
+
+template <typename Entry>
+template <typename Func>
+void AnswerAggregator::Entries<Entry>::Update(
+    const boost::uuids::uuid& id, Func func
+) {
+    auto& shard = GetShard(id);
+    const std::lock_guard lock{shard.mutex};
+    func(shard.entries[id]);
+}
+
+template <typename Entry>
+template <typename Func>
+void AnswerAggregator::Entries<Entry>::ForEach(Func func) const {
+    for (std::size_t i = 0; i < kShards; ++i) {
+        const auto& shard = shards_[i];
+        const std::lock_guard lock{shard.mutex};
+        for (const auto& [id, entry] : shard.entries) {
+            func(id, entry);
+        }
+    }
+}
+
+template <typename Entry>
+template <typename Func>
+void AnswerAggregator::Entries<Entry>::Commit(
+    const boost::uuids::uuid& id, Func func
+) {
+    auto& shard = GetShard(id);
+    const std::lock_guard lock{shard.mutex};
+    const auto it = shard.entries.find(id);
+    if (it != shard.entries.end() && func(it->second)) {
+        shard.entries.erase(it);
+    }
+}
+
+template <typename Entry>
+auto AnswerAggregator::Entries<Entry>::GetSize() const -> std::size_t {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < kShards; ++i) {
+        const std::lock_guard lock{shards_[i].mutex};
+        size += shards_[i].entries.size();
+    }
+    return size;
+}
+
+template <typename Entry>
+auto AnswerAggregator::Entries<Entry>::GetShard(const boost::uuids::uuid& id)
+    -> Shard& {
+    return shards_[boost::hash<boost::uuids::uuid>{}(id) % kShards];
+}
+
+void AnswerAggregator::Record(const Answer& answer) {
+    packs_.Update(answer.pack_id, [&](PackEntry& pack) {
+        ++pack.answers;
+        pack.players.Add(answer.player_id);
+    });
+
+    questions_.Update(answer.question_id, [&](QuestionEntry& question) {
+        ++question.attempts;
+        if (answer.is_correct) {
+            ++question.correct;
+        }
+        question.players.Add(answer.player_id);
+    });
+
+    variants_.Update(answer.variant_id, [](VariantEntry& variant) {
+        ++variant.picks;
+    });
+}
+
+auto AnswerAggregator::CollectDelta() const -> Models::AnswerStatsDelta {
+    Models::AnswerStatsDelta delta;
+
+    packs_.ForEach([&](const auto& pack_id, const PackEntry& pack) {
+        if (pack.answers > 0) {
+            delta.packs.push_back(
+                {pack_id, pack.answers, pack.players.Serialize()}
+            );
+        }
+    });
+
+    questions_.ForEach([&](const auto& question_id,
+                           const QuestionEntry& question) {
+        if (question.attempts > 0) {
+            delta.questions.push_back(
+                {question_id, question.attempts, question.correct,
+                 question.players.Serialize()}
+            );
+        }
+    });
+
+    variants_.ForEach([&](const auto& variant_id, const VariantEntry& variant) {
+        if (variant.picks > 0) {
+            delta.variants.push_back({variant_id, variant.picks});
+        }
+    });
+
+    return delta;
+}
+
+void AnswerAggregator::CommitDelta(const Models::AnswerStatsDelta& delta) {
+    for (const auto& pack : delta.packs) {
+        packs_.Commit(pack.pack_id, [&](PackEntry& entry) {
+            entry.answers -= pack.answers;
+            return entry.answers == 0;
+        });
+    }
+    for (const auto& question : delta.questions) {
+        questions_.Commit(question.question_id, [&](QuestionEntry& entry) {
+            entry.attempts -= question.attempts;
+            entry.correct -= question.correct;
+            return entry.attempts == 0;
+        });
+    }
+    for (const auto& variant : delta.variants) {
+        variants_.Commit(variant.variant_id, [&](VariantEntry& entry) {
+            entry.picks -= variant.picks;
+            return entry.picks == 0;
+        });
+    }
+}
+
+auto AnswerAggregator::GetSize() const -> std::size_t {
+    return packs_.GetSize() + questions_.GetSize() + variants_.GetSize();
+}
+
+} // namespace game_userver
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "models/answer_stats.hpp"
+#include "utils/hyper_log_log.hpp"
+
+namespace game_userver {
+
+// In-process aggregation of submitted answers: answers per pack, attempts and
+// correct answers per question, picks per variant and unique players of
+// packs and questions.
+//
+// Entries live in lock-striped shards chosen by the id hash, so recording is
+// a hash and three short critical sections that never suspend, and answers
+// to different packs rarely touch the same mutex. Every flush
+// CollectDelta() reads what was recorded since the last CommitDelta(); if
+// saving the delta fails it is simply collected again next time. Once a
+// delta is committed, entries with nothing new since are dropped, so memory
+// is proportional to the ids answered within one flush interval.
+class AnswerAggregator final {
+public:
+    struct Answer final {
+        boost::uuids::uuid pack_id;
+        boost::uuids::uuid question_id;
+        boost::uuids::uuid variant_id;
+        bool is_correct = false;
+        std::string_view player_id;
+    };
+
+    // The ids must have been checked to exist, every one gets an entry
+    void Record(const Answer& answer);
+
+    [[nodiscard]] auto CollectDelta() const -> Models::AnswerStatsDelta;
+    // Must be called with a delta from CollectDelta() once it is saved
+    void CommitDelta(const Models::AnswerStatsDelta& delta);
+
+    // Number of packs, questions and variants with an entry, for tests
+    [[nodiscard]] auto GetSize() const -> std::size_t;
+
+private:
+    // Counts are what was recorded and not committed yet. A sketch lives as
+    // long as its entry, saving it again is harmless.
+    struct PackEntry final {
+        std::int64_t answers = 0;
+        Utils::HyperLogLog players;
+    };
+
+    struct QuestionEntry final {
+        std::int64_t attempts = 0;
+        std::int64_t correct = 0;
+        Utils::HyperLogLog players;
+    };
+
+    struct VariantEntry final {
+        std::int64_t picks = 0;
+    };
+
+    template <typename Entry>
+    class Entries final {
+    public:
+        // Calls `func` with the entry of `id`, creating it if needed
+        template <typename Func>
+        void Update(const boost::uuids::uuid& id, Func func);
+
+        // Calls `func` with every entry, one shard locked at a time
+        template <typename Func>
+        void ForEach(Func func) const;
+
+        // Calls `func` with the entry of `id`, if any, and drops the entry
+        // if `func` returns true
+        template <typename Func>
+        void Commit(const boost::uuids::uuid& id, Func func);
+
+        [[nodiscard]] auto GetSize() const -> std::size_t;
+
+    private:
+        static constexpr std::size_t kShards = 64;
+
+        // Aligned to keep neighbouring mutexes off each other's cache lines
+        struct alignas(64) Shard final {
+            mutable std::mutex mutex;
+            // Nodes never move, sketches are not movable
+            std::unordered_map<
+                boost::uuids::uuid, Entry, boost::hash<boost::uuids::uuid>>
+                entries;
+        };
+
+        auto GetShard(const boost::uuids::uuid& id) -> Shard&;
+
+        std::unique_ptr<Shard[]> shards_ = std::make_unique<Shard[]>(kShards);
+    };
+
+    Entries<PackEntry> packs_;
+    Entries<QuestionEntry> questions_;
+    Entries<VariantEntry> variants_;
+};
+
+} // namespace game_userver
@@ -8,10 +8,23 @@
 #include <userver/server/handlers/tests_control.hpp>
 #include <userver/storages/postgres/component.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
+#include <userver/ugrpc/client/component_list.hpp>
 #include <userver/ugrpc/server/component_list.hpp>
 #include <userver/utils/daemon_run.hpp>
 
+#include "components/answer_analytics/answer_analytics.hpp"
+#include "components/deadline_propagation/deadline_propagation.hpp"
 #include "components/hello_grpc/hello_grpc.hpp"
+#include "components/live_rooms/live_rooms.hpp"
+#include "components/live_session_router/live_session_router.hpp"
+#include "components/live_sessions/live_sessions.hpp"
+#include "components/load_shedding/load_shedding.hpp"
+#include "components/pack_invalidation/pack_invalidation.hpp"
+#include "components/rate_limiting/rate_limiting.hpp"
+#include "components/response_compression/response_compression.hpp"
+#include "components/sharded_storage/sharded_storage.hpp"
+#include "components/stale_content/stale_content.hpp"
+#include "components/trace_export/trace_export.hpp"
 #include "handlers/component_list.hpp"
 
 #include "utils//constants.hpp"
@@ -26,8 +39,21 @@ int main(int argc, char* argv[]) {
             .Append<userver::clients::dns::Component>()
             .Append<userver::server::handlers::TestsControl>()
             .Append<userver::congestion_control::Component>()
+            .Append<game_userver::LoadShedding>()
+            .Append<game_userver::RateLimiting>()
+            .Append<game_userver::ResponseCompression>()
+            .Append<game_userver::DeadlinePropagation>()
+            .Append<game_userver::StaleContent>()
             .Append<userver::components::Postgres>(Constants::kDatabaseName)
+            .Append<game_userver::ShardedStorage>()
+            .Append<game_userver::PackInvalidation>()
+            .Append<game_userver::AnswerAnalytics>()
+            .Append<game_userver::LiveSessions>()
+            .Append<game_userver::LiveSessionRouter>()
+            .Append<game_userver::LiveRooms>()
+            .Append<game_userver::TraceExport>()
             .AppendComponentList(userver::ugrpc::server::MinimalComponentList())
+            .AppendComponentList(userver::ugrpc::client::MinimalComponentList())
             .AppendComponentList(game_userver::GetHandlersComponentList());
 
     return userver::utils::DaemonMain(argc, argv, component_list);
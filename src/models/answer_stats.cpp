@@ -0,0 +1,53 @@
+#include "answer_stats.hpp"
+
+#include <boost/uuid/uuid_io.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+namespace Models {
+
+auto AnswerStatsDelta::IsEmpty() const -> bool {
+    return packs.empty() && questions.empty() && variants.empty();
+}
+
+auto Serialize(
+    const QuestionStats& question_stats,
+    userver::formats::serialize::To<userver::formats::json::Value>
+    /*unused*/
+) -> userver::formats::json::Value {
+    userver::formats::json::ValueBuilder variants{
+        userver::formats::common::Type::kArray
+    };
+    for (const auto& variant : question_stats.variants) {
+        userver::formats::json::ValueBuilder item;
+        item["variant_id"] = boost::uuids::to_string(variant.variant_id);
+        item["picks"] = variant.picks;
+        item["pick_rate"] =
+            question_stats.attempts == 0
+                ? 0.0
+                : static_cast<double>(variant.picks) /
+                      static_cast<double>(question_stats.attempts);
+        variants.PushBack(std::move(item));
+    }
+
+    userver::formats::json::ValueBuilder item;
+    item["question_id"] = boost::uuids::to_string(question_stats.question_id);
+    item["attempts"] = question_stats.attempts;
+    item["correct"] = question_stats.correct;
+    item["unique_players"] = question_stats.unique_players;
+    item["variants"] = std::move(variants);
+    return item.ExtractValue();
+}
+
+auto Serialize(
+    const PackStats& pack_stats,
+    userver::formats::serialize::To<userver::formats::json::Value>
+    /*unused*/
+) -> userver::formats::json::Value {
+    userver::formats::json::ValueBuilder item;
+    item["pack_id"] = boost::uuids::to_string(pack_stats.pack_id);
+    item["answers"] = pack_stats.answers;
+    item["unique_players"] = pack_stats.unique_players;
+    return item.ExtractValue();
+}
+
+} // namespace Models
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <cstdint>
+#include <string>
+#include <userver/formats/json/value.hpp>
+#include <vector>
+
+namespace Models {
+
+// What an answer needs to be checked and counted
+struct AnswerKey final {
+    boost::uuids::uuid question_id;
+    boost::uuids::uuid pack_id;
+    bool is_correct = false;
+};
+
+// Increments collected in-process since the last flush. Unique players are
+// whole serialized Utils::HyperLogLog sketches, merging them is idempotent.
+struct PackStatsDelta final {
+    boost::uuids::uuid pack_id;
+    std::int64_t answers = 0;
+    std::string players;
+};
+
+struct QuestionStatsDelta final {
+    boost::uuids::uuid question_id;
+    std::int64_t attempts = 0;
+    std::int64_t correct = 0;
+    std::string players;
+};
+
+struct VariantStatsDelta final {
+    boost::uuids::uuid variant_id;
+    std::int64_t picks = 0;
+};
+
+struct AnswerStatsDelta final {
+    std::vector<PackStatsDelta> packs;
+    std::vector<QuestionStatsDelta> questions;
+    std::vector<VariantStatsDelta> variants;
+
+    [[nodiscard]] auto IsEmpty() const -> bool;
+};
+
+struct VariantPicks final {
+    boost::uuids::uuid variant_id;
+    std::int64_t picks = 0;
+};
+
+struct QuestionStats final {
+    boost::uuids::uuid question_id;
+    std::int64_t attempts = 0;
+    std::int64_t correct = 0;
+    std::uint64_t unique_players = 0;
+    std::vector<VariantPicks> variants;
+};
+
+struct PackStats final {
+    boost::uuids::uuid pack_id;
+    std::int64_t answers = 0;
+    std::uint64_t unique_players = 0;
+};
+
+// Adds pick rates of variants
+auto Serialize(
+    const QuestionStats& question_stats,
+    userver::formats::serialize::To<userver::formats::json::Value>
+) -> userver::formats::json::Value;
+
+auto Serialize(
+    const PackStats& pack_stats,
+    userver::formats::serialize::To<userver::formats::json::Value>
+) -> userver::formats::json::Value;
+
+} // namespace Models
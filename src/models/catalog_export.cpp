@@ -0,0 +1,155 @@
+#include "catalog_export.hpp"
+
+#include <boost/uuid/uuid_io.hpp>
+
+#include "utils/text_escape.hpp"
+
+namespace Models {
+
+namespace {
+
+// NDJSON: one object per line with a "type" discriminator, children refer
+// to their parent by id
+
+void AppendNdjsonPack(std::string& out, const ExportedPack& pack) {
+    out += R"({"type":"pack","id":")";
+    out += boost::uuids::to_string(pack.id);
+    out += R"(","title":)";
+    Utils::AppendJsonString(out, pack.title);
+    out += R"(,"version":)";
+    out += std::to_string(pack.version);
+    out += R"(,"updated_at":")";
+    out += pack.updated_at;
+    out += "\"}\n";
+}
+
+void AppendNdjsonQuestion(
+    std::string& out, const ExportedPack& pack, const ExportedQuestionRow& row
+) {
+    out += R"({"type":"question","id":")";
+    out += boost::uuids::to_string(row.question_id);
+    out += R"(","pack_id":")";
+    out += boost::uuids::to_string(pack.id);
+    out += R"(","text":)";
+    Utils::AppendJsonString(out, row.question_text);
+    out += R"(,"image_url":)";
+    Utils::AppendJsonString(out, row.image_url);
+    out += "}\n";
+}
+
+void AppendNdjsonVariant(std::string& out, const ExportedQuestionRow& row) {
+    out += R"({"type":"variant","id":")";
+    out += boost::uuids::to_string(*row.variant_id);
+    out += R"(","question_id":")";
+    out += boost::uuids::to_string(row.question_id);
+    out += R"(","text":)";
+    Utils::AppendJsonString(out, row.variant_text.value_or(""));
+    out += R"(,"is_correct":)";
+    out += row.is_correct.value_or(false) ? "true" : "false";
+    out += "}\n";
+}
+
+// CSV: one table for all record types, columns that do not apply to a type
+// are left empty
+
+constexpr std::string_view kCsvHeader =
+    "type,id,parent_id,text,image_url,is_correct,version,updated_at\r\n";
+
+void AppendCsvPack(std::string& out, const ExportedPack& pack) {
+    out += "pack,";
+    out += boost::uuids::to_string(pack.id);
+    out += ",,";
+    Utils::AppendCsvField(out, pack.title);
+    out += ",,,";
+    out += std::to_string(pack.version);
+    out += ',';
+    out += pack.updated_at;
+    out += "\r\n";
+}
+
+void AppendCsvQuestion(
+    std::string& out, const ExportedPack& pack, const ExportedQuestionRow& row
+) {
+    out += "question,";
+    out += boost::uuids::to_string(row.question_id);
+    out += ',';
+    out += boost::uuids::to_string(pack.id);
+    out += ',';
+    Utils::AppendCsvField(out, row.question_text);
+    out += ',';
+    Utils::AppendCsvField(out, row.image_url);
+    out += ",,,\r\n";
+}
+
+void AppendCsvVariant(std::string& out, const ExportedQuestionRow& row) {
+    out += "variant,";
+    out += boost::uuids::to_string(*row.variant_id);
+    out += ',';
+    out += boost::uuids::to_string(row.question_id);
+    out += ',';
+    Utils::AppendCsvField(out, row.variant_text.value_or(""));
+    out += ",,";
+    out += row.is_correct.value_or(false) ? "true" : "false";
+    out += ",,\r\n";
+}
+
+} // namespace
+
+auto ParseExportFormat(std::string_view format)
+    -> std::optional<ExportFormat> {
+    if (format.empty() || format == "ndjson") {
+        return ExportFormat::kNdjson;
+    }
+    if (format == "csv") {
+        return ExportFormat::kCsv;
+    }
+    return std::nullopt;
+}
+
+auto GetExportContentType(ExportFormat format) -> std::string_view {
+    switch (format) {
+        case ExportFormat::kNdjson:
+            return "application/x-ndjson";
+        case ExportFormat::kCsv:
+            return "text/csv; charset=utf-8";
+    }
+    return {};
+}
+
+auto GetExportHeader(ExportFormat format) -> std::string_view {
+    return format == ExportFormat::kCsv ? kCsvHeader : std::string_view{};
+}
+
+void AppendExportedPack(
+    std::string& out, ExportFormat format, const ExportedPack& pack,
+    const std::vector<ExportedQuestionRow>& rows
+) {
+    const bool is_csv = format == ExportFormat::kCsv;
+    if (is_csv) {
+        AppendCsvPack(out, pack);
+    } else {
+        AppendNdjsonPack(out, pack);
+    }
+
+    const ExportedQuestionRow* question = nullptr;
+    for (const auto& row : rows) {
+        if (!question || question->question_id != row.question_id) {
+            question = &row;
+            if (is_csv) {
+                AppendCsvQuestion(out, pack, row);
+            } else {
+                AppendNdjsonQuestion(out, pack, row);
+            }
+        }
+        if (!row.variant_id) {
+            continue;
+        }
+        if (is_csv) {
+            AppendCsvVariant(out, row);
+        } else {
+            AppendNdjsonVariant(out, row);
+        }
+    }
+}
+
+} // namespace Models
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Models {
+
+// Rows of the catalog export. Plain aggregates, read from Postgres field by
+// field and written out record by record, never held for the whole catalog.
+
+struct ExportedPack final {
+    boost::uuids::uuid id;
+    std::string title;
+    std::int32_t version = 0;
+    // RFC 3339 in UTC, rendered by Postgres
+    std::string updated_at;
+};
+
+// A question joined with one of its variants. The variant fields are empty
+// for a question without variants.
+struct ExportedQuestionRow final {
+    boost::uuids::uuid question_id;
+    std::string question_text;
+    std::string image_url;
+    std::optional<boost::uuids::uuid> variant_id;
+    std::optional<std::string> variant_text;
+    std::optional<bool> is_correct;
+};
+
+enum class ExportFormat {
+    kNdjson,
+    kCsv
+};
+
+auto ParseExportFormat(std::string_view format) -> std::optional<ExportFormat>;
+
+auto GetExportContentType(ExportFormat format) -> std::string_view;
+
+// The line that opens the export, empty for formats without one
+auto GetExportHeader(ExportFormat format) -> std::string_view;
+
+// Appends one record per pack, question and variant. `rows` must be ordered
+// by question, as export_pack_rows.sql returns them.
+void AppendExportedPack(
+    std::string& out, ExportFormat format, const ExportedPack& pack,
+    const std::vector<ExportedQuestionRow>& rows
+);
+
+} // namespace Models
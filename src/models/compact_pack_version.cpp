@@ -0,0 +1,301 @@
+#include "compact_pack_version.hpp"
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <userver/formats/json/value_builder.hpp>
+
+namespace Models {
+
+namespace {
+
+constexpr std::size_t kBitsPerWord = 64;
+
+// "https://cdn.example.com/images/1.png" -> "https://cdn.example.com",
+// anything without a scheme is kept whole as the path
+auto SplitHost(std::string_view url) -> std::size_t {
+    const auto scheme = url.find("://");
+    if (scheme == std::string_view::npos) {
+        return 0;
+    }
+    const auto path = url.find('/', scheme + 3);
+    return path == std::string_view::npos ? url.size() : path;
+}
+
+} // namespace
+
+CompactPackVersion::CompactPackVersion(const PackVersion& pack_version)
+    : pack_id_(pack_version.pack_id), version_(pack_version.version) {
+    std::vector<const Question*> questions;
+    questions.reserve(pack_version.questions.size());
+    for (const auto& question : pack_version.questions) {
+        questions.push_back(&question);
+    }
+    std::sort(questions.begin(), questions.end(), [](auto* lhs, auto* rhs) {
+        return lhs->id < rhs->id;
+    });
+
+    std::unordered_map<
+        boost::uuids::uuid, std::vector<const Variant*>,
+        boost::hash<boost::uuids::uuid>>
+        variants_by_question;
+    for (const auto& variant : pack_version.variants) {
+        variants_by_question[variant.question_id].push_back(&variant);
+    }
+
+    title_ = Append(pack_version.title);
+    question_ids_.reserve(questions.size());
+    question_texts_.reserve(questions.size());
+    image_url_hosts_.reserve(questions.size());
+    image_url_paths_.reserve(questions.size());
+    variant_begins_.reserve(questions.size() + 1);
+    variant_ids_.reserve(pack_version.variants.size());
+    variant_texts_.reserve(pack_version.variants.size());
+    correct_bits_.resize(
+        (pack_version.variants.size() + kBitsPerWord - 1) / kBitsPerWord
+    );
+
+    // Hosts come from user input, so they live and die with the version
+    // rather than in a process-wide table
+    std::unordered_map<std::string_view, Span> hosts;
+    for (const auto* question : questions) {
+        question_ids_.push_back(question->id);
+        question_texts_.push_back(Append(question->text));
+
+        const std::string_view url = question->image_url;
+        const auto host = SplitHost(url);
+        auto [it, inserted] = hosts.try_emplace(url.substr(0, host));
+        if (inserted) {
+            it->second = Append(it->first);
+        }
+        image_url_hosts_.push_back(it->second);
+        image_url_paths_.push_back(Append(url.substr(host)));
+
+        variant_begins_.push_back(
+            static_cast<std::uint32_t>(variant_ids_.size())
+        );
+        auto& variants = variants_by_question[question->id];
+        std::sort(variants.begin(), variants.end(), [](auto* lhs, auto* rhs) {
+            return lhs->id < rhs->id;
+        });
+        for (const auto* variant : variants) {
+            if (variant->is_correct) {
+                const auto index = variant_ids_.size();
+                correct_bits_[index / kBitsPerWord] |=
+                    std::uint64_t{1} << (index % kBitsPerWord);
+            }
+            variant_ids_.push_back(variant->id);
+            variant_texts_.push_back(Append(variant->text));
+        }
+    }
+    variant_begins_.push_back(static_cast<std::uint32_t>(variant_ids_.size()));
+
+    variants_by_id_.resize(variant_ids_.size());
+    for (std::uint32_t i = 0; i < variants_by_id_.size(); ++i) {
+        variants_by_id_[i] = i;
+    }
+    std::sort(
+        variants_by_id_.begin(), variants_by_id_.end(),
+        [this](std::uint32_t lhs, std::uint32_t rhs) {
+            return variant_ids_[lhs] < variant_ids_[rhs];
+        }
+    );
+
+    arena_.shrink_to_fit();
+}
+
+auto CompactPackVersion::GetPackId() const -> const boost::uuids::uuid& {
+    return pack_id_;
+}
+
+auto CompactPackVersion::GetVersion() const -> std::int32_t {
+    return version_;
+}
+
+auto CompactPackVersion::GetTitle() const -> std::string_view {
+    return View(title_);
+}
+
+auto CompactPackVersion::GetQuestionCount() const -> std::size_t {
+    return question_ids_.size();
+}
+
+auto CompactPackVersion::GetQuestionId(std::size_t question) const
+    -> const boost::uuids::uuid& {
+    return question_ids_[question];
+}
+
+auto CompactPackVersion::GetQuestionText(std::size_t question) const
+    -> std::string_view {
+    return View(question_texts_[question]);
+}
+
+auto CompactPackVersion::GetImageUrl(std::size_t question) const
+    -> std::string {
+    const auto host = View(image_url_hosts_[question]);
+    const auto path = View(image_url_paths_[question]);
+    std::string url;
+    url.reserve(host.size() + path.size());
+    url.append(host).append(path);
+    return url;
+}
+
+auto CompactPackVersion::GetFirstVariant(std::size_t question) const
+    -> std::size_t {
+    return variant_begins_[question];
+}
+
+auto CompactPackVersion::GetLastVariant(std::size_t question) const
+    -> std::size_t {
+    return variant_begins_[question + 1];
+}
+
+auto CompactPackVersion::GetVariantCount() const -> std::size_t {
+    return variant_ids_.size();
+}
+
+auto CompactPackVersion::GetVariantId(std::size_t variant) const
+    -> const boost::uuids::uuid& {
+    return variant_ids_[variant];
+}
+
+auto CompactPackVersion::GetVariantText(std::size_t variant) const
+    -> std::string_view {
+    return View(variant_texts_[variant]);
+}
+
+auto CompactPackVersion::IsCorrect(std::size_t variant) const -> bool {
+    return ((correct_bits_[variant / kBitsPerWord] >>
+             (variant % kBitsPerWord)) &
+            1U) != 0;
+}
+
+auto CompactPackVersion::FindQuestion(const boost::uuids::uuid& question_id)
+    const -> std::optional<std::size_t> {
+    const auto it = std::lower_bound(
+        question_ids_.begin(), question_ids_.end(), question_id
+    );
+    if (it == question_ids_.end() || *it != question_id) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(it - question_ids_.begin());
+}
+
+auto CompactPackVersion::CheckAnswer(
+    const boost::uuids::uuid& question_id, const boost::uuids::uuid& variant_id
+) const -> std::optional<bool> {
+    const auto question = FindQuestion(question_id);
+    if (!question) {
+        return std::nullopt;
+    }
+    for (auto variant = GetFirstVariant(*question);
+         variant < GetLastVariant(*question); ++variant) {
+        if (variant_ids_[variant] == variant_id) {
+            return IsCorrect(variant);
+        }
+    }
+    return std::nullopt;
+}
+
+auto CompactPackVersion::FindAnswer(const boost::uuids::uuid& variant_id) const
+    -> std::optional<AnswerKey> {
+    const auto it = std::lower_bound(
+        variants_by_id_.begin(), variants_by_id_.end(), variant_id,
+        [this](std::uint32_t variant, const boost::uuids::uuid& id) {
+            return variant_ids_[variant] < id;
+        }
+    );
+    if (it == variants_by_id_.end() || variant_ids_[*it] != variant_id) {
+        return std::nullopt;
+    }
+    return AnswerKey{
+        question_ids_[GetQuestionOf(*it)], pack_id_, IsCorrect(*it)
+    };
+}
+
+auto CompactPackVersion::GetMemoryUsage() const -> std::size_t {
+    const auto bytes = [](const auto& column) {
+        return column.capacity() * sizeof(column[0]);
+    };
+    return sizeof(*this) + arena_.capacity() + bytes(question_ids_) +
+           bytes(question_texts_) + bytes(image_url_hosts_) +
+           bytes(image_url_paths_) + bytes(variant_begins_) +
+           bytes(variant_ids_) + bytes(variant_texts_) +
+           bytes(correct_bits_) + bytes(variants_by_id_);
+}
+
+auto CompactPackVersion::Append(std::string_view str) -> Span {
+    constexpr auto kMaxArenaSize = std::numeric_limits<std::uint32_t>::max();
+    if (arena_.size() + str.size() > kMaxArenaSize) {
+        throw std::length_error{"Pack version texts exceed 4 GiB"};
+    }
+    const Span span{
+        static_cast<std::uint32_t>(arena_.size()),
+        static_cast<std::uint32_t>(str.size())
+    };
+    arena_.append(str);
+    return span;
+}
+
+auto CompactPackVersion::View(Span span) const -> std::string_view {
+    return std::string_view{arena_}.substr(span.offset, span.size);
+}
+
+auto CompactPackVersion::GetQuestionOf(std::size_t variant) const
+    -> std::size_t {
+    const auto it = std::upper_bound(
+        variant_begins_.begin(), variant_begins_.end(), variant
+    );
+    return static_cast<std::size_t>(it - variant_begins_.begin()) - 1;
+}
+
+auto Serialize(
+    const CompactPackVersion& pack_version,
+    userver::formats::serialize::To<userver::formats::json::Value>
+    /*unused*/
+) -> userver::formats::json::Value {
+    const auto pack_id = boost::uuids::to_string(pack_version.GetPackId());
+
+    userver::formats::json::ValueBuilder questions{
+        userver::formats::common::Type::kArray
+    };
+    for (std::size_t i = 0; i < pack_version.GetQuestionCount(); ++i) {
+        const auto question_id =
+            boost::uuids::to_string(pack_version.GetQuestionId(i));
+
+        userver::formats::json::ValueBuilder variants{
+            userver::formats::common::Type::kArray
+        };
+        for (auto j = pack_version.GetFirstVariant(i);
+             j < pack_version.GetLastVariant(i); ++j) {
+            userver::formats::json::ValueBuilder variant;
+            variant["id"] =
+                boost::uuids::to_string(pack_version.GetVariantId(j));
+            variant["question_id"] = question_id;
+            variant["text"] = std::string{pack_version.GetVariantText(j)};
+            variant["is_correct"] = pack_version.IsCorrect(j);
+            variants.PushBack(std::move(variant));
+        }
+
+        userver::formats::json::ValueBuilder question;
+        question["id"] = question_id;
+        question["pack_id"] = pack_id;
+        question["text"] = std::string{pack_version.GetQuestionText(i)};
+        question["image_url"] = pack_version.GetImageUrl(i);
+        question["variants"] = std::move(variants);
+        questions.PushBack(std::move(question));
+    }
+
+    userver::formats::json::ValueBuilder item;
+    item["pack_id"] = pack_id;
+    item["version"] = pack_version.GetVersion();
+    item["title"] = std::string{pack_version.GetTitle()};
+    item["questions"] = std::move(questions);
+    return item.ExtractValue();
+}
+
+} // namespace Models
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <userver/formats/json/value.hpp>
+#include <vector>
+
+#include "models/answer_stats.hpp"
+#include "models/pack_version.hpp"
+
+namespace Models {
+
+// Read-only PackVersion laid out for the in-memory cache of published packs.
+//
+// Instead of a heap-allocated object per question and variant, every field
+// is a column (struct of arrays) and all texts share one arena:
+//  - questions are sorted by id, their variants are contiguous and sorted
+//    by id too, so checking an answer to a known question reads the column
+//    of variant ids, usually a single cache line, and one correctness bit;
+//  - image URLs are split into the scheme and host, and the rest; a few
+//    hosts serve all images, so each is kept in the arena once per version.
+//
+// Question and variant indices below are positions in these columns.
+class CompactPackVersion final {
+public:
+    explicit CompactPackVersion(const PackVersion& pack_version);
+
+    [[nodiscard]] auto GetPackId() const -> const boost::uuids::uuid&;
+    [[nodiscard]] auto GetVersion() const -> std::int32_t;
+    [[nodiscard]] auto GetTitle() const -> std::string_view;
+
+    [[nodiscard]] auto GetQuestionCount() const -> std::size_t;
+    [[nodiscard]] auto GetQuestionId(std::size_t question) const
+        -> const boost::uuids::uuid&;
+    [[nodiscard]] auto GetQuestionText(std::size_t question) const
+        -> std::string_view;
+    [[nodiscard]] auto GetImageUrl(std::size_t question) const -> std::string;
+
+    // Indices of the variants of `question` are [first, last)
+    [[nodiscard]] auto GetFirstVariant(std::size_t question) const
+        -> std::size_t;
+    [[nodiscard]] auto GetLastVariant(std::size_t question) const
+        -> std::size_t;
+
+    [[nodiscard]] auto GetVariantCount() const -> std::size_t;
+    [[nodiscard]] auto GetVariantId(std::size_t variant) const
+        -> const boost::uuids::uuid&;
+    [[nodiscard]] auto GetVariantText(std::size_t variant) const
+        -> std::string_view;
+    [[nodiscard]] auto IsCorrect(std::size_t variant) const -> bool;
+
+    [[nodiscard]] auto FindQuestion(const boost::uuids::uuid& question_id)
+        const -> std::optional<std::size_t>;
+
+    // Returns std::nullopt if the variant is not in this version
+    [[nodiscard]] auto CheckAnswer(
+        const boost::uuids::uuid& question_id,
+        const boost::uuids::uuid& variant_id
+    ) const -> std::optional<bool>;
+
+    // Same without the question, a binary search over all variants
+    [[nodiscard]] auto FindAnswer(const boost::uuids::uuid& variant_id) const
+        -> std::optional<AnswerKey>;
+
+    // Bytes owned by this object, an estimate for cache sizing
+    [[nodiscard]] auto GetMemoryUsage() const -> std::size_t;
+
+private:
+    struct Span final {
+        std::uint32_t offset = 0;
+        std::uint32_t size = 0;
+    };
+
+    auto Append(std::string_view str) -> Span;
+    [[nodiscard]] auto View(Span span) const -> std::string_view;
+    [[nodiscard]] auto GetQuestionOf(std::size_t variant) const
+        -> std::size_t;
+
+    boost::uuids::uuid pack_id_;
+    std::int32_t version_;
+    Span title_;
+    std::string arena_;
+
+    std::vector<boost::uuids::uuid> question_ids_;
+    std::vector<Span> question_texts_;
+    std::vector<Span> image_url_hosts_;
+    std::vector<Span> image_url_paths_;
+    // Variants of question i are [variant_begins_[i], variant_begins_[i + 1])
+    std::vector<std::uint32_t> variant_begins_;
+
+    std::vector<boost::uuids::uuid> variant_ids_;
+    std::vector<Span> variant_texts_;
+    std::vector<std::uint64_t> correct_bits_;
+    // Variant indices ordered by variant id, for FindAnswer
+    std::vector<std::uint32_t> variants_by_id_;
+};
+
+// Same JSON as for PackVersion
+auto Serialize(
+    const CompactPackVersion& pack_version,
+    userver::formats::serialize::To<userver::formats::json::Value>
+) -> userver::formats::json::Value;
+
+} // namespace Models
@@ -0,0 +1,69 @@
+#include "live_room.hpp"
+
+#include <boost/uuid/uuid_io.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include "utils/string_to_uuid.hpp"
+
+namespace Models {
+
+auto ParseRoomCommand(std::string_view message)
+    -> std::optional<RoomCommand> {
+    try {
+        const auto json = userver::formats::json::FromString(message);
+        if (json["type"].As<std::string>("") == "answer") {
+            const auto variantId = Utils::StringToUuid(
+                json["variant_id"].As<std::string>("")
+            );
+            if (variantId.is_nil()) {
+                return std::nullopt;
+            }
+            return RoomCommand{variantId};
+        }
+    } catch (const userver::formats::json::Exception&) {
+    }
+    return std::nullopt;
+}
+
+auto MakeQuestionMessage(const LiveSession& session) -> std::string {
+    userver::formats::json::ValueBuilder message;
+    message["type"] = "question";
+    message["session"] = session;
+    return userver::formats::json::ToString(message.ExtractValue());
+}
+
+auto MakeResultsMessage(
+    const LiveSession& session, std::size_t question,
+    const std::vector<std::uint32_t>& answers
+) -> std::string {
+    const auto& pack = *session.pack;
+    const auto first = pack.GetFirstVariant(question);
+
+    userver::formats::json::ValueBuilder variants{
+        userver::formats::common::Type::kArray
+    };
+    for (auto i = first; i < pack.GetLastVariant(question); ++i) {
+        userver::formats::json::ValueBuilder variant;
+        variant["id"] = boost::uuids::to_string(pack.GetVariantId(i));
+        variant["correct"] = pack.IsCorrect(i);
+        variant["answers"] = i - first < answers.size() ? answers[i - first]
+                                                        : std::uint32_t{0};
+        variants.PushBack(std::move(variant));
+    }
+
+    userver::formats::json::ValueBuilder message;
+    message["type"] = "results";
+    message["question_index"] = question;
+    message["question_id"] =
+        boost::uuids::to_string(pack.GetQuestionId(question));
+    message["variants"] = std::move(variants);
+    return userver::formats::json::ToString(message.ExtractValue());
+}
+
+auto MakeClosedMessage() -> std::string {
+    return R"({"type":"closed"})";
+}
+
+} // namespace Models
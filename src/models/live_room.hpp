@@ -0,0 +1,49 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "models/live_session.hpp"
+
+namespace Models {
+
+// Messages of the live room WebSocket, all JSON text frames.
+//
+// The server sends
+//   {"type": "question", "session": {...}}  on join and on every new round,
+//                                           the session as in the HTTP API
+//   {"type": "results", "question_index": 0, "question_id": "...",
+//    "variants": [{"id": "...", "correct": true, "answers": 3}, ...]}
+//                                           when a round ends
+//   {"type": "closed"}                      once the session is dropped
+//
+// and accepts
+//   {"type": "answer", "variant_id": "..."}  one per player and round
+//
+// Nobody skips questions over the WebSocket: connections are anonymous, so
+// the host does it with /live/next-question.
+
+struct RoomCommand final {
+    boost::uuids::uuid variant_id{};
+};
+
+// Returns std::nullopt for anything but a well-formed command
+auto ParseRoomCommand(std::string_view message) -> std::optional<RoomCommand>;
+
+auto MakeQuestionMessage(const LiveSession& session) -> std::string;
+
+// `answers` has the number of answers to every variant of the question, in
+// the order of the pack
+auto MakeResultsMessage(
+    const LiveSession& session, std::size_t question,
+    const std::vector<std::uint32_t>& answers
+) -> std::string;
+
+auto MakeClosedMessage() -> std::string;
+
+} // namespace Models
@@ -0,0 +1,59 @@
+#include "live_session.hpp"
+
+#include <algorithm>
+#include <boost/uuid/uuid_io.hpp>
+#include <cstdint>
+#include <string>
+#include <userver/formats/json/value_builder.hpp>
+
+namespace Models {
+
+auto LiveSession::IsFinished() const -> bool {
+    return question >= pack->GetQuestionCount();
+}
+
+auto Serialize(
+    const LiveSession& session,
+    userver::formats::serialize::To<userver::formats::json::Value>
+    /*unused*/
+) -> userver::formats::json::Value {
+    const auto& pack = *session.pack;
+
+    userver::formats::json::ValueBuilder item;
+    item["id"] = boost::uuids::to_string(session.id);
+    item["pack_id"] = boost::uuids::to_string(pack.GetPackId());
+    item["version"] = pack.GetVersion();
+    item["question_count"] = pack.GetQuestionCount();
+    item["finished"] = session.IsFinished();
+    if (session.IsFinished()) {
+        return item.ExtractValue();
+    }
+
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        session.round_ends_at - std::chrono::steady_clock::now()
+    );
+    item["question_index"] = session.question;
+    item["round_left_ms"] = std::max<std::int64_t>(left.count(), 0);
+
+    userver::formats::json::ValueBuilder variants{
+        userver::formats::common::Type::kArray
+    };
+    for (auto i = pack.GetFirstVariant(session.question);
+         i < pack.GetLastVariant(session.question); ++i) {
+        userver::formats::json::ValueBuilder variant;
+        variant["id"] = boost::uuids::to_string(pack.GetVariantId(i));
+        variant["text"] = std::string{pack.GetVariantText(i)};
+        variants.PushBack(std::move(variant));
+    }
+
+    userver::formats::json::ValueBuilder question;
+    question["id"] =
+        boost::uuids::to_string(pack.GetQuestionId(session.question));
+    question["text"] = std::string{pack.GetQuestionText(session.question)};
+    question["image_url"] = pack.GetImageUrl(session.question);
+    question["variants"] = std::move(variants);
+    item["question"] = std::move(question);
+    return item.ExtractValue();
+}
+
+} // namespace Models
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <userver/formats/json/value.hpp>
+
+#include "models/compact_pack_version.hpp"
+
+namespace Models {
+
+// A live game over a published pack version: every question is a timed
+// round, the next one starts when the round times out or the host skips it.
+struct LiveSession final {
+    boost::uuids::uuid id;
+    std::shared_ptr<const CompactPackVersion> pack;
+    std::chrono::milliseconds round_duration{0};
+    // Index of the current question, the question count once finished
+    std::size_t question = 0;
+    std::chrono::steady_clock::time_point round_ends_at;
+
+    [[nodiscard]] auto IsFinished() const -> bool;
+};
+
+// The current question goes without correctness, the time left is counted
+// from the moment of serialization
+auto Serialize(
+    const LiveSession& session,
+    userver::formats::serialize::To<userver::formats::json::Value>
+) -> userver::formats::json::Value;
+
+} // namespace Models
@@ -0,0 +1,78 @@
+#include "live_session_record.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Models {
+
+namespace {
+
+constexpr std::size_t kEncodedSize = 1 + 16 + 16 + 4 + 8 + 4 + 8;
+
+template <typename Int>
+void AppendInt(std::string& out, Int value) {
+    const auto bits = static_cast<std::uint64_t>(value);
+    for (std::size_t i = 0; i < sizeof(Int); ++i) {
+        out += static_cast<char>((bits >> (8 * i)) & 0xff);
+    }
+}
+
+void AppendUuid(std::string& out, const boost::uuids::uuid& uuid) {
+    out.append(reinterpret_cast<const char*>(uuid.data), uuid.size());
+}
+
+template <typename Int>
+auto ReadInt(std::string_view& data) -> Int {
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i < sizeof(Int); ++i) {
+        bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i]))
+                << (8 * i);
+    }
+    data.remove_prefix(sizeof(Int));
+    return static_cast<Int>(bits);
+}
+
+auto ReadUuid(std::string_view& data) -> boost::uuids::uuid {
+    boost::uuids::uuid uuid{};
+    std::copy_n(data.data(), uuid.size(), uuid.data);
+    data.remove_prefix(uuid.size());
+    return uuid;
+}
+
+} // namespace
+
+auto EncodeLiveSessionRecord(const LiveSessionRecord& record) -> std::string {
+    std::string out;
+    out.reserve(kEncodedSize);
+    AppendInt(out, static_cast<std::uint8_t>(record.kind));
+    AppendUuid(out, record.session_id);
+    AppendUuid(out, record.pack_id);
+    AppendInt(out, record.version);
+    AppendInt(out, record.round_duration_ms);
+    AppendInt(out, record.question);
+    AppendInt(out, record.round_ends_at_ms);
+    return out;
+}
+
+auto DecodeLiveSessionRecord(std::string_view data)
+    -> std::optional<LiveSessionRecord> {
+    if (data.size() != kEncodedSize) {
+        return std::nullopt;
+    }
+    LiveSessionRecord record;
+    const auto kind = ReadInt<std::uint8_t>(data);
+    if (kind < static_cast<std::uint8_t>(LiveSessionRecord::Kind::kStarted) ||
+        kind > static_cast<std::uint8_t>(LiveSessionRecord::Kind::kExpired)) {
+        return std::nullopt;
+    }
+    record.kind = static_cast<LiveSessionRecord::Kind>(kind);
+    record.session_id = ReadUuid(data);
+    record.pack_id = ReadUuid(data);
+    record.version = ReadInt<std::int32_t>(data);
+    record.round_duration_ms = ReadInt<std::int64_t>(data);
+    record.question = ReadInt<std::uint32_t>(data);
+    record.round_ends_at_ms = ReadInt<std::int64_t>(data);
+    return record;
+}
+
+} // namespace Models
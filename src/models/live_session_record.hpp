@@ -0,0 +1,44 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Models {
+
+// A change of a live session as written to the session journal. Records
+// carry state rather than deltas: replaying one twice, or an older one
+// right before a newer one, ends in the same state.
+struct LiveSessionRecord final {
+    enum class Kind : std::uint8_t {
+        // The whole session; also what a journal snapshot consists of
+        kStarted = 1,
+        // A new round began, or the session finished
+        kRound = 2,
+        // The finished session was dropped
+        kExpired = 3
+    };
+
+    Kind kind = Kind::kStarted;
+    boost::uuids::uuid session_id{};
+    // kStarted only
+    boost::uuids::uuid pack_id{};
+    std::int32_t version = 0;
+    std::int64_t round_duration_ms = 0;
+    // kStarted and kRound
+    std::uint32_t question = 0;
+    // Wall clock, unlike LiveSession::round_ends_at, so it means the same
+    // after a restart
+    std::int64_t round_ends_at_ms = 0;
+};
+
+// Fixed-size little-endian layout
+auto EncodeLiveSessionRecord(const LiveSessionRecord& record) -> std::string;
+
+// Returns std::nullopt if `data` is not an encoded record
+auto DecodeLiveSessionRecord(std::string_view data)
+    -> std::optional<LiveSessionRecord>;
+
+} // namespace Models
@@ -0,0 +1,81 @@
+#include "pack_version.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <charconv>
+#include <unordered_map>
+#include <userver/formats/json/value_builder.hpp>
+
+#include "utils/string_to_uuid.hpp"
+
+namespace Models {
+
+auto PackVersion::Introspect() const {
+    return std::tie(pack_id, version, title, questions, variants);
+}
+
+auto ParsePackVersionRef(std::string_view ref)
+    -> std::optional<PackVersionRef> {
+    const auto separator = ref.find('@');
+
+    PackVersionRef result;
+    result.pack_id = Utils::StringToUuid(std::string{ref.substr(0, separator)});
+    if (result.pack_id.is_nil()) {
+        return std::nullopt;
+    }
+    if (separator == std::string_view::npos) {
+        return result;
+    }
+
+    const auto version = ref.substr(separator + 1);
+    std::int32_t number = 0;
+    const auto* const last = version.data() + version.size();
+    const auto [end, error] = std::from_chars(version.data(), last, number);
+    if (error != std::errc{} || end != last || number <= 0) {
+        return std::nullopt;
+    }
+    result.version = number;
+    return result;
+}
+
+auto Serialize(
+    const PackVersion& pack_version,
+    userver::formats::serialize::To<userver::formats::json::Value>
+    /*unused*/
+) -> userver::formats::json::Value {
+    std::unordered_map<
+        boost::uuids::uuid, userver::formats::json::ValueBuilder,
+        boost::hash<boost::uuids::uuid>>
+        variants_by_question;
+    for (const auto& variant : pack_version.variants) {
+        auto [it, inserted] = variants_by_question.try_emplace(
+            variant.question_id, userver::formats::common::Type::kArray
+        );
+        it->second.PushBack(variant);
+    }
+
+    userver::formats::json::ValueBuilder questions{
+        userver::formats::common::Type::kArray
+    };
+    for (const auto& question : pack_version.questions) {
+        userver::formats::json::ValueBuilder item{question};
+        auto it = variants_by_question.find(question.id);
+        if (it != variants_by_question.end()) {
+            item["variants"] = std::move(it->second);
+        } else {
+            item["variants"] = userver::formats::json::ValueBuilder{
+                userver::formats::common::Type::kArray
+            };
+        }
+        questions.PushBack(std::move(item));
+    }
+
+    userver::formats::json::ValueBuilder item;
+    item["pack_id"] = boost::uuids::to_string(pack_version.pack_id);
+    item["version"] = pack_version.version;
+    item["title"] = pack_version.title;
+    item["questions"] = std::move(questions);
+    return item.ExtractValue();
+}
+
+} // namespace Models
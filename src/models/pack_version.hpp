@@ -0,0 +1,45 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <userver/formats/json/value.hpp>
+#include <vector>
+
+#include "models/question.hpp"
+#include "models/variant.hpp"
+
+namespace Models {
+
+// Immutable snapshot of a pack taken when it was published, addressed as
+// pack_id@version. The rows of quiz.packs, quiz.questions and quiz.variants
+// are the draft that is edited in place.
+struct PackVersion final {
+    boost::uuids::uuid pack_id;
+    std::int32_t version = 0;
+    std::string title;
+    std::vector<Question> questions;
+    std::vector<Variant> variants;
+
+    [[nodiscard]] auto Introspect() const;
+};
+
+// Reference to a pack version as written in requests: "<pack_id>@<version>",
+// or just "<pack_id>" for the latest published version
+struct PackVersionRef final {
+    boost::uuids::uuid pack_id;
+    std::optional<std::int32_t> version;
+};
+
+// Returns std::nullopt if `ref` is malformed
+auto ParsePackVersionRef(std::string_view ref) -> std::optional<PackVersionRef>;
+
+// Variants are nested into their questions
+auto Serialize(
+    const PackVersion& pack_version,
+    userver::formats::serialize::To<userver::formats::json::Value>
+) -> userver::formats::json::Value;
+
+} // namespace Models
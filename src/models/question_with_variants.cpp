@@ -0,0 +1,40 @@
+#include "question_with_variants.hpp"
+
+#include <userver/formats/json/value_builder.hpp>
+
+namespace Models {
+
+auto QuestionWithVariants::Introspect() const {
+    return std::tie(question, variants);
+}
+
+auto Parse(
+    const userver::formats::json::Value& json,
+    userver::formats::parse::To<VariantDraft>
+    /*unused*/
+) -> VariantDraft {
+    VariantDraft draft;
+    draft.text = json["text"].As<std::string>();
+    draft.is_correct = json["is_correct"].As<bool>(false);
+    return draft;
+}
+
+auto Serialize(
+    const QuestionWithVariants& question_with_variants,
+    userver::formats::serialize::To<userver::formats::json::Value>
+    /*unused*/
+) -> userver::formats::json::Value {
+    userver::formats::json::ValueBuilder item;
+    item["question"] = question_with_variants.question;
+
+    userver::formats::json::ValueBuilder variants{
+        userver::formats::common::Type::kArray
+    };
+    for (const auto& variant : question_with_variants.variants) {
+        variants.PushBack(variant);
+    }
+    item["variants"] = std::move(variants);
+    return item.ExtractValue();
+}
+
+} // namespace Models
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <userver/formats/json/value.hpp>
+#include <vector>
+
+#include "models/question.hpp"
+#include "models/variant.hpp"
+
+namespace Models {
+
+// Variant that is not stored yet and thus has no ids
+struct VariantDraft final {
+    std::string text;
+    bool is_correct = false;
+};
+
+struct QuestionWithVariants final {
+    Question question;
+    std::vector<Variant> variants;
+
+    [[nodiscard]] auto Introspect() const;
+};
+
+auto Parse(
+    const userver::formats::json::Value& json,
+    userver::formats::parse::To<VariantDraft>
+) -> VariantDraft;
+
+auto Serialize(
+    const QuestionWithVariants& question_with_variants,
+    userver::formats::serialize::To<userver::formats::json::Value>
+) -> userver::formats::json::Value;
+
+} // namespace Models
@@ -1,3 +1,4 @@
-SELECT is_correct
-FROM quiz.variants
-WHERE id = $1;
+SELECT v.question_id, q.pack_id, v.is_correct
+FROM quiz.variants v
+JOIN quiz.questions q ON q.id = v.question_id
+WHERE v.id = $1;
@@ -1,3 +1,3 @@
-INSERT INTO quiz.packs (title)
-VALUES ($1)
+INSERT INTO quiz.packs (id, title)
+VALUES ($1, $2)
 RETURNING id AS pack_id, title;
@@ -1,3 +1,3 @@
-INSERT INTO quiz.questions (pack_id, text, image_url)
-VALUES ($1, $2, $3)
+INSERT INTO quiz.questions (id, pack_id, text, image_url)
+VALUES ($1, $2, $3, $4)
 RETURNING id, pack_id, text, image_url;
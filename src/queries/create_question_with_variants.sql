@@ -0,0 +1,25 @@
+WITH question AS (
+    INSERT INTO quiz.questions (id, pack_id, text, image_url)
+    VALUES ($1, $2, $3, $4)
+    RETURNING id, pack_id, text, image_url
+), draft AS (
+    SELECT draft.id, draft.text, draft.is_correct, draft.position
+    FROM unnest($5::quiz.variant[])
+        WITH ORDINALITY AS draft(id, question_id, text, is_correct, position)
+), variants AS (
+    INSERT INTO quiz.variants (id, question_id, text, is_correct)
+    SELECT draft.id, question.id, draft.text, draft.is_correct
+    FROM question, draft
+    RETURNING id, question_id, text, is_correct
+)
+SELECT
+    (
+        SELECT ROW(q.id, q.pack_id, q.text, q.image_url)::quiz.question
+        FROM question q
+    ) AS question,
+    ARRAY(
+        SELECT ROW(v.id, v.question_id, v.text, v.is_correct)::quiz.variant
+        FROM variants v
+        JOIN draft USING (id)
+        ORDER BY draft.position
+    ) AS variants;
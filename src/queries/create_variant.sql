@@ -1,3 +1,3 @@
-INSERT INTO quiz.variants (question_id, text, is_correct)
-VALUES ($1, $2, $3)
+INSERT INTO quiz.variants (id, question_id, text, is_correct)
+VALUES ($1, $2, $3, $4)
 RETURNING id, question_id, text, is_correct;
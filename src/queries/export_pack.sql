@@ -0,0 +1,7 @@
+SELECT
+    id,
+    title,
+    version,
+    to_char(updated_at AT TIME ZONE 'UTC', 'YYYY-MM-DD"T"HH24:MI:SS.US"Z"')
+FROM quiz.packs
+WHERE id = $1 AND updated_at >= COALESCE($2::TIMESTAMPTZ, '-infinity');
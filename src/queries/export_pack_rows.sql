@@ -0,0 +1,11 @@
+SELECT
+    q.id,
+    q.text,
+    COALESCE(q.image_url, ''),
+    v.id,
+    v.text,
+    v.is_correct
+FROM quiz.questions q
+LEFT JOIN quiz.variants v ON v.question_id = q.id
+WHERE q.pack_id = $1
+ORDER BY q.id, v.id;
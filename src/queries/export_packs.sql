@@ -0,0 +1,8 @@
+SELECT
+    id,
+    title,
+    version,
+    to_char(updated_at AT TIME ZONE 'UTC', 'YYYY-MM-DD"T"HH24:MI:SS.US"Z"')
+FROM quiz.packs
+WHERE updated_at >= COALESCE($1::TIMESTAMPTZ, '-infinity')
+ORDER BY updated_at, id;
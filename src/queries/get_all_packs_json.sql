@@ -0,0 +1,5 @@
+SELECT
+    title,
+    json_build_object('id', id, 'title', title)::TEXT
+FROM quiz.packs
+ORDER BY title;
@@ -0,0 +1,26 @@
+SELECT json_build_object(
+    'id', p.id,
+    'title', p.title,
+    'questions', COALESCE((
+        SELECT json_agg(json_build_object(
+            'id', q.id,
+            'pack_id', q.pack_id,
+            'text', q.text,
+            'image_url', COALESCE(q.image_url, ''),
+            'variants', COALESCE((
+                SELECT json_agg(json_build_object(
+                    'id', v.id,
+                    'question_id', v.question_id,
+                    'text', v.text,
+                    'is_correct', v.is_correct
+                ) ORDER BY v.id)
+                FROM quiz.variants v
+                WHERE v.question_id = q.id
+            ), '[]')
+        ) ORDER BY q.id)
+        FROM quiz.questions q
+        WHERE q.pack_id = p.id
+    ), '[]')
+)::TEXT
+FROM quiz.packs p
+WHERE p.id = $1;
@@ -0,0 +1,3 @@
+SELECT version
+FROM quiz.packs
+WHERE id = $1;
@@ -0,0 +1,4 @@
+SELECT p.id, COALESCE(s.answers, 0), encode(s.players, 'hex')
+FROM quiz.packs p
+LEFT JOIN quiz.pack_stats s ON s.pack_id = p.id
+WHERE p.id = $1;
@@ -0,0 +1,3 @@
+SELECT pack_id, encode(players, 'hex')
+FROM quiz.pack_stats
+WHERE pack_id = ANY($1);
@@ -0,0 +1,3 @@
+SELECT pack_id, version, title, questions, variants
+FROM quiz.pack_versions
+WHERE pack_id = $1 AND version = $2;
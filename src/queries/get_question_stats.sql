@@ -0,0 +1,8 @@
+SELECT
+    q.id,
+    COALESCE(s.attempts, 0),
+    COALESCE(s.correct, 0),
+    encode(s.players, 'hex')
+FROM quiz.questions q
+LEFT JOIN quiz.question_stats s ON s.question_id = q.id
+WHERE q.id = $1;
@@ -0,0 +1,3 @@
+SELECT question_id, encode(players, 'hex')
+FROM quiz.question_stats
+WHERE question_id = ANY($1);
@@ -0,0 +1,11 @@
+SELECT COALESCE(
+    json_agg(json_build_object(
+        'id', id,
+        'pack_id', pack_id,
+        'text', text,
+        'image_url', COALESCE(image_url, '')
+    )),
+    '[]'
+)::TEXT
+FROM quiz.questions
+WHERE pack_id = $1;
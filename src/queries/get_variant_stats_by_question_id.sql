@@ -0,0 +1,5 @@
+SELECT v.id, COALESCE(s.picks, 0)
+FROM quiz.variants v
+LEFT JOIN quiz.variant_stats s ON s.variant_id = v.id
+WHERE v.question_id = $1
+ORDER BY v.id;
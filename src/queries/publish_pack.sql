@@ -0,0 +1,26 @@
+WITH pack AS (
+    UPDATE quiz.packs
+    SET version = version + 1
+    WHERE id = $1
+    RETURNING id, version, title
+)
+INSERT INTO quiz.pack_versions (pack_id, version, title, questions, variants)
+SELECT
+    pack.id,
+    pack.version,
+    pack.title,
+    ARRAY(
+        SELECT ROW(q.id, q.pack_id, q.text, q.image_url)::quiz.question
+        FROM quiz.questions q
+        WHERE q.pack_id = pack.id
+        ORDER BY q.id
+    ),
+    ARRAY(
+        SELECT ROW(v.id, v.question_id, v.text, v.is_correct)::quiz.variant
+        FROM quiz.variants v
+        JOIN quiz.questions q ON q.id = v.question_id
+        WHERE q.pack_id = pack.id
+        ORDER BY v.question_id, v.id
+    )
+FROM pack
+RETURNING pack_id, version, title, questions, variants;
@@ -0,0 +1,8 @@
+INSERT INTO quiz.pack_stats (pack_id, answers, players)
+SELECT delta.pack_id, delta.answers, decode(delta.players, 'hex')
+FROM unnest($1::UUID[], $2::BIGINT[], $3::TEXT[])
+    AS delta(pack_id, answers, players)
+ON CONFLICT (pack_id) DO UPDATE
+SET
+    answers = quiz.pack_stats.answers + EXCLUDED.answers,
+    players = EXCLUDED.players;
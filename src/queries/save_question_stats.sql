@@ -0,0 +1,13 @@
+INSERT INTO quiz.question_stats (question_id, attempts, correct, players)
+SELECT
+    delta.question_id,
+    delta.attempts,
+    delta.correct,
+    decode(delta.players, 'hex')
+FROM unnest($1::UUID[], $2::BIGINT[], $3::BIGINT[], $4::TEXT[])
+    AS delta(question_id, attempts, correct, players)
+ON CONFLICT (question_id) DO UPDATE
+SET
+    attempts = quiz.question_stats.attempts + EXCLUDED.attempts,
+    correct = quiz.question_stats.correct + EXCLUDED.correct,
+    players = EXCLUDED.players;
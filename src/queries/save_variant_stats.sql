@@ -0,0 +1,5 @@
+INSERT INTO quiz.variant_stats (variant_id, picks)
+SELECT delta.variant_id, delta.picks
+FROM unnest($1::UUID[], $2::BIGINT[]) AS delta(variant_id, picks)
+ON CONFLICT (variant_id) DO UPDATE
+SET picks = quiz.variant_stats.picks + EXCLUDED.picks;
@@ -0,0 +1,266 @@
+#include "answer_stats.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <sql_queries/sql_queries.hpp>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/cluster_types.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/storages/postgres/io/io_fwd.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+#include <userver/utils/encoding/hex.hpp>
+#include <utility>
+
+#include "utils/deadline.hpp"
+#include "utils/hyper_log_log.hpp"
+
+namespace NStorage {
+
+using namespace sql_queries::sql;
+using userver::storages::postgres::ClusterHostType::kMaster;
+using userver::storages::postgres::ClusterHostType::kSlave;
+
+namespace {
+
+using StoredPlayers = std::unordered_map<
+    boost::uuids::uuid, std::string, boost::hash<boost::uuids::uuid>>;
+
+// Sketches travel to and from Postgres hex-encoded, so no BYTEA arrays are
+// needed
+auto ReadStoredPlayers(
+    userver::storages::postgres::Transaction& trx,
+    const userver::storages::postgres::Query& query,
+    const std::vector<boost::uuids::uuid>& ids
+) -> StoredPlayers {
+    StoredPlayers stored;
+    for (const auto& row : trx.Execute(query, ids)) {
+        auto [id, players] = row.As<boost::uuids::uuid, std::string>();
+        stored.emplace(id, std::move(players));
+    }
+    return stored;
+}
+
+auto MergePlayers(
+    std::string_view players, const StoredPlayers& stored,
+    const boost::uuids::uuid& id
+) -> std::string {
+    Utils::HyperLogLog sketch;
+    if (!sketch.MergeSerialized(players)) {
+        throw std::invalid_argument{"Malformed players sketch in a delta"};
+    }
+    const auto it = stored.find(id);
+    if (it != stored.end()) {
+        // A broken stored sketch is overwritten rather than blocking flushes
+        std::ignore = sketch.MergeSerialized(
+            userver::utils::encoding::FromHex(it->second)
+        );
+    }
+    return userver::utils::encoding::ToHex(sketch.Serialize());
+}
+
+auto EstimatePlayers(const std::optional<std::string>& players)
+    -> std::uint64_t {
+    if (!players) {
+        return 0;
+    }
+    Utils::HyperLogLog sketch;
+    if (!sketch.MergeSerialized(userver::utils::encoding::FromHex(*players))) {
+        return 0;
+    }
+    return sketch.Estimate();
+}
+
+void SaveVariants(
+    userver::storages::postgres::Transaction& trx,
+    const std::vector<Models::VariantStatsDelta>& variants
+) {
+    std::vector<boost::uuids::uuid> ids;
+    std::vector<std::int64_t> picks;
+    for (const auto& variant : variants) {
+        ids.push_back(variant.variant_id);
+        picks.push_back(variant.picks);
+    }
+    trx.Execute(kSaveVariantStats, ids, picks);
+}
+
+void SaveQuestions(
+    userver::storages::postgres::Transaction& trx,
+    const std::vector<Models::QuestionStatsDelta>& questions
+) {
+    std::vector<boost::uuids::uuid> ids;
+    for (const auto& question : questions) {
+        ids.push_back(question.question_id);
+    }
+    const auto stored =
+        ReadStoredPlayers(trx, kGetQuestionStatsPlayers, ids);
+
+    std::vector<std::int64_t> attempts;
+    std::vector<std::int64_t> correct;
+    std::vector<std::string> players;
+    for (const auto& question : questions) {
+        attempts.push_back(question.attempts);
+        correct.push_back(question.correct);
+        players.push_back(
+            MergePlayers(question.players, stored, question.question_id)
+        );
+    }
+    trx.Execute(kSaveQuestionStats, ids, attempts, correct, players);
+}
+
+void SavePacks(
+    userver::storages::postgres::Transaction& trx,
+    const std::vector<Models::PackStatsDelta>& packs
+) {
+    std::vector<boost::uuids::uuid> ids;
+    for (const auto& pack : packs) {
+        ids.push_back(pack.pack_id);
+    }
+    const auto stored = ReadStoredPlayers(trx, kGetPackStatsPlayers, ids);
+
+    std::vector<std::int64_t> answers;
+    std::vector<std::string> players;
+    for (const auto& pack : packs) {
+        answers.push_back(pack.answers);
+        players.push_back(MergePlayers(pack.players, stored, pack.pack_id));
+    }
+    trx.Execute(kSavePackStats, ids, answers, players);
+}
+
+// Any id of the delta, they all live on one shard
+auto GetShardId(const Models::AnswerStatsDelta& shard_delta)
+    -> const boost::uuids::uuid& {
+    if (!shard_delta.packs.empty()) {
+        return shard_delta.packs.front().pack_id;
+    }
+    if (!shard_delta.questions.empty()) {
+        return shard_delta.questions.front().question_id;
+    }
+    return shard_delta.variants.front().variant_id;
+}
+
+} // namespace
+
+auto CheckAnswer(
+    const ShardRouter& shards, const boost::uuids::uuid& variant_id,
+    userver::engine::Deadline deadline
+) -> std::optional<Models::AnswerKey> {
+    const auto& pg_cluster = shards.GetCluster(variant_id);
+    auto result = pg_cluster->Execute(
+        kSlave, Utils::MakeCommandControl(pg_cluster, deadline),
+        kCheckVariantCorrectnessById, variant_id
+    );
+    const auto row = result.AsOptionalSingleRow<
+        std::tuple<boost::uuids::uuid, boost::uuids::uuid, bool>>(
+        userver::storages::postgres::kRowTag
+    );
+    if (!row) {
+        return std::nullopt;
+    }
+    const auto& [question_id, pack_id, is_correct] = *row;
+    return Models::AnswerKey{question_id, pack_id, is_correct};
+}
+
+auto SplitAnswerStatsDelta(
+    const ShardRouter& shards, Models::AnswerStatsDelta delta
+) -> std::vector<Models::AnswerStatsDelta> {
+    const auto shard_count = shards.GetShardCount();
+    std::vector<Models::AnswerStatsDelta> shard_deltas(shard_count);
+    for (auto& pack : delta.packs) {
+        shard_deltas[GetShardOf(pack.pack_id, shard_count)].packs.push_back(
+            std::move(pack)
+        );
+    }
+    for (auto& question : delta.questions) {
+        shard_deltas[GetShardOf(question.question_id, shard_count)]
+            .questions.push_back(std::move(question));
+    }
+    for (auto& variant : delta.variants) {
+        shard_deltas[GetShardOf(variant.variant_id, shard_count)]
+            .variants.push_back(variant);
+    }
+    return shard_deltas;
+}
+
+void SaveAnswerStats(
+    const ShardRouter& shards, const Models::AnswerStatsDelta& shard_delta,
+    userver::engine::Deadline deadline
+) {
+    if (shard_delta.IsEmpty()) {
+        return;
+    }
+
+    const auto& pg_cluster = shards.GetCluster(GetShardId(shard_delta));
+    auto trx = pg_cluster->Begin(
+        "save-answer-stats", userver::storages::postgres::Transaction::RW,
+        Utils::MakeCommandControl(pg_cluster, deadline)
+    );
+    trx.Execute(kLockAnswerStats);
+    if (!shard_delta.variants.empty()) {
+        SaveVariants(trx, shard_delta.variants);
+    }
+    if (!shard_delta.questions.empty()) {
+        SaveQuestions(trx, shard_delta.questions);
+    }
+    if (!shard_delta.packs.empty()) {
+        SavePacks(trx, shard_delta.packs);
+    }
+    trx.Commit();
+}
+
+auto GetQuestionStats(
+    const ShardRouter& shards, const boost::uuids::uuid& question_id,
+    userver::engine::Deadline deadline
+) -> std::optional<Models::QuestionStats> {
+    const auto& pg_cluster = shards.GetCluster(question_id);
+    const auto command_control =
+        Utils::MakeCommandControl(pg_cluster, deadline);
+    auto result = pg_cluster->Execute(
+        kSlave, command_control, kGetQuestionStats, question_id
+    );
+    const auto row = result.AsOptionalSingleRow<std::tuple<
+        boost::uuids::uuid, std::int64_t, std::int64_t,
+        std::optional<std::string>>>(userver::storages::postgres::kRowTag);
+    if (!row) {
+        return std::nullopt;
+    }
+
+    const auto& [id, attempts, correct, players] = *row;
+    Models::QuestionStats question_stats{
+        id, attempts, correct, EstimatePlayers(players), {}
+    };
+    auto variants = pg_cluster->Execute(
+        kSlave, command_control, kGetVariantStatsByQuestionId, question_id
+    );
+    for (const auto& variant : variants) {
+        auto [variant_id, picks] =
+            variant.As<boost::uuids::uuid, std::int64_t>();
+        question_stats.variants.push_back({variant_id, picks});
+    }
+    return question_stats;
+}
+
+auto GetPackStats(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline
+) -> std::optional<Models::PackStats> {
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    auto result = pg_cluster->Execute(
+        kSlave, Utils::MakeCommandControl(pg_cluster, deadline),
+        kGetPackStats, pack_id
+    );
+    const auto row = result.AsOptionalSingleRow<std::tuple<
+        boost::uuids::uuid, std::int64_t, std::optional<std::string>>>(
+        userver::storages::postgres::kRowTag
+    );
+    if (!row) {
+        return std::nullopt;
+    }
+
+    const auto& [id, answers, players] = *row;
+    return Models::PackStats{id, answers, EstimatePlayers(players)};
+}
+
+} // namespace NStorage
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+#include <userver/engine/deadline.hpp>
+
+#include "models/answer_stats.hpp"
+#include "storage/shard_router.hpp"
+
+namespace NStorage {
+
+// Returns std::nullopt if there is no such variant
+auto CheckAnswer(
+    const ShardRouter& shards, const boost::uuids::uuid& variant_id,
+    userver::engine::Deadline deadline = {}
+) -> std::optional<Models::AnswerKey>;
+
+// Splits the delta into one per shard, some of them may be empty
+auto SplitAnswerStatsDelta(
+    const ShardRouter& shards, Models::AnswerStatsDelta delta
+) -> std::vector<Models::AnswerStatsDelta>;
+
+// Adds counters of a single shard delta to the stored ones and merges unique
+// player sketches in one transaction. Transactions are serialized with the
+// other instances by an advisory lock, so sketches are never lost to a
+// concurrent read-merge-write.
+void SaveAnswerStats(
+    const ShardRouter& shards, const Models::AnswerStatsDelta& shard_delta,
+    userver::engine::Deadline deadline = {}
+);
+
+// Returns std::nullopt if there is no such question
+auto GetQuestionStats(
+    const ShardRouter& shards, const boost::uuids::uuid& question_id,
+    userver::engine::Deadline deadline = {}
+) -> std::optional<Models::QuestionStats>;
+
+// Returns std::nullopt if there is no such pack
+auto GetPackStats(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline = {}
+) -> std::optional<Models::PackStats>;
+
+} // namespace NStorage
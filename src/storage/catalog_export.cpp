@@ -0,0 +1,84 @@
+#include "catalog_export.hpp"
+
+#include <cstdint>
+#include <sql_queries/sql_queries.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/cluster_types.hpp>
+#include <userver/storages/postgres/portal.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+#include "utils/deadline.hpp"
+
+namespace NStorage {
+
+using userver::storages::postgres::ClusterPtr;
+using userver::storages::postgres::ResultSet;
+using userver::storages::postgres::Transaction;
+using namespace sql_queries::sql;
+using userver::storages::postgres::ClusterHostType::kSlave;
+
+namespace {
+
+constexpr std::uint32_t kPacksPerFetch = 64;
+
+void ExportShard(
+    const ClusterPtr& pg_cluster, const CatalogExportFilter& filter,
+    const CatalogExportSink& sink, userver::engine::Deadline deadline
+) {
+    auto trx = pg_cluster->Begin(
+        "export-catalog", kSlave, Transaction::RO,
+        Utils::MakeCommandControl(pg_cluster, deadline)
+    );
+
+    const auto export_packs = [&](const ResultSet& result) {
+        const auto packs = result.AsContainer<
+            std::vector<Models::ExportedPack>>(
+            userver::storages::postgres::kRowTag
+        );
+        for (const auto& pack : packs) {
+            auto rows = trx.Execute(
+                Utils::MakeCommandControl(pg_cluster, deadline),
+                kExportPackRows, pack.id
+            );
+            sink(
+                pack,
+                rows.AsContainer<std::vector<Models::ExportedQuestionRow>>(
+                    userver::storages::postgres::kRowTag
+                )
+            );
+        }
+    };
+
+    if (filter.pack_id) {
+        export_packs(
+            trx.Execute(kExportPack, *filter.pack_id, filter.modified_since)
+        );
+    } else {
+        auto portal = trx.MakePortal(kExportPacks, filter.modified_since);
+        while (!portal.Done()) {
+            // Fetches run with the timeouts the transaction began with
+            if (deadline.IsReached()) {
+                throw Utils::DeadlineExceeded("Request deadline exceeded");
+            }
+            export_packs(portal.Fetch(kPacksPerFetch));
+        }
+    }
+    trx.Commit();
+}
+
+} // namespace
+
+void ExportCatalog(
+    const ShardRouter& shards, const CatalogExportFilter& filter,
+    const CatalogExportSink& sink, userver::engine::Deadline deadline
+) {
+    if (filter.pack_id) {
+        ExportShard(shards.GetCluster(*filter.pack_id), filter, sink, deadline);
+        return;
+    }
+    for (const auto& pg_cluster : shards.GetAll()) {
+        ExportShard(pg_cluster, filter, sink, deadline);
+    }
+}
+
+} // namespace NStorage
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <functional>
+#include <optional>
+#include <userver/engine/deadline.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <vector>
+
+#include "models/catalog_export.hpp"
+#include "storage/shard_router.hpp"
+
+namespace NStorage {
+
+struct CatalogExportFilter final {
+    // Only this pack, from the shard that owns it
+    std::optional<boost::uuids::uuid> pack_id;
+    // Only packs changed (with their questions and variants) at or after it
+    std::optional<userver::storages::postgres::TimePointTz> modified_since;
+};
+
+// Receives every exported pack with all its rows ordered by question
+using CatalogExportSink = std::function<void(
+    const Models::ExportedPack&, const std::vector<Models::ExportedQuestionRow>&
+)>;
+
+// Walks the catalog shard after shard, each in a read-only transaction on a
+// replica: packs are fetched from a cursor in small batches and the rows of
+// each pack are read right before it is handed to `sink`. Memory is bounded
+// by one batch of packs plus one pack's rows whatever the catalog size, and
+// a slow `sink` just keeps the cursor waiting.
+//
+// Packs are ordered by updated_at within a shard; shards are not merged.
+// An exception thrown by `sink` aborts the export.
+void ExportCatalog(
+    const ShardRouter& shards, const CatalogExportFilter& filter,
+    const CatalogExportSink& sink, userver::engine::Deadline deadline = {}
+);
+
+} // namespace NStorage
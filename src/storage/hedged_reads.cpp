@@ -0,0 +1,34 @@
+#include "hedged_reads.hpp"
+
+#include <mutex>
+
+namespace NStorage {
+
+using userver::storages::postgres::ClusterHostType;
+
+const ClusterHostTypeFlags HedgedReads::kPrimaryHost{ClusterHostType::kSlave};
+const ClusterHostTypeFlags HedgedReads::kHedgeHost =
+    ClusterHostTypeFlags{ClusterHostType::kSlave} |
+    ClusterHostType::kRoundRobin;
+
+HedgedReads::HedgedReads(const HedgingSettings& settings)
+    : settings_(settings),
+      budget_(settings.budget_ratio, settings.budget_burst) {}
+
+auto HedgedReads::GetDelay(std::string_view name) const -> Utils::HedgeDelay& {
+    const std::lock_guard lock{delays_mutex_};
+    auto& delay = delays_[name];
+    if (!delay) {
+        delay = std::make_unique<Utils::HedgeDelay>(settings_.delay);
+    }
+    return *delay;
+}
+
+auto HedgedReads::Since(Clock::time_point started_at)
+    -> std::chrono::microseconds {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - started_at
+    );
+}
+
+} // namespace NStorage
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/storages/postgres/cluster_types.hpp>
+#include <userver/utils/async.hpp>
+
+#include "utils/hedging.hpp"
+
+namespace NStorage {
+
+using userver::storages::postgres::ClusterHostTypeFlags;
+
+struct HedgingSettings final {
+    bool enabled = false;
+    Utils::HedgeDelaySettings delay;
+    // Share of reads that may be hedged, and how many hedges may be saved up
+    double budget_ratio = 0.05;
+    double budget_burst = 10;
+};
+
+// Hedged replica reads. A read goes to a replica as usual; if it has not
+// returned after the hedge delay of its kind (a percentile of its recent
+// latency), the same read is sent once more with round-robin host
+// selection, which with several replicas usually picks another one. The
+// first answer wins and the other read is cancelled. Hedges are limited by
+// a global HedgeBudget.
+//
+// Only for idempotent reads: both attempts may run to completion.
+class HedgedReads final {
+public:
+    explicit HedgedReads(const HedgingSettings& settings);
+
+    // Calls `read` with the host type to run on. `name` identifies the kind
+    // of read for latency tracking and must outlive the process, a string
+    // literal is expected.
+    template <typename Read>
+    auto Execute(std::string_view name, const Read& read) const
+        -> std::invoke_result_t<const Read&, ClusterHostTypeFlags>;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    [[nodiscard]] auto GetDelay(std::string_view name) const
+        -> Utils::HedgeDelay&;
+
+    static auto Since(Clock::time_point started_at)
+        -> std::chrono::microseconds;
+
+    static const ClusterHostTypeFlags kPrimaryHost;
+    static const ClusterHostTypeFlags kHedgeHost;
+
+    const HedgingSettings settings_;
+    // Thread-safe inside, so hedging is logically const
+    mutable Utils::HedgeBudget budget_;
+    mutable userver::engine::Mutex delays_mutex_;
+    mutable std::unordered_map<
+        std::string_view, std::unique_ptr<Utils::HedgeDelay>>
+        delays_;
+};
+
+template <typename Read>
+auto HedgedReads::Execute(std::string_view name, const Read& read) const
+    -> std::invoke_result_t<const Read&, ClusterHostTypeFlags> {
+    if (!settings_.enabled) {
+        return read(kPrimaryHost);
+    }
+
+    auto& delay = GetDelay(name);
+    budget_.OnRequest();
+    const auto started_at = Clock::now();
+
+    // Both tasks are finished or cancelled before returning, so capturing
+    // by reference is safe
+    auto primary = userver::utils::Async(std::string{name}, [&read] {
+        return read(kPrimaryHost);
+    });
+    primary.WaitFor(delay.Get());
+    if (primary.IsFinished() || !budget_.TryHedge()) {
+        auto result = primary.Get();
+        delay.Record(Since(started_at));
+        return result;
+    }
+
+    auto hedge = userver::utils::Async(std::string{name} + "-hedge", [&read] {
+        return read(kHedgeHost);
+    });
+    const auto first = userver::engine::WaitAny(primary, hedge);
+    if (!first) {
+        // Cancelled, Get() throws the appropriate exception
+        return primary.Get();
+    }
+
+    auto& winner = *first == 0 ? primary : hedge;
+    auto& loser = *first == 0 ? hedge : primary;
+    // When the hedge wins this underestimates the primary's latency, but
+    // never below the current delay
+    delay.Record(Since(started_at));
+    try {
+        auto result = winner.Get();
+        loser.RequestCancel();
+        return result;
+    } catch (const std::exception&) {
+        // One host failing is exactly what the other attempt is for
+        return loser.Get();
+    }
+}
+
+} // namespace NStorage
@@ -0,0 +1,124 @@
+#include "pack_versions.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <sql_queries/sql_queries.hpp>
+#include <utility>
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/cluster_types.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/storages/postgres/io/io_fwd.hpp>
+
+#include "utils/deadline.hpp"
+#include "utils/single_flight.hpp"
+
+namespace NStorage {
+
+using namespace sql_queries::sql;
+using userver::storages::postgres::ClusterHostType::kMaster;
+
+namespace {
+
+using PackVersionKey = std::pair<boost::uuids::uuid, std::int32_t>;
+using PackVersionCache = userver::cache::NWayLRU<
+    PackVersionKey, PackVersionPtr, boost::hash<PackVersionKey>>;
+using PackVersionFlight = Utils::SingleFlight<
+    PackVersionKey, PackVersionPtr, boost::hash<PackVersionKey>>;
+
+constexpr std::size_t kCacheWays = 16;
+constexpr std::size_t kCacheWaySize = 256;
+
+auto GetCache() -> PackVersionCache& {
+    static PackVersionCache cache{kCacheWays, kCacheWaySize};
+    return cache;
+}
+
+auto MakePackVersionPtr(std::optional<Models::PackVersion>&& pack_version)
+    -> PackVersionPtr {
+    if (!pack_version) {
+        return nullptr;
+    }
+    return std::make_shared<const Models::CompactPackVersion>(*pack_version);
+}
+
+} // namespace
+
+auto PublishPack(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline
+) -> PackVersionPtr {
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    auto result = pg_cluster->Execute(
+        kMaster, Utils::MakeCommandControl(pg_cluster, deadline),
+        kPublishPack, pack_id
+    );
+    auto published = MakePackVersionPtr(
+        result.AsOptionalSingleRow<Models::PackVersion>(
+            userver::storages::postgres::kRowTag
+        )
+    );
+    if (published) {
+        GetCache().Put({pack_id, published->GetVersion()}, published);
+    }
+    return published;
+}
+
+auto GetPackVersion(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    std::int32_t version, userver::engine::Deadline deadline
+) -> PackVersionPtr {
+    const PackVersionKey key{pack_id, version};
+    if (auto cached = GetCache().Get(key)) {
+        return *std::move(cached);
+    }
+
+    static PackVersionFlight flight{"get-pack-version"};
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    // Shared by everyone asking for the version, so the query runs with the
+    // default timeouts and only the wait is bounded by our deadline
+    auto pack_version = flight.Execute(key, deadline, [pg_cluster, key] {
+        // Every version is read once per instance, so the master is cheap
+        // and saves us from replica lag right after publishing
+        auto result = pg_cluster->Execute(
+            kMaster, kGetPackVersion, key.first, key.second
+        );
+        return MakePackVersionPtr(
+            result.AsOptionalSingleRow<Models::PackVersion>(
+                userver::storages::postgres::kRowTag
+            )
+        );
+    });
+
+    if (pack_version) {
+        GetCache().Put(key, pack_version);
+    }
+    return pack_version;
+}
+
+auto GetLatestPackVersion(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline
+) -> PackVersionPtr {
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    auto result = pg_cluster->Execute(
+        kMaster, Utils::MakeCommandControl(pg_cluster, deadline),
+        kGetPackLatestVersion, pack_id
+    );
+    const auto version = result.AsOptionalSingleRow<std::int32_t>();
+    if (!version || *version == 0) {
+        return nullptr;
+    }
+    return GetPackVersion(shards, pack_id, *version, deadline);
+}
+
+auto GetPackVersion(
+    const ShardRouter& shards, const Models::PackVersionRef& ref,
+    userver::engine::Deadline deadline
+) -> PackVersionPtr {
+    if (ref.version) {
+        return GetPackVersion(shards, ref.pack_id, *ref.version, deadline);
+    }
+    return GetLatestPackVersion(shards, ref.pack_id, deadline);
+}
+
+} // namespace NStorage
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <userver/engine/deadline.hpp>
+
+#include "models/compact_pack_version.hpp"
+#include "models/pack_version.hpp"
+#include "storage/shard_router.hpp"
+
+namespace NStorage {
+
+// Versions are kept in the compact read-only layout, both in the cache and
+// when handed out
+using PackVersionPtr = std::shared_ptr<const Models::CompactPackVersion>;
+
+// Snapshots the current draft of the pack as its next version. Returns
+// nullptr if there is no such pack.
+auto PublishPack(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline = {}
+) -> PackVersionPtr;
+
+// Published versions never change and outlive their pack, so they are
+// cached in-process with no TTL and no invalidation, only evicted by LRU.
+// Returns nullptr if there is no such version.
+auto GetPackVersion(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    std::int32_t version, userver::engine::Deadline deadline = {}
+) -> PackVersionPtr;
+
+// Reads the number of the latest published version, a primary key lookup,
+// then serves it like GetPackVersion. Returns nullptr if the pack does not
+// exist or has never been published.
+auto GetLatestPackVersion(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline = {}
+) -> PackVersionPtr;
+
+// Serves GetPackVersion or GetLatestPackVersion depending on whether the
+// reference names a version.
+auto GetPackVersion(
+    const ShardRouter& shards, const Models::PackVersionRef& ref,
+    userver::engine::Deadline deadline = {}
+) -> PackVersionPtr;
+
+} // namespace NStorage
@@ -1,41 +1,226 @@
 #include "packs.hpp"
 
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <iterator>
 #include <sql_queries/sql_queries.hpp>
+#include <string>
+#include <tuple>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/component.hpp>
 #include <userver/storages/postgres/io/io_fwd.hpp>
+#include <userver/utils/async.hpp>
+#include <utility>
+#include <variant>
 
 #include "models/pack.hpp"
+#include "utils/deadline.hpp"
+#include "utils/single_flight.hpp"
 
 namespace NStorage {
 
 using userver::storages::postgres::ClusterPtr;
+using userver::storages::postgres::OptionalCommandControl;
 using namespace sql_queries::sql;
 using userver::storages::postgres::ClusterHostType::kMaster;
 using userver::storages::postgres::ClusterHostType::kSlave;
 
-auto CreatePack(ClusterPtr pg_cluster_, const std::string& title)
-    -> std::optional<Models::Pack> {
+namespace {
+
+using PackByIdFlight = Utils::SingleFlight<
+    boost::uuids::uuid, std::optional<Models::Pack>,
+    boost::hash<boost::uuids::uuid>>;
+using AllPacksFlight =
+    Utils::SingleFlight<std::monostate, std::vector<Models::Pack>>;
+using AllPacksJsonFlight = Utils::SingleFlight<std::monostate, std::string>;
+
+// Runs `query` on every shard concurrently and concatenates the rows
+template <typename Row>
+auto ExecuteOnAllShards(
+    const std::vector<ClusterPtr>& clusters,
+    const userver::storages::postgres::Query& query
+) -> std::vector<Row> {
+    std::vector<userver::engine::TaskWithResult<std::vector<Row>>> tasks;
+    tasks.reserve(clusters.size());
+    for (const auto& pg_cluster : clusters) {
+        tasks.push_back(userver::utils::Async(
+            "query-all-shards",
+            [pg_cluster, &query] {
+                auto result = pg_cluster->Execute(kSlave, query);
+                return result.AsContainer<std::vector<Row>>(
+                    userver::storages::postgres::kRowTag
+                );
+            }
+        ));
+    }
+
+    std::vector<Row> rows;
+    for (auto& task : tasks) {
+        auto shard_rows = task.Get();
+        rows.insert(
+            rows.end(), std::make_move_iterator(shard_rows.begin()),
+            std::make_move_iterator(shard_rows.end())
+        );
+    }
+    return rows;
+}
+
+} // namespace
+
+auto CreatePack(
+    const ShardRouter& shards, const std::string& title,
+    userver::engine::Deadline deadline
+) -> std::optional<Models::Pack> {
     // TODO: handle empty title
-    auto result = pg_cluster_->Execute(kMaster, kCreatePack, title);
+    const auto pack_id = ShardRouter::MakeId();
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    auto result = pg_cluster->Execute(
+        kMaster, Utils::MakeCommandControl(pg_cluster, deadline), kCreatePack,
+        pack_id, title
+    );
     return result.AsOptionalSingleRow<Models::Pack>(
         userver::storages::postgres::kRowTag
     );
 }
 
-auto GetPackById(ClusterPtr pg_cluster_, const boost::uuids::uuid& pack_id)
-    -> std::optional<Models::Pack> {
-    auto result = pg_cluster_->Execute(kMaster, kGetPackById, pack_id);
+auto GetPackById(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline
+) -> std::optional<Models::Pack> {
+    static PackByIdFlight flight{"get-pack-by-id"};
+    auto& stale = shards.GetStaleStores().pack_by_id;
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    // The query is shared by everyone asking for the pack, so it runs with
+    // the default timeouts and each caller only waits as long as it may
+    return shards.GetStaleFallback().Read(
+        stale, pack_id, &shards.GetBreaker(pack_id), std::nullopt, deadline,
+        [pg_cluster, pack_id](
+            const OptionalCommandControl& /*command_control*/,
+            userver::engine::Deadline wait_deadline
+        ) {
+            return flight.Execute(
+                pack_id, wait_deadline,
+                [pg_cluster, pack_id] {
+                    auto result =
+                        pg_cluster->Execute(kMaster, kGetPackById, pack_id);
+                    return result.AsOptionalSingleRow<Models::Pack>(
+                        userver::storages::postgres::kRowTag
+                    );
+                }
+            );
+        }
+    );
+}
+
+auto GetAllPacks(const ShardRouter& shards, userver::engine::Deadline deadline)
+    -> std::vector<Models::Pack> {
+    static AllPacksFlight flight{"get-all-packs"};
+    auto& stale = shards.GetStaleStores().all_packs;
+    // Spans all shards, so there is no single breaker to consult
+    return shards.GetStaleFallback().Read(
+        stale, {}, nullptr, std::nullopt, deadline,
+        [clusters = shards.GetAll()](
+            const OptionalCommandControl& /*command_control*/,
+            userver::engine::Deadline wait_deadline
+        ) {
+            return flight.Execute({}, wait_deadline, [clusters] {
+                auto packs =
+                    ExecuteOnAllShards<Models::Pack>(clusters, kGetAllPacks);
+                // Every shard returns its packs ordered by title already
+                std::ranges::stable_sort(packs, {}, &Models::Pack::title);
+                return packs;
+            });
+        }
+    );
+}
+
+auto GetAllPacksJson(
+    const ShardRouter& shards, userver::engine::Deadline deadline
+) -> std::string {
+    static AllPacksJsonFlight flight{"get-all-packs-json"};
+    auto& stale = shards.GetStaleStores().all_packs_json;
+    return shards.GetStaleFallback().Read(
+        stale, {}, nullptr, std::nullopt, deadline,
+        [clusters = shards.GetAll()](
+            const OptionalCommandControl& /*command_control*/,
+            userver::engine::Deadline wait_deadline
+        ) {
+            return flight.Execute({}, wait_deadline, [clusters] {
+                // Postgres renders every pack, only the shards are merged here
+                using TitleAndJson = std::tuple<std::string, std::string>;
+                auto packs = ExecuteOnAllShards<TitleAndJson>(
+                    clusters, kGetAllPacksJson
+                );
+                std::ranges::stable_sort(packs, {}, [](const auto& pack) {
+                    return std::get<0>(pack);
+                });
+
+                std::size_t size = 2;
+                for (const auto& pack : packs) {
+                    size += std::get<1>(pack).size() + 1;
+                }
+                std::string body;
+                body.reserve(size);
+                body += '[';
+                for (const auto& pack : packs) {
+                    if (body.size() > 1) {
+                        body += ',';
+                    }
+                    body += std::get<1>(pack);
+                }
+                body += ']';
+                return body;
+            });
+        }
+    );
+}
+
+auto GetPackContentJson(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline
+) -> std::optional<std::string> {
+    auto& stale = shards.GetStaleStores().pack_content_json;
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    return shards.GetStaleFallback().Read(
+        stale, pack_id, &shards.GetBreaker(pack_id),
+        Utils::MakeCommandControl(pg_cluster, deadline), deadline,
+        [pg_cluster, pack_id](
+            const OptionalCommandControl& command_control,
+            userver::engine::Deadline /*deadline*/
+        ) {
+            auto result = pg_cluster->Execute(
+                kSlave, command_control, kGetPackContentJson, pack_id
+            );
+            return result.AsOptionalSingleRow<std::string>();
+        }
+    );
+}
+
+auto UpdatePackTitle(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    const std::string& title, userver::engine::Deadline deadline
+) -> std::optional<Models::Pack> {
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    auto result = pg_cluster->Execute(
+        kMaster, Utils::MakeCommandControl(pg_cluster, deadline),
+        kUpdatePackTitle, pack_id, title
+    );
     return result.AsOptionalSingleRow<Models::Pack>(
         userver::storages::postgres::kRowTag
     );
 }
 
-auto GetAllPacks(ClusterPtr pg_cluster_) -> std::vector<Models::Pack> {
-    auto result = pg_cluster_->Execute(kSlave, kGetAllPacks);
-    return result.AsContainer<std::vector<Models::Pack>>(
-        userver::storages::postgres::kRowTag
+auto DeletePack(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline
+) -> bool {
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    auto result = pg_cluster->Execute(
+        kMaster, Utils::MakeCommandControl(pg_cluster, deadline), kDeletePack,
+        pack_id
     );
+    return result.RowsAffected() != 0;
 }
 
 } // namespace NStorage
@@ -1,21 +1,68 @@
 #pragma once
 
+#include <optional>
+#include <string>
+#include <userver/engine/deadline.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 
 #include "models/pack.hpp"
+#include "storage/shard_router.hpp"
 
 namespace NStorage {
 
-using userver::storages::postgres::ClusterPtr;
 using userver::storages::postgres::ResultSet;
 
-auto CreatePack(ClusterPtr pg_cluster_, const std::string& title)
-    -> std::optional<Models::Pack>;
+// Every function takes the deadline of the request it serves: query timeouts
+// are shrunk to fit into it and Utils::DeadlineExceeded is thrown instead of
+// querying once it is reached. Reads shared by concurrent callers keep the
+// default timeouts, and each caller stops waiting at its own deadline.
+//
+// Queries by id go to the shard that owns the id, see ShardRouter.
 
-auto GetPackById(ClusterPtr pg_cluster_, const boost::uuids::uuid& pack_id)
-    -> std::optional<Models::Pack>;
+auto CreatePack(
+    const ShardRouter& shards, const std::string& title,
+    userver::engine::Deadline deadline = {}
+) -> std::optional<Models::Pack>;
 
-auto GetAllPacks(ClusterPtr pg_cluster_) -> std::vector<Models::Pack>;
+auto GetPackById(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline = {}
+) -> std::optional<Models::Pack>;
+
+// Queries all shards concurrently, the result is ordered by title
+auto GetAllPacks(
+    const ShardRouter& shards, userver::engine::Deadline deadline = {}
+) -> std::vector<Models::Pack>;
+
+// The *Json reads return response bodies rendered by Postgres with
+// json_build_object/json_agg, so handlers pass them through as is instead
+// of decoding rows into models and serializing those again. The JSON is the
+// same Serialize would produce, apart from whitespace.
+
+// GetAllPacks as a JSON array
+auto GetAllPacksJson(
+    const ShardRouter& shards, userver::engine::Deadline deadline = {}
+) -> std::string;
+
+// The draft pack with all its questions, each with nested variants.
+// Returns std::nullopt if there is no such pack.
+auto GetPackContentJson(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline = {}
+) -> std::optional<std::string>;
+
+// Returns std::nullopt if there is no such pack
+auto UpdatePackTitle(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    const std::string& title, userver::engine::Deadline deadline = {}
+) -> std::optional<Models::Pack>;
+
+// Deletes the draft of the pack with all its questions and variants, its
+// published versions stay. Returns false if there is no such pack.
+auto DeletePack(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline = {}
+) -> bool;
 
 } // namespace NStorage
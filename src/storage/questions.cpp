@@ -1,44 +1,180 @@
 #include "questions.hpp"
 
+#include <boost/functional/hash.hpp>
 #include <sql_queries/sql_queries.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/component.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
 #include <userver/storages/postgres/io/io_fwd.hpp>
 
+#include "utils/deadline.hpp"
+#include "utils/single_flight.hpp"
+
 namespace NStorage {
 
 using userver::storages::postgres::ClusterPtr;
 using namespace sql_queries::sql;
 using userver::storages::postgres::ClusterHostType::kMaster;
-using userver::storages::postgres::ClusterHostType::kSlave;
+using userver::storages::postgres::ClusterHostTypeFlags;
+
+namespace {
+
+using QuestionByIdFlight = Utils::SingleFlight<
+    boost::uuids::uuid, std::optional<Models::Question>,
+    boost::hash<boost::uuids::uuid>>;
+using QuestionsByPackIdFlight = Utils::SingleFlight<
+    boost::uuids::uuid, std::vector<Models::Question>,
+    boost::hash<boost::uuids::uuid>>;
+using QuestionsByPackIdJsonFlight = Utils::SingleFlight<
+    boost::uuids::uuid, std::string, boost::hash<boost::uuids::uuid>>;
+
+} // namespace
 
 auto CreateQuestion(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& pack_id,
-    const std::string& text, const std::string& image_url
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    const std::string& text, const std::string& image_url,
+    userver::engine::Deadline deadline
 ) -> std::optional<Models::Question> {
-    auto result = pg_cluster_->Execute(
-        kMaster, kCreateQuestion, pack_id, text, image_url
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    auto result = pg_cluster->Execute(
+        kMaster, Utils::MakeCommandControl(pg_cluster, deadline),
+        kCreateQuestion, shards.MakeIdNextTo(pack_id), pack_id, text, image_url
     );
     return result.AsOptionalSingleRow<Models::Question>(
         userver::storages::postgres::kRowTag
     );
 }
 
+auto CreateQuestionWithVariants(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    const std::string& text, const std::string& image_url,
+    const std::vector<Models::VariantDraft>& variants,
+    userver::engine::Deadline deadline
+) -> std::optional<Models::QuestionWithVariants> {
+    const auto question_id = shards.MakeIdNextTo(pack_id);
+
+    // A single array of rows: separate arrays per column could disagree in
+    // length, and unnest would pad the shorter ones with NULLs
+    std::vector<Models::Variant> variant_rows;
+    variant_rows.reserve(variants.size());
+    for (const auto& variant : variants) {
+        variant_rows.push_back(
+            {shards.MakeIdNextTo(question_id), question_id, variant.text,
+             variant.is_correct}
+        );
+    }
+
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    auto result = pg_cluster->Execute(
+        kMaster, Utils::MakeCommandControl(pg_cluster, deadline),
+        kCreateQuestionWithVariants, question_id, pack_id, text, image_url,
+        variant_rows
+    );
+    return result.AsOptionalSingleRow<Models::QuestionWithVariants>(
+        userver::storages::postgres::kRowTag
+    );
+}
+
 auto GetQuestionById(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& question_id
+    const ShardRouter& shards, const boost::uuids::uuid& question_id,
+    userver::engine::Deadline deadline
 ) -> std::optional<Models::Question> {
-    auto result = pg_cluster_->Execute(kSlave, kGetQuestionById, question_id);
-    return result.AsOptionalSingleRow<Models::Question>(
-        userver::storages::postgres::kRowTag
+    static QuestionByIdFlight flight{"get-question-by-id"};
+    auto& stale = shards.GetStaleStores().question_by_id;
+    const auto& pg_cluster = shards.GetCluster(question_id);
+    const auto* hedged_reads = &shards.GetHedgedReads();
+    return shards.GetStaleFallback().Read(
+        stale, question_id, &shards.GetBreaker(question_id), std::nullopt,
+        deadline,
+        [hedged_reads, pg_cluster, question_id](
+            const OptionalCommandControl& /*command_control*/,
+            userver::engine::Deadline wait_deadline
+        ) {
+            return flight.Execute(
+                question_id, wait_deadline,
+                [hedged_reads, pg_cluster, question_id] {
+                    auto result = hedged_reads->Execute(
+                        "get-question-by-id",
+                        [&](ClusterHostTypeFlags host) {
+                            return pg_cluster->Execute(
+                                host, kGetQuestionById, question_id
+                            );
+                        }
+                    );
+                    return result.AsOptionalSingleRow<Models::Question>(
+                        userver::storages::postgres::kRowTag
+                    );
+                }
+            );
+        }
     );
 }
 
 auto GetQuestionsByPackId(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& pack_id
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline
 ) -> std::vector<Models::Question> {
-    auto result = pg_cluster_->Execute(kSlave, kGetQuestionsByPackId, pack_id);
-    return result.AsContainer<std::vector<Models::Question>>(
-        userver::storages::postgres::kRowTag
+    static QuestionsByPackIdFlight flight{"get-questions-by-pack-id"};
+    auto& stale = shards.GetStaleStores().questions_by_pack_id;
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    const auto* hedged_reads = &shards.GetHedgedReads();
+    return shards.GetStaleFallback().Read(
+        stale, pack_id, &shards.GetBreaker(pack_id), std::nullopt,
+        deadline,
+        [hedged_reads, pg_cluster, pack_id](
+            const OptionalCommandControl& /*command_control*/,
+            userver::engine::Deadline wait_deadline
+        ) {
+            return flight.Execute(
+                pack_id, wait_deadline,
+                [hedged_reads, pg_cluster, pack_id] {
+                    auto result = hedged_reads->Execute(
+                        "get-questions-by-pack-id",
+                        [&](ClusterHostTypeFlags host) {
+                            return pg_cluster->Execute(
+                                host, kGetQuestionsByPackId, pack_id
+                            );
+                        }
+                    );
+                    return result.AsContainer<std::vector<Models::Question>>(
+                        userver::storages::postgres::kRowTag
+                    );
+                }
+            );
+        }
+    );
+}
+
+auto GetQuestionsByPackIdJson(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline
+) -> std::string {
+    static QuestionsByPackIdJsonFlight flight{"get-questions-by-pack-id-json"};
+    auto& stale = shards.GetStaleStores().questions_by_pack_id_json;
+    const auto& pg_cluster = shards.GetCluster(pack_id);
+    const auto* hedged_reads = &shards.GetHedgedReads();
+    return shards.GetStaleFallback().Read(
+        stale, pack_id, &shards.GetBreaker(pack_id), std::nullopt,
+        deadline,
+        [hedged_reads, pg_cluster, pack_id](
+            const OptionalCommandControl& /*command_control*/,
+            userver::engine::Deadline wait_deadline
+        ) {
+            return flight.Execute(
+                pack_id, wait_deadline,
+                [hedged_reads, pg_cluster, pack_id] {
+                    auto result = hedged_reads->Execute(
+                        "get-questions-by-pack-id-json",
+                        [&](ClusterHostTypeFlags host) {
+                            return pg_cluster->Execute(
+                                host, kGetQuestionsByPackIdJson, pack_id
+                            );
+                        }
+                    );
+                    return result.AsSingleRow<std::string>();
+                }
+            );
+        }
     );
 }
 
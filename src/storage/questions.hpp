@@ -1,26 +1,47 @@
 #pragma once
 
+#include <string>
+#include <userver/engine/deadline.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 
 #include "models/question.hpp"
+#include "models/question_with_variants.hpp"
+#include "storage/shard_router.hpp"
 
 namespace NStorage {
 
-using userver::storages::postgres::ClusterPtr;
 using userver::storages::postgres::ResultSet;
 
 auto CreateQuestion(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& pack_id,
-    const std::string& text, const std::string& image_url
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    const std::string& text, const std::string& image_url,
+    userver::engine::Deadline deadline = {}
 ) -> std::optional<Models::Question>;
 
+// Stores the question and all its variants with a single data-modifying
+// statement, i.e. in one round trip and one transaction
+auto CreateQuestionWithVariants(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    const std::string& text, const std::string& image_url,
+    const std::vector<Models::VariantDraft>& variants,
+    userver::engine::Deadline deadline = {}
+) -> std::optional<Models::QuestionWithVariants>;
+
 auto GetQuestionById(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& question_id
+    const ShardRouter& shards, const boost::uuids::uuid& question_id,
+    userver::engine::Deadline deadline = {}
 ) -> std::optional<Models::Question>;
 
 auto GetQuestionsByPackId(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& pack_id
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline = {}
 ) -> std::vector<Models::Question>;
 
+// GetQuestionsByPackId as a JSON array, see GetAllPacksJson
+auto GetQuestionsByPackIdJson(
+    const ShardRouter& shards, const boost::uuids::uuid& pack_id,
+    userver::engine::Deadline deadline = {}
+) -> std::string;
+
 } // namespace NStorage
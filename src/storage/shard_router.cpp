@@ -0,0 +1,99 @@
+#include "shard_router.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "utils/hash.hpp"
+#include "utils/uuid_v7.hpp"
+
+namespace NStorage {
+
+namespace {
+
+auto ReadBigEndian(const boost::uuids::uuid& id, std::size_t offset)
+    -> std::uint64_t {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        value = (value << 8) | id.data[offset + i];
+    }
+    return value;
+}
+
+} // namespace
+
+auto GetShardOf(const boost::uuids::uuid& id, std::size_t shard_count)
+    -> std::size_t {
+    // Mixing spreads ids with a common prefix, e.g. time-ordered ones
+    const auto hash = Utils::Mix64(
+        ReadBigEndian(id, 0) ^ Utils::Mix64(ReadBigEndian(id, 8))
+    );
+    return static_cast<std::size_t>(hash % shard_count);
+}
+
+ShardRouter::ShardRouter(
+    std::vector<ClusterPtr> shards, const HedgingSettings& hedging,
+    const StaleFallbackSettings& stale_fallback
+)
+    : shards_(std::move(shards)),
+      stale_stores_(std::make_unique<StaleStores>()),
+      hedged_reads_(std::make_unique<HedgedReads>(hedging)),
+      stale_fallback_(std::make_unique<StaleFallback>(stale_fallback)) {
+    if (shards_.empty()) {
+        throw std::invalid_argument("ShardRouter needs at least one shard");
+    }
+    breakers_.reserve(shards_.size());
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        breakers_.push_back(
+            std::make_unique<Utils::CircuitBreaker>(stale_fallback.breaker)
+        );
+    }
+}
+
+auto ShardRouter::GetShardCount() const -> std::size_t {
+    return shards_.size();
+}
+
+auto ShardRouter::GetCluster(const boost::uuids::uuid& id) const
+    -> const ClusterPtr& {
+    return shards_[GetShardOf(id, shards_.size())];
+}
+
+auto ShardRouter::GetAll() const -> const std::vector<ClusterPtr>& {
+    return shards_;
+}
+
+auto ShardRouter::GetHedgedReads() const -> const HedgedReads& {
+    return *hedged_reads_;
+}
+
+auto ShardRouter::GetStaleFallback() const -> const StaleFallback& {
+    return *stale_fallback_;
+}
+
+auto ShardRouter::GetStaleStores() const -> StaleStores& {
+    return *stale_stores_;
+}
+
+auto ShardRouter::GetBreaker(const boost::uuids::uuid& id) const
+    -> Utils::CircuitBreaker& {
+    return *breakers_[GetShardOf(id, shards_.size())];
+}
+
+auto ShardRouter::MakeId() -> boost::uuids::uuid {
+    return Utils::GenerateUuidV7();
+}
+
+auto ShardRouter::MakeIdNextTo(const boost::uuids::uuid& parent_id) const
+    -> boost::uuids::uuid {
+    const auto shard = GetShardOf(parent_id, shards_.size());
+    // Takes GetShardCount() attempts on average
+    for (;;) {
+        auto id = MakeId();
+        if (GetShardOf(id, shards_.size()) == shard) {
+            return id;
+        }
+    }
+}
+
+} // namespace NStorage
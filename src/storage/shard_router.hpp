@@ -0,0 +1,83 @@
+#pragma once
+
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+
+#include "storage/hedged_reads.hpp"
+#include "storage/stale_fallback.hpp"
+#include "storage/stale_stores.hpp"
+#include "utils/circuit_breaker.hpp"
+
+namespace NStorage {
+
+using userver::storages::postgres::ClusterPtr;
+
+// Quiz content is partitioned across Postgres clusters by pack: a pack, its
+// questions and its variants always live on one shard, so every write stays
+// local to a single database.
+//
+// The shard of an entity is a hash of its id. Ids are generated here rather
+// than by the database: a pack gets a fresh id, questions and variants get
+// ids drawn until they land on the shard of their parent. Thus any id alone
+// is enough to route a request, no lookup tables or fan-out needed.
+//
+// Ids are time-ordered UUIDv7, so each shard still receives them in
+// ascending order and its indexes are appended to rather than scattered.
+//
+// Changing the number of shards moves most ids to other shards, so it
+// requires migrating the data.
+//
+// The router also carries what is shared by all reads: HedgedReads, the
+// StaleFallback with its StaleStores and a circuit breaker per shard.
+class ShardRouter final {
+public:
+    explicit ShardRouter(
+        std::vector<ClusterPtr> shards, const HedgingSettings& hedging = {},
+        const StaleFallbackSettings& stale_fallback = {}
+    );
+
+    [[nodiscard]] auto GetShardCount() const -> std::size_t;
+
+    // Cluster that owns the pack, question or variant with this id
+    [[nodiscard]] auto GetCluster(const boost::uuids::uuid& id) const
+        -> const ClusterPtr&;
+
+    [[nodiscard]] auto GetAll() const -> const std::vector<ClusterPtr>&;
+
+    [[nodiscard]] auto GetHedgedReads() const -> const HedgedReads&;
+
+    [[nodiscard]] auto GetStaleFallback() const -> const StaleFallback&;
+
+    // Stores are thread-safe, so handing them out is logically const
+    [[nodiscard]] auto GetStaleStores() const -> StaleStores&;
+
+    // Breaker of the shard that owns the entity with this id. Breakers are
+    // thread-safe, so handing them out is logically const.
+    [[nodiscard]] auto GetBreaker(const boost::uuids::uuid& id) const
+        -> Utils::CircuitBreaker&;
+
+    // Time-ordered id for a new pack
+    [[nodiscard]] static auto MakeId() -> boost::uuids::uuid;
+
+    // Time-ordered id for a new child of `parent_id`, on the same shard
+    [[nodiscard]] auto MakeIdNextTo(const boost::uuids::uuid& parent_id) const
+        -> boost::uuids::uuid;
+
+private:
+    std::vector<ClusterPtr> shards_;
+    // Outlive the StaleFallback: destroying it cancels revalidations that
+    // report to the breakers and write to the stores
+    std::vector<std::unique_ptr<Utils::CircuitBreaker>> breakers_;
+    std::unique_ptr<StaleStores> stale_stores_;
+    std::unique_ptr<HedgedReads> hedged_reads_;
+    std::unique_ptr<StaleFallback> stale_fallback_;
+};
+
+// Stable across processes and platforms, so all instances agree on it
+auto GetShardOf(const boost::uuids::uuid& id, std::size_t shard_count)
+    -> std::size_t;
+
+} // namespace NStorage
@@ -0,0 +1,63 @@
+#include "stale_fallback.hpp"
+
+#include <algorithm>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/local_variable.hpp>
+
+namespace NStorage {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+userver::engine::TaskLocalVariable<std::optional<Clock::time_point>>
+    served_stale_since;
+
+} // namespace
+
+StaleFallback::StaleFallback(const StaleFallbackSettings& settings)
+    : settings_(settings) {}
+
+void StaleFallback::OnFailure(
+    Utils::CircuitBreaker& breaker, Decision decision,
+    const OptionalCommandControl& command_control, bool timed_out
+) {
+    // A shrunk command control means the caller had less time than the
+    // shard is normally given
+    const auto inconclusive =
+        userver::engine::current_task::IsCancelRequested() ||
+        (timed_out && command_control.has_value());
+    if (!inconclusive) {
+        breaker.OnFailure();
+    } else if (decision == Decision::kProbe) {
+        breaker.OnProbeAbandoned();
+    }
+}
+
+auto IsTimeout(const userver::storages::postgres::Error& error) -> bool {
+    return dynamic_cast<const userver::storages::postgres::QueryCancelled*>(
+               &error
+           ) != nullptr ||
+           dynamic_cast<
+               const userver::storages::postgres::ConnectionTimeoutError*>(
+               &error
+           ) != nullptr;
+}
+
+void MarkServedStale(Clock::time_point fetched_at) {
+    auto& since = *served_stale_since;
+    since = since ? std::min(*since, fetched_at) : fetched_at;
+}
+
+auto TakeServedStaleAge() -> std::optional<std::chrono::seconds> {
+    auto& since = *served_stale_since;
+    if (!since) {
+        return std::nullopt;
+    }
+    const auto age =
+        std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - *since);
+    since.reset();
+    return age;
+}
+
+} // namespace NStorage
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/options.hpp>
+
+#include "utils/circuit_breaker.hpp"
+
+namespace NStorage {
+
+using userver::storages::postgres::OptionalCommandControl;
+
+struct StaleFallbackSettings final {
+    bool enabled = false;
+    // Older results are never served
+    std::chrono::seconds max_staleness{std::chrono::minutes{10}};
+    Utils::CircuitBreakerSettings breaker;
+};
+
+// Last known good results of one kind of read, bounded LRU. Thread-safe.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class StaleStore final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry final {
+        Value value;
+        Clock::time_point fetched_at;
+    };
+
+    explicit StaleStore(std::size_t way_size = 1024)
+        : entries_(kWays, way_size) {}
+
+    void Put(const Key& key, Value value) {
+        entries_.Put(
+            key,
+            std::make_shared<const Entry>(Entry{std::move(value), Clock::now()})
+        );
+    }
+
+    [[nodiscard]] auto Get(const Key& key) -> std::shared_ptr<const Entry> {
+        return entries_.Get(key).value_or(nullptr);
+    }
+
+    void Remove(const Key& key) { entries_.InvalidateByKey(key); }
+
+    // Removes the entries whose values match, visiting the whole store
+    template <typename Predicate>
+    void RemoveIf(Predicate predicate) {
+        std::vector<Key> keys;
+        entries_.VisitAll(
+            [&](const Key& key, const std::shared_ptr<const Entry>& entry) {
+                if (predicate(entry->value)) {
+                    keys.push_back(key);
+                }
+            }
+        );
+        for (const auto& key : keys) {
+            entries_.InvalidateByKey(key);
+        }
+    }
+
+    void Clear() { entries_.Invalidate(); }
+
+private:
+    static constexpr std::size_t kWays = 16;
+
+    userver::cache::NWayLRU<Key, std::shared_ptr<const Entry>, Hash> entries_;
+};
+
+// Degraded mode for content reads. Every successful read is remembered in
+// its StaleStore. When the read fails with a database error, or the
+// circuit breaker of its shard is open, the remembered result is returned
+// instead, as long as it is not older than `max_staleness`, and the
+// current task is marked as served stale (see TakeServedStaleAge). While
+// the breaker is open the database is not touched at all, except for one
+// probe per `open_duration`; if there is a stale result to serve, the
+// probe runs in the background and refreshes the store.
+//
+// `fetch` gets the command control and the deadline to use: the request's
+// ones when run inline, the defaults in the background. It must capture
+// everything by value.
+//
+// Only failures that say something about the shard count against its
+// breaker: a timeout of a query squeezed into the budget of its caller, or
+// a read cut short by cancellation, does not.
+class StaleFallback final {
+public:
+    explicit StaleFallback(const StaleFallbackSettings& settings);
+
+    // `breaker` may be null for reads that span all shards
+    template <typename Key, typename Value, typename Hash, typename Fetch>
+    auto Read(
+        StaleStore<Key, Value, Hash>& store, const Key& key,
+        Utils::CircuitBreaker* breaker,
+        const OptionalCommandControl& command_control,
+        userver::engine::Deadline deadline, Fetch fetch
+    ) const -> Value;
+
+private:
+    using Decision = Utils::CircuitBreaker::Decision;
+
+    // Reports the failure of a read that was let through as `decision`,
+    // `timed_out` if it was a query or connection timeout
+    static void OnFailure(
+        Utils::CircuitBreaker& breaker, Decision decision,
+        const OptionalCommandControl& command_control, bool timed_out
+    );
+
+    template <typename Key, typename Value, typename Hash>
+    auto GetUsable(StaleStore<Key, Value, Hash>& store, const Key& key) const
+        -> std::shared_ptr<
+            const typename StaleStore<Key, Value, Hash>::Entry>;
+
+    const StaleFallbackSettings settings_;
+    mutable userver::concurrent::BackgroundTaskStorage revalidations_;
+};
+
+// Whether the error is a statement or connection timeout
+auto IsTimeout(const userver::storages::postgres::Error& error) -> bool;
+
+// Marks the current task as answered with data fetched at `fetched_at`
+void MarkServedStale(std::chrono::steady_clock::time_point fetched_at);
+
+// Age of the oldest stale result served to the current task, if any, and
+// forgets it
+auto TakeServedStaleAge() -> std::optional<std::chrono::seconds>;
+
+template <typename Key, typename Value, typename Hash, typename Fetch>
+auto StaleFallback::Read(
+    StaleStore<Key, Value, Hash>& store, const Key& key,
+    Utils::CircuitBreaker* breaker,
+    const OptionalCommandControl& command_control,
+    userver::engine::Deadline deadline, Fetch fetch
+) const -> Value {
+    if (!settings_.enabled) {
+        return fetch(command_control, deadline);
+    }
+
+    const auto decision = breaker ? breaker->Acquire() : Decision::kAllow;
+    auto entry = decision == Decision::kAllow ? nullptr : GetUsable(store, key);
+    if (decision == Decision::kReject && !entry) {
+        throw userver::storages::postgres::ClusterUnavailable(
+            "Circuit breaker is open and there is no stale result"
+        );
+    }
+
+    if (!entry) {
+        try {
+            auto value = fetch(command_control, deadline);
+            if (breaker) {
+                breaker->OnSuccess();
+            }
+            store.Put(key, value);
+            return value;
+        } catch (const userver::storages::postgres::Error& ex) {
+            if (breaker) {
+                OnFailure(
+                    *breaker, decision, command_control, IsTimeout(ex)
+                );
+            }
+            entry = GetUsable(store, key);
+            if (!entry) {
+                throw;
+            }
+            LOG_WARNING() << "Serving a stale result: " << ex;
+        } catch (...) {
+            // Not a database failure, but a probe must not stay in flight
+            if (decision == Decision::kProbe) {
+                breaker->OnProbeAbandoned();
+            }
+            throw;
+        }
+    } else if (decision == Decision::kProbe) {
+        revalidations_.AsyncDetach(
+            "stale-revalidate",
+            [&store, key, breaker, fetch = std::move(fetch)] {
+                try {
+                    auto value = fetch(std::nullopt, {});
+                    breaker->OnSuccess();
+                    store.Put(key, std::move(value));
+                } catch (const userver::storages::postgres::Error& ex) {
+                    OnFailure(
+                        *breaker, Decision::kProbe, std::nullopt,
+                        IsTimeout(ex)
+                    );
+                    LOG_WARNING() << "Revalidation failed: " << ex;
+                } catch (const std::exception& ex) {
+                    breaker->OnProbeAbandoned();
+                    LOG_WARNING() << "Revalidation failed: " << ex;
+                }
+            }
+        );
+    }
+
+    MarkServedStale(entry->fetched_at);
+    return entry->value;
+}
+
+template <typename Key, typename Value, typename Hash>
+auto StaleFallback::GetUsable(
+    StaleStore<Key, Value, Hash>& store, const Key& key
+) const
+    -> std::shared_ptr<const typename StaleStore<Key, Value, Hash>::Entry> {
+    auto entry = store.Get(key);
+    if (entry && std::chrono::steady_clock::now() - entry->fetched_at >
+                     settings_.max_staleness) {
+        return nullptr;
+    }
+    return entry;
+}
+
+} // namespace NStorage
@@ -0,0 +1,32 @@
+#include "stale_stores.hpp"
+
+namespace NStorage {
+
+void StaleStores::Invalidate(const std::optional<boost::uuids::uuid>& pack_id
+) {
+    all_packs.Clear();
+    all_packs_json.Clear();
+    // Variants do not know their pack
+    variant_by_id.Clear();
+    variants_by_question_id.Clear();
+
+    if (!pack_id) {
+        pack_by_id.Clear();
+        pack_content_json.Clear();
+        question_by_id.Clear();
+        questions_by_pack_id.Clear();
+        questions_by_pack_id_json.Clear();
+        return;
+    }
+
+    pack_by_id.Remove(*pack_id);
+    pack_content_json.Remove(*pack_id);
+    questions_by_pack_id.Remove(*pack_id);
+    questions_by_pack_id_json.Remove(*pack_id);
+    // A question that was not found may have been created since
+    question_by_id.RemoveIf([&](const std::optional<Models::Question>& value) {
+        return !value || value->pack_id == *pack_id;
+    });
+}
+
+} // namespace NStorage
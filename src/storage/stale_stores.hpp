@@ -0,0 +1,41 @@
+#pragma once
+
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "models/pack.hpp"
+#include "models/question.hpp"
+#include "models/variant.hpp"
+#include "storage/stale_fallback.hpp"
+
+namespace NStorage {
+
+// The StaleStore of every content read, owned by the ShardRouter so that
+// they can be dropped when the content changes
+struct StaleStores final {
+    template <typename Value>
+    using ByIdStore =
+        StaleStore<boost::uuids::uuid, Value, boost::hash<boost::uuids::uuid>>;
+
+    // Drops what may show the pack, or everything without a pack id
+    void Invalidate(const std::optional<boost::uuids::uuid>& pack_id);
+
+    ByIdStore<std::optional<Models::Pack>> pack_by_id;
+    // There is a single key, so a single way is enough
+    StaleStore<std::monostate, std::vector<Models::Pack>> all_packs{1};
+    StaleStore<std::monostate, std::string> all_packs_json{1};
+    ByIdStore<std::optional<std::string>> pack_content_json;
+
+    ByIdStore<std::optional<Models::Question>> question_by_id;
+    ByIdStore<std::vector<Models::Question>> questions_by_pack_id;
+    ByIdStore<std::string> questions_by_pack_id_json;
+
+    ByIdStore<std::optional<Models::Variant>> variant_by_id;
+    ByIdStore<std::vector<Models::Variant>> variants_by_question_id;
+};
+
+} // namespace NStorage
@@ -1,23 +1,41 @@
 #include "variants.hpp"
 
+#include <boost/functional/hash.hpp>
 #include <sql_queries/sql_queries.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/component.hpp>
 #include <userver/storages/postgres/io/io_fwd.hpp>
 
+#include "utils/deadline.hpp"
+#include "utils/single_flight.hpp"
+
 namespace NStorage {
 
 using userver::storages::postgres::ClusterPtr;
 using namespace sql_queries::sql;
 using userver::storages::postgres::ClusterHostType::kMaster;
-using userver::storages::postgres::ClusterHostType::kSlave;
+using userver::storages::postgres::ClusterHostTypeFlags;
+
+namespace {
+
+using VariantByIdFlight = Utils::SingleFlight<
+    boost::uuids::uuid, std::optional<Models::Variant>,
+    boost::hash<boost::uuids::uuid>>;
+using VariantsByQuestionIdFlight = Utils::SingleFlight<
+    boost::uuids::uuid, std::vector<Models::Variant>,
+    boost::hash<boost::uuids::uuid>>;
+
+} // namespace
 
 auto CreateVariant(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& question_id,
-    const std::string& text, bool is_correct
+    const ShardRouter& shards, const boost::uuids::uuid& question_id,
+    const std::string& text, bool is_correct, userver::engine::Deadline deadline
 ) -> std::optional<Models::Variant> {
-    auto result = pg_cluster_->Execute(
-        kMaster, kCreateVariant, question_id, text, is_correct
+    const auto& pg_cluster = shards.GetCluster(question_id);
+    auto result = pg_cluster->Execute(
+        kMaster, Utils::MakeCommandControl(pg_cluster, deadline),
+        kCreateVariant, shards.MakeIdNextTo(question_id), question_id, text,
+        is_correct
     );
     return result.AsOptionalSingleRow<Models::Variant>(
         userver::storages::postgres::kRowTag
@@ -25,21 +43,72 @@ auto CreateVariant(
 }
 
 auto GetVariantById(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& variant_id
+    const ShardRouter& shards, const boost::uuids::uuid& variant_id,
+    userver::engine::Deadline deadline
 ) -> std::optional<Models::Variant> {
-    auto result = pg_cluster_->Execute(kSlave, kGetVariantById, variant_id);
-    return result.AsOptionalSingleRow<Models::Variant>(
-        userver::storages::postgres::kRowTag
+    static VariantByIdFlight flight{"get-variant-by-id"};
+    auto& stale = shards.GetStaleStores().variant_by_id;
+    const auto& pg_cluster = shards.GetCluster(variant_id);
+    const auto* hedged_reads = &shards.GetHedgedReads();
+    return shards.GetStaleFallback().Read(
+        stale, variant_id, &shards.GetBreaker(variant_id), std::nullopt,
+        deadline,
+        [hedged_reads, pg_cluster, variant_id](
+            const OptionalCommandControl& /*command_control*/,
+            userver::engine::Deadline wait_deadline
+        ) {
+            return flight.Execute(
+                variant_id, wait_deadline,
+                [hedged_reads, pg_cluster, variant_id] {
+                    auto result = hedged_reads->Execute(
+                        "get-variant-by-id",
+                        [&](ClusterHostTypeFlags host) {
+                            return pg_cluster->Execute(
+                                host, kGetVariantById, variant_id
+                            );
+                        }
+                    );
+                    return result.AsOptionalSingleRow<Models::Variant>(
+                        userver::storages::postgres::kRowTag
+                    );
+                }
+            );
+        }
     );
 }
 
 auto GetVariantsByQuestionId(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& question_id
+    const ShardRouter& shards, const boost::uuids::uuid& question_id,
+    userver::engine::Deadline deadline
 ) -> std::vector<Models::Variant> {
-    auto result =
-        pg_cluster_->Execute(kSlave, kGetVariantsByQuestionId, question_id);
-    return result.AsContainer<std::vector<Models::Variant>>(
-        userver::storages::postgres::kRowTag
+    static VariantsByQuestionIdFlight flight{"get-variants-by-question-id"};
+    auto& stale = shards.GetStaleStores().variants_by_question_id;
+    const auto& pg_cluster = shards.GetCluster(question_id);
+    const auto* hedged_reads = &shards.GetHedgedReads();
+    return shards.GetStaleFallback().Read(
+        stale, question_id, &shards.GetBreaker(question_id), std::nullopt,
+        deadline,
+        [hedged_reads, pg_cluster, question_id](
+            const OptionalCommandControl& /*command_control*/,
+            userver::engine::Deadline wait_deadline
+        ) {
+            return flight.Execute(
+                question_id, wait_deadline,
+                [hedged_reads, pg_cluster, question_id] {
+                    auto result = hedged_reads->Execute(
+                        "get-variants-by-question-id",
+                        [&](ClusterHostTypeFlags host) {
+                            return pg_cluster->Execute(
+                                host, kGetVariantsByQuestionId, question_id
+                            );
+                        }
+                    );
+                    return result.AsContainer<std::vector<Models::Variant>>(
+                        userver::storages::postgres::kRowTag
+                    );
+                }
+            );
+        }
     );
 }
 
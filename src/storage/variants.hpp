@@ -1,26 +1,30 @@
 #pragma once
 
+#include <userver/engine/deadline.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 
 #include "models/variant.hpp"
+#include "storage/shard_router.hpp"
 
 namespace NStorage {
 
-using userver::storages::postgres::ClusterPtr;
 using userver::storages::postgres::ResultSet;
 
 auto CreateVariant(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& question_id,
-    const std::string& text, bool is_correct
+    const ShardRouter& shards, const boost::uuids::uuid& question_id,
+    const std::string& text, bool is_correct,
+    userver::engine::Deadline deadline = {}
 ) -> std::optional<Models::Variant>;
 
 auto GetVariantById(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& variant_id
+    const ShardRouter& shards, const boost::uuids::uuid& variant_id,
+    userver::engine::Deadline deadline = {}
 ) -> std::optional<Models::Variant>;
 
 auto GetVariantsByQuestionId(
-    ClusterPtr pg_cluster_, const boost::uuids::uuid& question_id
+    const ShardRouter& shards, const boost::uuids::uuid& question_id,
+    userver::engine::Deadline deadline = {}
 ) -> std::vector<Models::Variant>;
 
 } // namespace NStorage
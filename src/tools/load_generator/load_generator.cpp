@@ -0,0 +1,447 @@
+#include "load_generator.hpp"
+
+#include <fmt/format.h>
+#include <google/protobuf/util/json_util.h>
+#include <grpcpp/client_context.h>
+
+#include <functional>
+#include <handlers/cruds_client.usrv.pb.hpp>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <userver/clients/http/client.hpp>
+#include <userver/clients/http/component.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/ugrpc/client/client_factory_component.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include "replay_request.hpp"
+#include "utils/latency_histogram.hpp"
+
+namespace game_userver::load_generator {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Shot = std::function<void()>;
+
+constexpr std::uint64_t kMaxLatencyUs = 60'000'000;
+
+struct Target final {
+    std::string endpoint;
+    Shot shot;
+};
+
+struct EndpointStats final {
+    Utils::LatencyHistogram latency_us{kMaxLatencyUs};
+    std::uint64_t errors = 0;
+};
+
+class Report final {
+public:
+    void Record(const std::string& endpoint, Clock::duration latency, bool ok) {
+        const auto latency_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(latency);
+
+        const std::lock_guard lock{mutex_};
+        auto& stats = endpoints_.try_emplace(endpoint).first->second;
+        stats.latency_us.Record(latency_us.count());
+        if (!ok) {
+            ++stats.errors;
+        }
+    }
+
+    auto Format(std::chrono::duration<double> elapsed) const -> std::string {
+        const std::lock_guard lock{mutex_};
+
+        std::string result = fmt::format(
+            "{:<48} {:>8} {:>7} {:>9} {:>9} {:>9} {:>9} {:>9} {:>9}\n",
+            "endpoint", "count", "errors", "rps", "p50 ms", "p90 ms", "p99 ms",
+            "p99.9 ms", "max ms"
+        );
+
+        EndpointStats total;
+        for (const auto& [endpoint, stats] : endpoints_) {
+            result += FormatLine(endpoint, stats, elapsed);
+            total.latency_us.Merge(stats.latency_us);
+            total.errors += stats.errors;
+        }
+        result += FormatLine("total", total, elapsed);
+        return result;
+    }
+
+private:
+    static auto FormatLine(
+        std::string_view endpoint, const EndpointStats& stats,
+        std::chrono::duration<double> elapsed
+    ) -> std::string {
+        const auto& latency = stats.latency_us;
+        const auto ms = [&latency](double percentile) {
+            return static_cast<double>(latency.Percentile(percentile)) / 1000;
+        };
+        return fmt::format(
+            "{:<48} {:>8} {:>7} {:>9.1f} {:>9.2f} {:>9.2f} {:>9.2f} {:>9.2f} "
+            "{:>9.2f}\n",
+            endpoint, latency.Count(), stats.errors,
+            static_cast<double>(latency.Count()) / elapsed.count(), ms(50),
+            ms(90), ms(99), ms(99.9), static_cast<double>(latency.Max()) / 1000
+        );
+    }
+
+    mutable userver::engine::Mutex mutex_;
+    std::map<std::string, EndpointStats> endpoints_;
+};
+
+auto MakeHttpShot(
+    userver::clients::http::Client& client, const std::string& base_url,
+    const ReplayRequest& replay, std::chrono::milliseconds timeout
+) -> Shot {
+    return [&client, url = base_url + replay.url_path, replay, timeout] {
+        auto request = client.CreateRequest();
+        if (replay.method == "GET") {
+            request.get(url);
+        } else if (replay.method == "HEAD") {
+            request.head(url);
+        } else if (replay.method == "POST") {
+            request.post(url, replay.body);
+        } else if (replay.method == "PUT") {
+            request.put(url, replay.body);
+        } else if (replay.method == "PATCH") {
+            request.patch(url, replay.body);
+        } else {
+            request.delete_method(url);
+        }
+
+        userver::clients::http::Headers headers;
+        for (const auto& [name, value] : replay.headers) {
+            headers.emplace(name, value);
+        }
+        request.headers(headers);
+
+        request.timeout(timeout).perform()->raise_for_status();
+    };
+}
+
+template <typename Request, typename Call>
+auto MakeGrpcShot(
+    const ReplayRequest& replay, std::chrono::milliseconds timeout, Call call
+) -> Shot {
+    Request request;
+    const auto status =
+        google::protobuf::util::JsonStringToMessage(replay.body, &request);
+    if (!status.ok()) {
+        throw std::runtime_error(fmt::format(
+            "Malformed {} request: {}", replay.method, status.ToString()
+        ));
+    }
+
+    return [request = std::move(request), timeout, call] {
+        auto context = std::make_unique<grpc::ClientContext>();
+        context->set_deadline(std::chrono::system_clock::now() + timeout);
+        call(request, std::move(context));
+    };
+}
+
+auto MakeGrpcShot(
+    const handlers::api::QuizServiceClient& client, const ReplayRequest& replay,
+    std::chrono::milliseconds timeout
+) -> Shot {
+    namespace api = handlers::api;
+
+    const auto& method = replay.method;
+    if (method == "CreatePack") {
+        return MakeGrpcShot<api::CreatePackRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.CreatePack(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetPackById") {
+        return MakeGrpcShot<api::GetPackByIdRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetPackById(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetAllPacks") {
+        return MakeGrpcShot<api::GetAllPacksRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetAllPacks(request, std::move(context));
+            }
+        );
+    }
+    if (method == "UpdatePackTitle") {
+        return MakeGrpcShot<api::UpdatePackTitleRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.UpdatePackTitle(request, std::move(context));
+            }
+        );
+    }
+    if (method == "DeletePack") {
+        return MakeGrpcShot<api::DeletePackRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.DeletePack(request, std::move(context));
+            }
+        );
+    }
+    if (method == "PublishPack") {
+        return MakeGrpcShot<api::PublishPackRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.PublishPack(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetPackVersion") {
+        return MakeGrpcShot<api::GetPackVersionRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetPackVersion(request, std::move(context));
+            }
+        );
+    }
+    if (method == "CreateQuestion") {
+        return MakeGrpcShot<api::CreateQuestionRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.CreateQuestion(request, std::move(context));
+            }
+        );
+    }
+    if (method == "CreateQuestionWithVariants") {
+        return MakeGrpcShot<api::CreateQuestionWithVariantsRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.CreateQuestionWithVariants(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetQuestionById") {
+        return MakeGrpcShot<api::GetQuestionByIdRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetQuestionById(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetQuestionsByPackId") {
+        return MakeGrpcShot<api::GetQuestionsByPackIdRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetQuestionsByPackId(request, std::move(context));
+            }
+        );
+    }
+    if (method == "CreateVariant") {
+        return MakeGrpcShot<api::CreateVariantRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.CreateVariant(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetVariantById") {
+        return MakeGrpcShot<api::GetVariantByIdRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetVariantById(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetVariantsByQuestionId") {
+        return MakeGrpcShot<api::GetVariantsByQuestionIdRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetVariantsByQuestionId(request, std::move(context));
+            }
+        );
+    }
+    if (method == "SubmitAnswer") {
+        return MakeGrpcShot<api::SubmitAnswerRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.SubmitAnswer(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetQuestionStats") {
+        return MakeGrpcShot<api::GetQuestionStatsRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetQuestionStats(request, std::move(context));
+            }
+        );
+    }
+    if (method == "GetPackStats") {
+        return MakeGrpcShot<api::GetPackStatsRequest>(
+            replay, timeout,
+            [client](const auto& request, auto context) {
+                client.GetPackStats(request, std::move(context));
+            }
+        );
+    }
+    throw std::runtime_error("Unknown QuizService method: " + method);
+}
+
+} // namespace
+
+LoadGenerator::LoadGenerator(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& component_context
+)
+    : ComponentBase(config, component_context),
+      http_client_(component_context
+                       .FindComponent<userver::components::HttpClient>()
+                       .GetHttpClient()),
+      grpc_client_factory_(
+          component_context
+              .FindComponent<userver::ugrpc::client::ClientFactoryComponent>()
+              .GetFactory()
+      ),
+      fs_task_processor_(component_context.GetTaskProcessor(
+          config["fs-task-processor"].As<std::string>()
+      )),
+      requests_file_(config["requests-file"].As<std::string>()),
+      report_file_(config["report-file"].As<std::string>("")),
+      http_base_url_(config["http-base-url"].As<std::string>()),
+      grpc_endpoint_(config["grpc-endpoint"].As<std::string>()),
+      rate_(config["rate"].As<double>()),
+      duration_(config["duration"].As<std::chrono::milliseconds>()),
+      timeout_(config["timeout"].As<std::chrono::milliseconds>(
+          std::chrono::seconds{1}
+      )) {
+    if (rate_ <= 0) {
+        throw std::invalid_argument("load-generator: rate must be positive");
+    }
+}
+
+void LoadGenerator::OnAllComponentsLoaded() {
+    const auto requests =
+        userver::engine::AsyncNoSpan(
+            fs_task_processor_, &LoadReplayRequests, requests_file_
+        )
+            .Get();
+    if (requests.empty()) {
+        LOG_ERROR() << "No requests to replay in " << requests_file_;
+        return;
+    }
+
+    const auto quiz_client =
+        grpc_client_factory_.MakeClient<handlers::api::QuizServiceClient>(
+            "quiz-service", grpc_endpoint_
+        );
+
+    std::vector<Target> targets;
+    targets.reserve(requests.size());
+    for (const auto& request : requests) {
+        targets.push_back(
+            {request.GetEndpoint(),
+             request.protocol == Protocol::kHttp
+                 ? MakeHttpShot(http_client_, http_base_url_, request, timeout_)
+                 : MakeGrpcShot(quiz_client, request, timeout_)}
+        );
+    }
+
+    LOG_INFO() << "Replaying " << targets.size() << " requests at " << rate_
+               << " rps for " << duration_.count() << "ms";
+
+    Report report;
+    userver::concurrent::BackgroundTaskStorage in_flight;
+    const auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>{1.0 / rate_}
+    );
+    const auto start = Clock::now();
+
+    for (std::size_t sent = 0;; ++sent) {
+        const auto scheduled = start + interval * sent;
+        if (scheduled - start >= duration_) {
+            break;
+        }
+        userver::engine::SleepUntil(
+            userver::engine::Deadline::FromTimePoint(scheduled)
+        );
+
+        const auto& target = targets[sent % targets.size()];
+        in_flight.AsyncDetach(
+            "replay-request",
+            [&target, &report, scheduled] {
+                bool ok = true;
+                try {
+                    target.shot();
+                } catch (const std::exception& e) {
+                    ok = false;
+                    LOG_LIMITED_WARNING()
+                        << target.endpoint << " failed: " << e.what();
+                }
+                report.Record(target.endpoint, Clock::now() - scheduled, ok);
+            }
+        );
+    }
+
+    // Requests are bounded by `timeout`, give stragglers a chance to finish
+    const auto drain_deadline =
+        userver::engine::Deadline::FromDuration(timeout_ * 2);
+    while (in_flight.ActiveTasksApprox() != 0 && !drain_deadline.IsReached()) {
+        userver::engine::SleepFor(std::chrono::milliseconds{10});
+    }
+    in_flight.CancelAndWait();
+
+    const auto text = report.Format(Clock::now() - start);
+    std::cout << text << std::flush;
+
+    if (!report_file_.empty()) {
+        userver::engine::AsyncNoSpan(fs_task_processor_, [this, &text] {
+            userver::fs::blocking::RewriteFileContents(report_file_, text);
+        }).Get();
+    }
+}
+
+auto LoadGenerator::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: open-loop replay of recorded HTTP and gRPC requests
+additionalProperties: false
+properties:
+    requests-file:
+        type: string
+        description: JSONL file with recorded requests
+    report-file:
+        type: string
+        description: where to write the report, stdout only if not set
+    http-base-url:
+        type: string
+        description: base URL of the HTTP server, e.g. http://localhost:8080
+    grpc-endpoint:
+        type: string
+        description: gRPC server endpoint, e.g. localhost:8081
+    rate:
+        type: number
+        description: requests per second, regardless of responses
+    duration:
+        type: string
+        description: how long to send requests, e.g. 30s
+    timeout:
+        type: string
+        description: timeout of a single request
+        defaultDescription: 1s
+    fs-task-processor:
+        type: string
+        description: task processor for file IO
+)");
+}
+
+} // namespace game_userver::load_generator
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <userver/components/component_base.hpp>
+#include <userver/components/component_fwd.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+namespace userver::clients::http {
+class Client;
+} // namespace userver::clients::http
+
+namespace userver::ugrpc::client {
+class ClientFactory;
+} // namespace userver::ugrpc::client
+
+namespace game_userver::load_generator {
+
+// Replays requests from a JSONL file (see replay_request.hpp) against a
+// running service at a fixed open-loop rate: requests are sent on schedule
+// no matter how many are still in flight, and latency is measured from the
+// scheduled send time, so a slow service cannot hide its queueing delay.
+//
+// The whole run happens in OnAllComponentsLoaded, the tool is started with
+// components::RunOnce and exits when the report is printed.
+class LoadGenerator final : public userver::components::ComponentBase {
+public:
+    static constexpr std::string_view kName = "load-generator";
+
+    LoadGenerator(
+        const userver::components::ComponentConfig&,
+        const userver::components::ComponentContext&
+    );
+
+    void OnAllComponentsLoaded() override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+private:
+    userver::clients::http::Client& http_client_;
+    userver::ugrpc::client::ClientFactory& grpc_client_factory_;
+    userver::engine::TaskProcessor& fs_task_processor_;
+
+    const std::string requests_file_;
+    const std::string report_file_;
+    const std::string http_base_url_;
+    const std::string grpc_endpoint_;
+    const double rate_;
+    const std::chrono::milliseconds duration_;
+    const std::chrono::milliseconds timeout_;
+};
+
+} // namespace game_userver::load_generator
+
+template <>
+inline constexpr bool userver::components::kHasValidate<
+    game_userver::load_generator::LoadGenerator> = true;
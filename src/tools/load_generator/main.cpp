@@ -0,0 +1,52 @@
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <optional>
+#include <string>
+#include <userver/clients/dns/component.hpp>
+#include <userver/clients/http/component.hpp>
+#include <userver/components/minimal_component_list.hpp>
+#include <userver/components/run.hpp>
+#include <userver/ugrpc/client/component_list.hpp>
+
+#include "load_generator.hpp"
+
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+    po::options_description desc("Allowed options");
+    desc.add_options()("help,h", "produce help message")(
+        "config,c",
+        po::value<std::string>()->default_value(
+            "configs/load_generator/static_config.yaml"
+        ),
+        "path to the load generator static config"
+    )("config_vars", po::value<std::string>(), "path to config_vars.yaml");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    std::optional<std::string> config_vars;
+    if (vm.count("config_vars") != 0) {
+        config_vars = vm["config_vars"].as<std::string>();
+    }
+
+    const auto component_list =
+        userver::components::MinimalComponentList()
+            .Append<userver::clients::dns::Component>()
+            .Append<userver::components::HttpClient>()
+            .AppendComponentList(userver::ugrpc::client::MinimalComponentList())
+            .Append<game_userver::load_generator::LoadGenerator>();
+
+    userver::components::RunOnce(
+        vm["config"].as<std::string>(), config_vars, std::nullopt,
+        component_list
+    );
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "replay_request.hpp"
+
+#include <fmt/format.h>
+
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <userver/formats/common/items.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/http/url.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/text.hpp>
+
+namespace game_userver::load_generator {
+
+namespace {
+
+auto ParseHttpMethod(const userver::formats::json::Value& json)
+    -> std::string {
+    static const std::unordered_set<std::string> kMethods{
+        "GET", "HEAD", "POST", "PUT", "PATCH", "DELETE"
+    };
+    auto method =
+        userver::utils::text::ToUpper(json["method"].As<std::string>("GET"));
+    if (kMethods.count(method) == 0) {
+        throw std::runtime_error("Unsupported HTTP method: " + method);
+    }
+    return method;
+}
+
+auto ParseHttp(const userver::formats::json::Value& json) -> ReplayRequest {
+    ReplayRequest request;
+    request.protocol = Protocol::kHttp;
+    request.method = ParseHttpMethod(json);
+
+    std::unordered_map<std::string, std::string> query;
+    if (json["query"].IsObject()) {
+        for (const auto& [name, value] :
+             userver::formats::common::Items(json["query"])) {
+            query.emplace(name, value.As<std::string>());
+        }
+    }
+    request.url_path =
+        userver::http::MakeUrl(json["path"].As<std::string>(), query);
+
+    if (json["headers"].IsObject()) {
+        for (const auto& [name, value] :
+             userver::formats::common::Items(json["headers"])) {
+            request.headers.emplace_back(name, value.As<std::string>());
+        }
+    }
+
+    const auto& body = json["body"];
+    if (body.IsString()) {
+        request.body = body.As<std::string>();
+    } else if (!body.IsMissing()) {
+        request.body = userver::formats::json::ToString(body);
+    }
+    return request;
+}
+
+auto ParseGrpc(const userver::formats::json::Value& json) -> ReplayRequest {
+    ReplayRequest request;
+    request.protocol = Protocol::kGrpc;
+    request.method = json["method"].As<std::string>();
+    request.body = json["request"].IsMissing()
+                       ? "{}"
+                       : userver::formats::json::ToString(json["request"]);
+    return request;
+}
+
+} // namespace
+
+auto ReplayRequest::GetEndpoint() const -> std::string {
+    if (protocol == Protocol::kGrpc) {
+        return fmt::format("grpc QuizService/{}", method);
+    }
+    const auto path_end = url_path.find('?');
+    return fmt::format("http {} {}", method, url_path.substr(0, path_end));
+}
+
+auto ParseReplayRequest(std::string_view line) -> std::optional<ReplayRequest> {
+    const auto json = userver::formats::json::FromString(line);
+    const auto protocol = json["protocol"].As<std::string>("");
+
+    if (protocol == "http") {
+        return ParseHttp(json);
+    }
+    if (protocol == "grpc") {
+        return ParseGrpc(json);
+    }
+    return std::nullopt;
+}
+
+auto LoadReplayRequests(const std::string& path)
+    -> std::vector<ReplayRequest> {
+    const auto contents = userver::fs::blocking::ReadFileContents(path);
+
+    std::vector<ReplayRequest> requests;
+    std::size_t skipped = 0;
+    std::size_t line_number = 0;
+    for (const auto line : userver::utils::text::SplitIntoStringViewVector(
+             contents, "\n"
+         )) {
+        ++line_number;
+        if (userver::utils::text::Trim(std::string{line}).empty()) {
+            continue;
+        }
+
+        try {
+            auto request = ParseReplayRequest(line);
+            if (request) {
+                requests.push_back(std::move(*request));
+            } else {
+                ++skipped;
+            }
+        } catch (const std::exception& e) {
+            throw std::runtime_error(fmt::format(
+                "{}:{}: malformed request: {}", path, line_number, e.what()
+            ));
+        }
+    }
+
+    LOG_INFO() << "Loaded " << requests.size() << " requests from " << path
+               << ", skipped " << skipped << " unrelated lines";
+    return requests;
+}
+
+} // namespace game_userver::load_generator
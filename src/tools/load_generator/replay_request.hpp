@@ -0,0 +1,49 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace game_userver::load_generator {
+
+enum class Protocol {
+    kHttp,
+    kGrpc
+};
+
+// One recorded request. Lines of the JSONL file look like
+//
+//   {"protocol": "http", "method": "GET", "path": "/get-pack",
+//    "query": {"uuid": "..."}, "headers": {"X-Deadline": "500"}}
+//   {"protocol": "http", "method": "POST",
+//    "path": "/create-question-with-variants", "body": "{...}"}
+//   {"protocol": "grpc", "method": "GetPackById", "request": {"id": "..."}}
+//
+// gRPC methods are QuizService methods, `request` is the request message in
+// the canonical protobuf JSON mapping.
+struct ReplayRequest final {
+    Protocol protocol = Protocol::kHttp;
+    // HTTP verb or QuizService method name
+    std::string method;
+    // HTTP only: path with the query string already applied
+    std::string url_path;
+    std::vector<std::pair<std::string, std::string>> headers;
+    // HTTP body or gRPC request message as JSON
+    std::string body;
+
+    // Requests are grouped by this key in the report
+    [[nodiscard]] auto GetEndpoint() const -> std::string;
+};
+
+// Returns std::nullopt for lines without a known `protocol`, so a file may
+// carry unrelated records. Throws on malformed records: a missing `path` or
+// gRPC `method`, or an HTTP method the generator cannot send.
+auto ParseReplayRequest(std::string_view line) -> std::optional<ReplayRequest>;
+
+// Blocking, run on a filesystem task processor
+auto LoadReplayRequests(const std::string& path)
+    -> std::vector<ReplayRequest>;
+
+} // namespace game_userver::load_generator
@@ -0,0 +1,187 @@
+#include "adaptive_limiter.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Utils {
+
+namespace {
+
+template <typename T, typename Func>
+void Update(std::atomic<T>& value, Func&& func) {
+    auto current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(
+        current, func(current), std::memory_order_relaxed
+    )) {
+    }
+}
+
+} // namespace
+
+AdaptiveLimiter::Slot::Slot(
+    AdaptiveLimiter& limiter, AdaptiveLimiter* budget,
+    Clock::time_point started_at
+)
+    : limiter_(&limiter), budget_(budget), started_at_(started_at) {}
+
+AdaptiveLimiter::Slot::Slot(Slot&& other) noexcept
+    : limiter_(std::exchange(other.limiter_, nullptr)),
+      budget_(other.budget_), started_at_(other.started_at_) {}
+
+AdaptiveLimiter::Slot::~Slot() {
+    if (limiter_ != nullptr) {
+        limiter_->Release(started_at_, budget_);
+    }
+}
+
+void AdaptiveLimiter::Slot::Cancel() {
+    if (limiter_ == nullptr) {
+        return;
+    }
+    std::exchange(limiter_, nullptr)
+        ->in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    if (budget_ != nullptr) {
+        budget_->in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+AdaptiveLimiter::AdaptiveLimiter(const AdaptiveLimiterSettings& settings)
+    : settings_(settings),
+      limit_(static_cast<double>(std::clamp(
+          settings.initial_limit, settings.min_limit, settings.max_limit
+      ))) {}
+
+auto AdaptiveLimiter::TryAcquire(AdaptiveLimiter* budget)
+    -> std::optional<Slot> {
+    if (budget != nullptr && !budget->TryTake()) {
+        return std::nullopt;
+    }
+    if (!TryTake()) {
+        // Shed before any work was done, so there is no latency to report
+        if (budget != nullptr) {
+            budget->in_flight_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return std::nullopt;
+    }
+    return Slot{*this, budget, Clock::now()};
+}
+
+auto AdaptiveLimiter::TryTake() -> bool {
+    const auto limit = GetLimit();
+    auto in_flight = in_flight_.load(std::memory_order_relaxed);
+    do {
+        if (in_flight >= limit) {
+            return false;
+        }
+    } while (!in_flight_.compare_exchange_weak(
+        in_flight, in_flight + 1, std::memory_order_relaxed
+    ));
+    return true;
+}
+
+void AdaptiveLimiter::Release(
+    Clock::time_point started_at, AdaptiveLimiter* budget
+) {
+    const auto now = Clock::now();
+    const auto congested = OnSample(now - started_at, now);
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    if (budget != nullptr) {
+        budget->OnVerdict(congested, now - started_at, now);
+        budget->in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+auto AdaptiveLimiter::UpdateBaseline(
+    std::int64_t sample_us, Clock::time_point now
+) -> std::int64_t {
+    const auto now_ticks = now.time_since_epoch().count();
+    const auto window =
+        std::chrono::duration_cast<Clock::duration>(settings_.baseline_window)
+            .count();
+
+    auto started_at = window_started_at_.load(std::memory_order_relaxed);
+    if (now_ticks - started_at >= window &&
+        window_started_at_.compare_exchange_strong(
+            started_at, now_ticks, std::memory_order_relaxed
+        )) {
+        // Whoever rolls the window over starts the new one with its sample.
+        // After a silence of more than a window the last one is stale too.
+        const auto last_min =
+            window_min_us_.exchange(sample_us, std::memory_order_relaxed);
+        previous_min_us_.store(
+            now_ticks - started_at < 2 * window ? last_min : 0,
+            std::memory_order_relaxed
+        );
+    } else {
+        Update(window_min_us_, [&](std::int64_t window_min) {
+            return window_min == 0 ? sample_us
+                                   : std::min(window_min, sample_us);
+        });
+    }
+
+    const auto window_min = window_min_us_.load(std::memory_order_relaxed);
+    const auto previous_min = previous_min_us_.load(std::memory_order_relaxed);
+    if (previous_min == 0) {
+        return window_min;
+    }
+    return std::min(window_min, previous_min);
+}
+
+auto AdaptiveLimiter::OnSample(Clock::duration latency, Clock::time_point now)
+    -> bool {
+    const std::int64_t sample_us = std::max<std::int64_t>(
+        1, std::chrono::duration_cast<std::chrono::microseconds>(latency)
+               .count()
+    );
+    const auto baseline_us = UpdateBaseline(sample_us, now);
+
+    const auto congested =
+        static_cast<double>(sample_us) >
+        static_cast<double>(baseline_us) * settings_.tolerance;
+    OnVerdict(congested, latency, now);
+    return congested;
+}
+
+void AdaptiveLimiter::OnVerdict(
+    bool congested, Clock::duration latency, Clock::time_point now
+) {
+    const auto min_limit = static_cast<double>(settings_.min_limit);
+    const auto max_limit = static_cast<double>(settings_.max_limit);
+
+    if (congested) {
+        // Multiplicative decrease, but only once per round trip: a burst of
+        // slow responses is a single congestion signal
+        const auto now_ticks = now.time_since_epoch().count();
+        auto last_backoff = last_backoff_.load(std::memory_order_relaxed);
+        if (now_ticks - last_backoff < latency.count() ||
+            !last_backoff_.compare_exchange_strong(
+                last_backoff, now_ticks, std::memory_order_relaxed
+            )) {
+            return;
+        }
+        Update(limit_, [&](double limit) {
+            return std::max(min_limit, limit * settings_.backoff);
+        });
+        return;
+    }
+
+    // Additive increase, only while the current limit is actually in use
+    const auto in_flight =
+        static_cast<double>(in_flight_.load(std::memory_order_relaxed));
+    Update(limit_, [&](double limit) {
+        if (in_flight * 2 < limit) {
+            return limit;
+        }
+        return std::min(max_limit, limit + 1.0 / limit);
+    });
+}
+
+auto AdaptiveLimiter::GetLimit() const -> std::size_t {
+    return static_cast<std::size_t>(limit_.load(std::memory_order_relaxed));
+}
+
+auto AdaptiveLimiter::GetInFlight() const -> std::size_t {
+    return in_flight_.load(std::memory_order_relaxed);
+}
+
+} // namespace Utils
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace Utils {
+
+struct AdaptiveLimiterSettings final {
+    std::size_t initial_limit = 32;
+    std::size_t min_limit = 4;
+    std::size_t max_limit = 256;
+    // How much slower than the best observed latency a request may be before
+    // the limit is cut
+    double tolerance = 2.0;
+    // Multiplier applied to the limit on congestion
+    double backoff = 0.9;
+    // The baseline is the best latency of the last one to two windows, so a
+    // lucky sample is forgotten and a permanently slower backend becomes the
+    // new normal within two windows
+    std::chrono::milliseconds baseline_window{10000};
+};
+
+// AIMD concurrency limiter driven by observed latency. The limit grows by
+// roughly one slot per round trip while latency stays within `tolerance` of
+// the baseline (the windowed minimum) and is multiplied by `backoff` at most
+// once per round trip when it does not. Everything is lock-free, so it is
+// cheap enough to sit in front of every request.
+//
+// A limiter may also serve as a shared budget for several others: a slot
+// taken with TryAcquire(&budget) occupies both, and the budget follows the
+// verdict of the other limiter instead of judging latencies of different
+// endpoints against a single baseline.
+class AdaptiveLimiter final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Occupies one concurrency slot until destroyed, then reports the
+    // latency of the guarded work back to the limiter.
+    class Slot final {
+    public:
+        Slot(Slot&& other) noexcept;
+        Slot(const Slot&) = delete;
+        auto operator=(Slot&&) -> Slot& = delete;
+        auto operator=(const Slot&) -> Slot& = delete;
+        ~Slot();
+
+        // Frees the slot without reporting a latency, for work that failed
+        // or was cut short and says nothing about the backend
+        void Cancel();
+
+    private:
+        friend class AdaptiveLimiter;
+
+        Slot(
+            AdaptiveLimiter& limiter, AdaptiveLimiter* budget,
+            Clock::time_point started_at
+        );
+
+        AdaptiveLimiter* limiter_;
+        AdaptiveLimiter* budget_;
+        Clock::time_point started_at_;
+    };
+
+    explicit AdaptiveLimiter(const AdaptiveLimiterSettings& settings);
+
+    // Returns std::nullopt if the request must be shed, here or in `budget`.
+    [[nodiscard]] auto TryAcquire(AdaptiveLimiter* budget = nullptr)
+        -> std::optional<Slot>;
+
+    // Feeds one latency sample that finished at `now` and returns whether it
+    // was a sign of congestion. Called by Slot, public for tests.
+    auto OnSample(Clock::duration latency, Clock::time_point now) -> bool;
+
+    // Adjusts the limit to a sample judged by another limiter
+    void OnVerdict(
+        bool congested, Clock::duration latency, Clock::time_point now
+    );
+
+    [[nodiscard]] auto GetLimit() const -> std::size_t;
+    [[nodiscard]] auto GetInFlight() const -> std::size_t;
+
+private:
+    auto TryTake() -> bool;
+    void Release(Clock::time_point started_at, AdaptiveLimiter* budget);
+    auto UpdateBaseline(std::int64_t sample_us, Clock::time_point now)
+        -> std::int64_t;
+
+    const AdaptiveLimiterSettings settings_;
+    std::atomic<std::size_t> in_flight_{0};
+    std::atomic<double> limit_;
+    // Minimum latency of the current window and of the one before it, zero
+    // while there were no samples
+    std::atomic<Clock::rep> window_started_at_{0};
+    std::atomic<std::int64_t> window_min_us_{0};
+    std::atomic<std::int64_t> previous_min_us_{0};
+    std::atomic<Clock::rep> last_backoff_{0};
+};
+
+} // namespace Utils
@@ -0,0 +1,62 @@
+#include "circuit_breaker.hpp"
+
+namespace Utils {
+
+CircuitBreaker::CircuitBreaker(const CircuitBreakerSettings& settings)
+    : settings_(settings) {}
+
+auto CircuitBreaker::Acquire(Clock::time_point now) -> Decision {
+    if (!open_.load(std::memory_order_acquire)) {
+        return Decision::kAllow;
+    }
+
+    const std::lock_guard lock{mutex_};
+    if (!open_.load(std::memory_order_relaxed)) {
+        return Decision::kAllow;
+    }
+    if (probing_ || now < open_until_) {
+        return Decision::kReject;
+    }
+    probing_ = true;
+    return Decision::kProbe;
+}
+
+void CircuitBreaker::OnSuccess() {
+    if (!open_.load(std::memory_order_acquire) &&
+        failures_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    const std::lock_guard lock{mutex_};
+    failures_.store(0, std::memory_order_relaxed);
+    probing_ = false;
+    open_.store(false, std::memory_order_release);
+}
+
+void CircuitBreaker::OnFailure(Clock::time_point now) {
+    const std::lock_guard lock{mutex_};
+    if (open_.load(std::memory_order_relaxed)) {
+        // A failed probe, or a request admitted before the breaker opened
+        probing_ = false;
+        open_until_ = now + settings_.open_duration;
+        return;
+    }
+
+    const auto failures = failures_.load(std::memory_order_relaxed) + 1;
+    failures_.store(failures, std::memory_order_relaxed);
+    if (failures >= settings_.failure_threshold) {
+        open_until_ = now + settings_.open_duration;
+        open_.store(true, std::memory_order_release);
+    }
+}
+
+void CircuitBreaker::OnProbeAbandoned() {
+    const std::lock_guard lock{mutex_};
+    probing_ = false;
+}
+
+auto CircuitBreaker::IsOpen() const -> bool {
+    return open_.load(std::memory_order_acquire);
+}
+
+} // namespace Utils
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace Utils {
+
+struct CircuitBreakerSettings final {
+    // Consecutive failures that open the breaker
+    std::size_t failure_threshold = 5;
+    // How long an open breaker rejects requests before letting a probe
+    // through
+    std::chrono::milliseconds open_duration{std::chrono::seconds{5}};
+};
+
+// Classic three-state circuit breaker. While closed every request is
+// allowed; `failure_threshold` failures in a row open it, and for
+// `open_duration` everything is rejected. After that a single probe is let
+// through: its success closes the breaker, its failure opens it again.
+//
+// The closed state is checked with one atomic load, transitions take a
+// mutex.
+class CircuitBreaker final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Decision {
+        kAllow,
+        // The caller is the probe and must report its outcome
+        kProbe,
+        kReject
+    };
+
+    explicit CircuitBreaker(const CircuitBreakerSettings& settings);
+
+    [[nodiscard]] auto Acquire(Clock::time_point now = Clock::now())
+        -> Decision;
+
+    void OnSuccess();
+    void OnFailure(Clock::time_point now = Clock::now());
+    // Releases the probe without a verdict, e.g. when it was cut short by
+    // its caller; the next request probes again
+    void OnProbeAbandoned();
+
+    [[nodiscard]] auto IsOpen() const -> bool;
+
+private:
+    const CircuitBreakerSettings settings_;
+    std::atomic<bool> open_{false};
+    std::atomic<std::size_t> failures_{0};
+    // The critical sections never suspend, so a plain std::mutex is enough
+    std::mutex mutex_;
+    bool probing_ = false;
+    Clock::time_point open_until_;
+};
+
+} // namespace Utils
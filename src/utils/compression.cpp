@@ -0,0 +1,164 @@
+#include "compression.hpp"
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+
+namespace Utils {
+
+namespace {
+
+// windowBits for deflateInit2 that make zlib write a gzip header
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kGzipMemLevel = 8;
+
+auto Trim(std::string_view str) -> std::string_view {
+    const auto begin = str.find_first_not_of(" \t");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    const auto end = str.find_last_not_of(" \t");
+    return str.substr(begin, end - begin + 1);
+}
+
+auto EqualsIgnoreCase(std::string_view lhs, std::string_view rhs) -> bool {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        const auto lower = [](char symbol) {
+            return symbol >= 'A' && symbol <= 'Z' ? symbol - 'A' + 'a'
+                                                  : symbol;
+        };
+        if (lower(lhs[i]) != lower(rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// "gzip;q=0.5" -> 0.5, a missing or malformed weight counts as 1
+auto ParseWeight(std::string_view params) -> double {
+    const auto q = params.find("q=");
+    if (q == std::string_view::npos) {
+        return 1;
+    }
+    const auto value = Trim(params.substr(q + 2));
+    double weight = 1;
+    const auto [ptr, ec] =
+        std::from_chars(value.data(), value.data() + value.size(), weight);
+    if (ec != std::errc{}) {
+        return 1;
+    }
+    return weight;
+}
+
+auto CompressGzip(std::string_view data, int level) -> std::string {
+    z_stream stream{};
+    if (deflateInit2(
+            &stream, level, Z_DEFLATED, kGzipWindowBits, kGzipMemLevel,
+            Z_DEFAULT_STRATEGY
+        ) != Z_OK) {
+        throw std::runtime_error{"deflateInit2 failed"};
+    }
+
+    std::string compressed(deflateBound(&stream, data.size()), '\0');
+    // zlib does not modify the input despite the non-const pointer
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+
+    const auto result = deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        throw std::runtime_error{"deflate failed"};
+    }
+    return compressed;
+}
+
+auto CompressZstd(std::string_view data, int level) -> std::string {
+    std::string compressed(ZSTD_compressBound(data.size()), '\0');
+    const auto size = ZSTD_compress(
+        compressed.data(), compressed.size(), data.data(), data.size(), level
+    );
+    if (ZSTD_isError(size) != 0) {
+        throw std::runtime_error{
+            std::string{"ZSTD_compress failed: "} + ZSTD_getErrorName(size)
+        };
+    }
+    compressed.resize(size);
+    return compressed;
+}
+
+} // namespace
+
+auto NegotiateEncoding(std::string_view accept_encoding) -> ContentEncoding {
+    std::optional<double> gzip;
+    std::optional<double> zstd;
+    double any = 0;
+    while (!accept_encoding.empty()) {
+        const auto comma = accept_encoding.find(',');
+        const auto item = accept_encoding.substr(0, comma);
+        accept_encoding.remove_prefix(
+            comma == std::string_view::npos ? accept_encoding.size()
+                                            : comma + 1
+        );
+
+        const auto semicolon = item.find(';');
+        const auto name = Trim(item.substr(0, semicolon));
+        const auto weight = semicolon == std::string_view::npos
+                                ? 1.0
+                                : ParseWeight(item.substr(semicolon + 1));
+        if (EqualsIgnoreCase(name, "gzip")) {
+            gzip = weight;
+        } else if (EqualsIgnoreCase(name, "zstd")) {
+            zstd = weight;
+        } else if (name == "*") {
+            any = weight;
+        }
+    }
+
+    // "*" only covers encodings that are not listed explicitly
+    const auto zstd_weight = zstd.value_or(any);
+    const auto gzip_weight = gzip.value_or(any);
+    if (zstd_weight > 0 && zstd_weight >= gzip_weight) {
+        return ContentEncoding::kZstd;
+    }
+    if (gzip_weight > 0) {
+        return ContentEncoding::kGzip;
+    }
+    return ContentEncoding::kIdentity;
+}
+
+auto ToString(ContentEncoding encoding) -> std::string_view {
+    switch (encoding) {
+        case ContentEncoding::kGzip:
+            return "gzip";
+        case ContentEncoding::kZstd:
+            return "zstd";
+        case ContentEncoding::kIdentity:
+            break;
+    }
+    return "identity";
+}
+
+auto Compress(std::string_view data, ContentEncoding encoding, int level)
+    -> std::string {
+    switch (encoding) {
+        case ContentEncoding::kGzip:
+            return CompressGzip(data, level);
+        case ContentEncoding::kZstd:
+            return CompressZstd(data, level);
+        case ContentEncoding::kIdentity:
+            break;
+    }
+    return std::string{data};
+}
+
+} // namespace Utils
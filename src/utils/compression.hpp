@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace Utils {
+
+enum class ContentEncoding {
+    kIdentity,
+    kGzip,
+    kZstd
+};
+
+// Picks the best encoding the client accepts according to an
+// `Accept-Encoding` header value. zstd wins over gzip when both have the
+// same weight, since it is both faster and denser; encodings with q=0 are
+// refused.
+auto NegotiateEncoding(std::string_view accept_encoding) -> ContentEncoding;
+
+// Value for the `Content-Encoding` header
+auto ToString(ContentEncoding encoding) -> std::string_view;
+
+// Throws std::runtime_error if the compressor fails
+auto Compress(std::string_view data, ContentEncoding encoding, int level)
+    -> std::string;
+
+} // namespace Utils
@@ -4,4 +4,8 @@ namespace Constants {
 
 static constexpr auto kDatabaseName = "postgres-db-1";
 
+// Postgres NOTIFY channel carrying ids of changed packs, see
+// postgresql/schemas/db_1.sql
+static constexpr auto kPackChangedChannel = "quiz_pack_changed";
+
 } // namespace Constants
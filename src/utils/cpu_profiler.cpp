@@ -0,0 +1,188 @@
+#include "cpu_profiler.hpp"
+
+#include <sys/time.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <execinfo.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace Utils {
+
+namespace {
+
+constexpr std::size_t kMaxSamples = 1 << 15;
+constexpr int kMaxDepth = 32;
+// The signal handler itself and the signal trampoline
+constexpr int kSkippedFrames = 2;
+
+// Static storage, so that pages are only committed once they are written
+// to, and a late signal can never write into freed memory
+std::array<std::array<void*, kMaxDepth>, kMaxSamples> g_frames;
+// Depth of every sample, zero until the sample is complete
+std::array<std::atomic<int>, kMaxSamples> g_depths;
+std::atomic<std::size_t> g_next_sample{0};
+std::atomic<bool> g_collecting{false};
+std::atomic<bool> g_running{false};
+
+std::chrono::system_clock::time_point g_started_at;
+std::chrono::steady_clock::time_point g_started_steady;
+std::chrono::nanoseconds g_period{0};
+
+static_assert(std::atomic<int>::is_always_lock_free);
+static_assert(std::atomic<std::size_t>::is_always_lock_free);
+
+void OnProfilingSignal(int /*signal*/) {
+    if (!g_collecting.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const int saved_errno = errno;
+    const auto index = g_next_sample.fetch_add(1, std::memory_order_relaxed);
+    if (index < kMaxSamples) {
+        const int depth = backtrace(g_frames[index].data(), kMaxDepth);
+        g_depths[index].store(depth, std::memory_order_release);
+    }
+    errno = saved_errno;
+}
+
+// The handler stays installed after the first profile: restoring the
+// default action would kill the process on a SIGPROF still in flight
+void InstallHandler() {
+    static const bool installed = [] {
+        // backtrace() loads libgcc on its first call, which is not
+        // async-signal-safe, so the first call is made here
+        std::array<void*, 1> warmup{};
+        backtrace(warmup.data(), 1);
+
+        struct sigaction action {};
+        action.sa_handler = OnProfilingSignal;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        return sigaction(SIGPROF, &action, nullptr) == 0;
+    }();
+    if (!installed) {
+        throw std::runtime_error("Failed to install the SIGPROF handler");
+    }
+}
+
+void SetTimer(std::chrono::microseconds interval) {
+    itimerval timer{};
+    timer.it_interval.tv_sec = static_cast<time_t>(interval.count() / 1000000);
+    timer.it_interval.tv_usec =
+        static_cast<suseconds_t>(interval.count() % 1000000);
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+} // namespace
+
+auto StartCpuProfile(int frequency) -> bool {
+    if (g_running.exchange(true)) {
+        return false;
+    }
+    try {
+        InstallHandler();
+    } catch (...) {
+        g_running = false;
+        throw;
+    }
+
+    const auto used = std::min(g_next_sample.load(), kMaxSamples);
+    for (std::size_t i = 0; i < used; ++i) {
+        g_depths[i].store(0, std::memory_order_relaxed);
+    }
+    g_next_sample = 0;
+
+    const std::chrono::microseconds interval{
+        1000000 / std::clamp(frequency, 1, 1000)
+    };
+    g_period = interval;
+    g_started_at = std::chrono::system_clock::now();
+    g_started_steady = std::chrono::steady_clock::now();
+    g_collecting = true;
+    SetTimer(interval);
+    return true;
+}
+
+auto StopCpuProfile() -> CpuProfile {
+    SetTimer(std::chrono::microseconds{0});
+    g_collecting = false;
+
+    CpuProfile profile;
+    profile.started_at = g_started_at;
+    profile.duration = std::chrono::steady_clock::now() - g_started_steady;
+    profile.period = g_period;
+    profile.mappings = ReadExecutableMappings();
+
+    const auto taken = g_next_sample.load();
+    const auto kept = std::min(taken, kMaxSamples);
+    profile.stacks.reserve(kept);
+    for (std::size_t i = 0; i < kept; ++i) {
+        // Samples a handler is still writing are skipped
+        const auto depth = g_depths[i].load(std::memory_order_acquire);
+        if (depth <= kSkippedFrames) {
+            continue;
+        }
+        std::vector<std::uint64_t> stack;
+        stack.reserve(depth - kSkippedFrames);
+        for (int j = kSkippedFrames; j < depth; ++j) {
+            auto address = reinterpret_cast<std::uintptr_t>(g_frames[i][j]);
+            // Outer frames hold return addresses, step back into the call
+            if (j != kSkippedFrames && address != 0) {
+                --address;
+            }
+            stack.push_back(address);
+        }
+        profile.stacks.push_back(std::move(stack));
+    }
+    if (taken > kept) {
+        profile.comments.push_back(
+            "dropped samples: " + std::to_string(taken - kept)
+        );
+    }
+
+    g_running = false;
+    return profile;
+}
+
+auto ReadExecutableMappings() -> std::vector<ProfileMapping> {
+    std::vector<ProfileMapping> mappings;
+    std::ifstream maps{"/proc/self/maps"};
+    std::string line;
+    while (std::getline(maps, line)) {
+        // start-limit perms offset dev inode path
+        std::istringstream fields{line};
+        std::string range;
+        std::string perms;
+        std::string offset;
+        std::string device;
+        std::string inode;
+        std::string path;
+        fields >> range >> perms >> offset >> device >> inode >> path;
+        if (perms.size() < 3 || perms[2] != 'x' || path.empty() ||
+            path.front() != '/') {
+            continue;
+        }
+        const auto dash = range.find('-');
+        if (dash == std::string::npos) {
+            continue;
+        }
+        mappings.push_back(
+            {std::stoull(range.substr(0, dash), nullptr, 16),
+             std::stoull(range.substr(dash + 1), nullptr, 16),
+             std::stoull(offset, nullptr, 16), std::move(path)}
+        );
+    }
+    return mappings;
+}
+
+} // namespace Utils
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "utils/pprof.hpp"
+
+namespace Utils {
+
+// Signal-based CPU sampler. While a profile is running, ITIMER_PROF sends
+// SIGPROF every `1 / frequency` seconds of CPU time consumed by the process,
+// and the thread that receives it records its own call stack. Busy worker
+// threads are thus sampled in proportion to the CPU they burn, whichever
+// task processor they belong to, and idle ones are not sampled at all.
+//
+// The stacks go to a fixed preallocated buffer, samples beyond its capacity
+// are counted but dropped. Only one profile can run in the process at a
+// time.
+
+// Returns false if a profile is already running
+auto StartCpuProfile(int frequency) -> bool;
+
+// Stops the running profile and returns its samples together with the
+// executable mappings of the process
+auto StopCpuProfile() -> CpuProfile;
+
+// Executable file-backed segments from /proc/self/maps
+auto ReadExecutableMappings() -> std::vector<ProfileMapping>;
+
+} // namespace Utils
@@ -0,0 +1,66 @@
+#include "deadline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <grpcpp/server_context.h>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/utils/from_string.hpp>
+
+namespace Utils {
+
+auto DeadlineFromHttp(const userver::server::http::HttpRequest& request)
+    -> userver::engine::Deadline {
+    const auto& header = request.GetHeader(kDeadlineHeader);
+    if (header.empty()) {
+        return {};
+    }
+
+    std::int64_t budget_ms = 0;
+    try {
+        budget_ms = userver::utils::FromString<std::int64_t>(header);
+    } catch (const std::exception&) {
+        return {};
+    }
+
+    return userver::engine::Deadline::FromTimePoint(
+        request.GetStartTime() + std::chrono::milliseconds{budget_ms}
+    );
+}
+
+auto DeadlineFromGrpc(const grpc::ServerContext& context)
+    -> userver::engine::Deadline {
+    const auto deadline = context.deadline();
+    if (deadline == std::chrono::system_clock::time_point::max()) {
+        return {};
+    }
+    return userver::engine::Deadline::FromDuration(
+        deadline - std::chrono::system_clock::now()
+    );
+}
+
+auto MakeCommandControl(
+    const userver::storages::postgres::ClusterPtr& cluster,
+    userver::engine::Deadline deadline
+) -> userver::storages::postgres::OptionalCommandControl {
+    if (!deadline.IsReachable()) {
+        return std::nullopt;
+    }
+
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline.TimeLeft()
+    );
+    if (left.count() <= 0) {
+        throw DeadlineExceeded("Request deadline exceeded");
+    }
+
+    const auto defaults = cluster->GetDefaultCommandControl();
+    if (left >= defaults.network_timeout_ms) {
+        return std::nullopt;
+    }
+    return userver::storages::postgres::CommandControl{
+        left, std::min(left, defaults.statement_timeout_ms)
+    };
+}
+
+} // namespace Utils
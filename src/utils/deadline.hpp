@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdexcept>
+#include <userver/engine/deadline.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+
+namespace grpc {
+class ServerContext;
+} // namespace grpc
+
+namespace Utils {
+
+// HTTP header with the time budget of the request in milliseconds, counted
+// from the moment the request was received
+inline constexpr std::string_view kDeadlineHeader = "X-Deadline";
+
+// Thrown when the budget is exhausted before a query is sent
+class DeadlineExceeded final : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+auto DeadlineFromHttp(const userver::server::http::HttpRequest& request)
+    -> userver::engine::Deadline;
+
+auto DeadlineFromGrpc(const grpc::ServerContext& context)
+    -> userver::engine::Deadline;
+
+// Shrinks the cluster default timeouts so the query does not outlive
+// `deadline`. Returns std::nullopt if the defaults already fit, throws
+// DeadlineExceeded if there is no time left at all.
+auto MakeCommandControl(
+    const userver::storages::postgres::ClusterPtr& cluster,
+    userver::engine::Deadline deadline
+) -> userver::storages::postgres::OptionalCommandControl;
+
+} // namespace Utils
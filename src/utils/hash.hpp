@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Utils {
+
+// Hashes here are persisted or shared between instances, so unlike std::hash
+// they must be the same in every build on every platform.
+
+// splitmix64 finalizer: spreads inputs with common prefixes or few
+// significant bits over all 64 bits
+constexpr auto Mix64(std::uint64_t value) -> std::uint64_t {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+// FNV-1a with the splitmix64 finalizer, which fixes its weak low bits
+constexpr auto HashString(std::string_view str) -> std::uint64_t {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char symbol : str) {
+        hash ^= static_cast<unsigned char>(symbol);
+        hash *= 0x100000001b3ULL;
+    }
+    return Mix64(hash);
+}
+
+} // namespace Utils
@@ -0,0 +1,55 @@
+#include "hash_ring.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "hash.hpp"
+
+namespace Utils {
+
+HashRing::HashRing(std::vector<std::string> nodes, std::size_t virtual_nodes)
+    : nodes_(std::move(nodes)) {
+    if (nodes_.empty() || virtual_nodes == 0) {
+        throw std::invalid_argument("Hash ring needs nodes and points");
+    }
+    const std::unordered_set<std::string> unique{nodes_.begin(), nodes_.end()};
+    if (unique.size() != nodes_.size()) {
+        throw std::invalid_argument("Hash ring nodes must be unique");
+    }
+
+    points_.reserve(nodes_.size() * virtual_nodes);
+    for (std::size_t node = 0; node < nodes_.size(); ++node) {
+        for (std::size_t i = 0; i < virtual_nodes; ++i) {
+            points_.emplace_back(
+                HashString(nodes_[node] + '#' + std::to_string(i)), node
+            );
+        }
+    }
+    // Colliding points are ordered by name, not by position in the config
+    std::sort(
+        points_.begin(), points_.end(),
+        [this](const auto& lhs, const auto& rhs) {
+            if (lhs.first != rhs.first) {
+                return lhs.first < rhs.first;
+            }
+            return nodes_[lhs.second] < nodes_[rhs.second];
+        }
+    );
+}
+
+auto HashRing::GetNode(std::uint64_t key_hash) const -> std::size_t {
+    const auto it = std::lower_bound(
+        points_.begin(), points_.end(), key_hash,
+        [](const auto& point, std::uint64_t hash) {
+            return point.first < hash;
+        }
+    );
+    return it == points_.end() ? points_.front().second : it->second;
+}
+
+auto HashRing::GetNodes() const -> const std::vector<std::string>& {
+    return nodes_;
+}
+
+} // namespace Utils
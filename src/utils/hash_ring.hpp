@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+
+// Consistent hashing over named nodes. Every node is placed on a 64-bit
+// ring at `virtual_nodes` points, and a key belongs to the node of the first
+// point at or after its hash. Adding or removing a node only moves the keys
+// of its own points, about 1/N of them, and with enough virtual nodes the
+// keys are spread evenly.
+//
+// Points are hashed with Utils::HashString from the node names, so every
+// instance configured with the same names computes the same owners, no
+// matter the order the names are listed in.
+class HashRing final {
+public:
+    // Throws std::invalid_argument if `nodes` is empty or has duplicates
+    HashRing(std::vector<std::string> nodes, std::size_t virtual_nodes);
+
+    // Returns the index of the owner in the nodes given to the constructor
+    [[nodiscard]] auto GetNode(std::uint64_t key_hash) const -> std::size_t;
+
+    [[nodiscard]] auto GetNodes() const -> const std::vector<std::string>&;
+
+private:
+    const std::vector<std::string> nodes_;
+    // Sorted by the point hash
+    std::vector<std::pair<std::uint64_t, std::size_t>> points_;
+};
+
+} // namespace Utils
@@ -0,0 +1,68 @@
+#include "hedging.hpp"
+
+#include <algorithm>
+
+namespace Utils {
+
+namespace {
+
+constexpr double kScale = 1'000'000;
+
+} // namespace
+
+HedgeBudget::HedgeBudget(double ratio, double burst)
+    : earned_(static_cast<std::int64_t>(ratio * kScale)),
+      capacity_(static_cast<std::int64_t>(burst * kScale)),
+      tokens_(capacity_) {}
+
+void HedgeBudget::OnRequest() {
+    auto tokens = tokens_.load(std::memory_order_relaxed);
+    while (tokens < capacity_ &&
+           !tokens_.compare_exchange_weak(
+               tokens, std::min(tokens + earned_, capacity_),
+               std::memory_order_relaxed
+           )) {
+    }
+}
+
+auto HedgeBudget::TryHedge() -> bool {
+    constexpr auto kToken = static_cast<std::int64_t>(kScale);
+    auto tokens = tokens_.load(std::memory_order_relaxed);
+    while (tokens >= kToken) {
+        if (tokens_.compare_exchange_weak(
+                tokens, tokens - kToken, std::memory_order_relaxed
+            )) {
+            return true;
+        }
+    }
+    return false;
+}
+
+HedgeDelay::HedgeDelay(const HedgeDelaySettings& settings)
+    : settings_(settings),
+      delay_us_(settings.max_delay.count()),
+      histogram_(static_cast<std::uint64_t>(settings.max_delay.count())) {}
+
+void HedgeDelay::Record(std::chrono::microseconds latency) {
+    const std::lock_guard lock{mutex_};
+    histogram_.Record(static_cast<std::uint64_t>(std::max<std::int64_t>(
+        latency.count(), 0
+    )));
+    if (histogram_.Count() < settings_.window) {
+        return;
+    }
+
+    const auto delay = std::clamp<std::int64_t>(
+        static_cast<std::int64_t>(histogram_.Percentile(settings_.percentile)),
+        settings_.min_delay.count(), settings_.max_delay.count()
+    );
+    delay_us_.store(delay, std::memory_order_relaxed);
+    histogram_.Reset();
+}
+
+auto HedgeDelay::Get() const -> std::chrono::microseconds {
+    return std::chrono::microseconds{delay_us_.load(std::memory_order_relaxed)
+    };
+}
+
+} // namespace Utils
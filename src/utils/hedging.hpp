@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "utils/latency_histogram.hpp"
+
+namespace Utils {
+
+// Caps hedged requests at a share of all requests, so hedging cannot turn
+// a slow replica into a load spike. Every request earns `ratio` of a token
+// and a hedge spends one whole token; at most `burst` tokens are kept.
+// Lock-free.
+class HedgeBudget final {
+public:
+    HedgeBudget(double ratio, double burst);
+
+    // Called once per request that may be hedged
+    void OnRequest();
+
+    // Takes one token. Returns false if there is none and the request must
+    // not be hedged.
+    [[nodiscard]] auto TryHedge() -> bool;
+
+private:
+    // Tokens are counted in millionths to keep everything integer
+    const std::int64_t earned_;
+    const std::int64_t capacity_;
+    std::atomic<std::int64_t> tokens_;
+};
+
+struct HedgeDelaySettings final {
+    // Percentile of the observed latency after which a request is hedged
+    double percentile = 95;
+    std::chrono::microseconds min_delay{std::chrono::milliseconds{2}};
+    // Also used until the first window is full
+    std::chrono::microseconds max_delay{std::chrono::milliseconds{50}};
+    // Number of samples the percentile is computed over
+    std::size_t window = 1000;
+};
+
+// Tracks the latency of one kind of request and derives the hedge delay
+// from it. The histogram is recomputed and restarted every `window`
+// samples, so the delay follows changes in latency within a window.
+class HedgeDelay final {
+public:
+    explicit HedgeDelay(const HedgeDelaySettings& settings);
+
+    void Record(std::chrono::microseconds latency);
+
+    [[nodiscard]] auto Get() const -> std::chrono::microseconds;
+
+private:
+    const HedgeDelaySettings settings_;
+    std::atomic<std::int64_t> delay_us_;
+    // The critical section never suspends, so a plain std::mutex is enough
+    std::mutex mutex_;
+    LatencyHistogram histogram_;
+};
+
+} // namespace Utils
@@ -0,0 +1,101 @@
+#include "hyper_log_log.hpp"
+
+#include <bit>
+#include <cmath>
+
+#include "utils/hash.hpp"
+
+namespace Utils {
+
+namespace {
+
+constexpr std::uint8_t kRegisterMask = 0x3f;
+
+} // namespace
+
+void HyperLogLog::Add(std::string_view item) { AddHash(HashString(item)); }
+
+void HyperLogLog::AddHash(std::uint64_t hash) {
+    const auto index = static_cast<std::size_t>(hash >> (64 - kPrecision));
+    const auto rest = hash << kPrecision;
+    const auto rank = static_cast<std::uint8_t>(
+        rest == 0 ? 64 - kPrecision + 1 : std::countl_zero(rest) + 1
+    );
+    Raise(index, rank);
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+    for (std::size_t i = 0; i < kRegisters; ++i) {
+        Raise(i, other.registers_[i].load(std::memory_order_relaxed));
+    }
+}
+
+auto HyperLogLog::MergeSerialized(std::string_view serialized) -> bool {
+    if (serialized.size() != kSerializedSize) {
+        return false;
+    }
+
+    const auto byte_at = [serialized](std::size_t pos) -> std::uint32_t {
+        return static_cast<unsigned char>(serialized[pos]);
+    };
+    // Every 3 bytes hold 4 registers
+    for (std::size_t i = 0, byte = 0; i < kRegisters; i += 4, byte += 3) {
+        const auto packed = (byte_at(byte) << 16) | (byte_at(byte + 1) << 8) |
+                            byte_at(byte + 2);
+        for (std::size_t j = 0; j < 4; ++j) {
+            Raise(i + j, (packed >> (18 - 6 * j)) & kRegisterMask);
+        }
+    }
+    return true;
+}
+
+auto HyperLogLog::Serialize() const -> std::string {
+    std::string serialized(kSerializedSize, '\0');
+    for (std::size_t i = 0, byte = 0; i < kRegisters; i += 4, byte += 3) {
+        std::uint32_t packed = 0;
+        for (std::size_t j = 0; j < 4; ++j) {
+            packed = (packed << 6) |
+                     registers_[i + j].load(std::memory_order_relaxed);
+        }
+        serialized[byte] = static_cast<char>(packed >> 16);
+        serialized[byte + 1] = static_cast<char>(packed >> 8);
+        serialized[byte + 2] = static_cast<char>(packed);
+    }
+    return serialized;
+}
+
+auto HyperLogLog::Estimate() const -> std::uint64_t {
+    constexpr auto kM = static_cast<double>(kRegisters);
+    constexpr double kAlpha = 0.7213 / (1.0 + 1.079 / kM);
+
+    double sum = 0;
+    std::size_t zeros = 0;
+    for (const auto& reg : registers_) {
+        const auto rank = reg.load(std::memory_order_relaxed);
+        sum += std::ldexp(1.0, -rank);
+        zeros += rank == 0 ? 1 : 0;
+    }
+
+    const double estimate = kAlpha * kM * kM / sum;
+    // Linear counting is more precise while many registers are still empty
+    if (estimate <= 2.5 * kM && zeros != 0) {
+        return static_cast<std::uint64_t>(
+            std::llround(kM * std::log(kM / static_cast<double>(zeros)))
+        );
+    }
+    return static_cast<std::uint64_t>(std::llround(estimate));
+}
+
+void HyperLogLog::Raise(std::size_t index, std::uint8_t rank) {
+    auto& reg = registers_[index];
+    auto current = reg.load(std::memory_order_relaxed);
+    // Once warmed up almost every item hits a register that is already high
+    // enough, so the common path is a single load
+    while (current < rank &&
+           !reg.compare_exchange_weak(
+               current, rank, std::memory_order_relaxed
+           )) {
+    }
+}
+
+} // namespace Utils
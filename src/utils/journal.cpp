@@ -0,0 +1,249 @@
+#include "journal.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <system_error>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace Utils {
+
+namespace {
+
+constexpr std::size_t kHeaderSize = 8;
+constexpr std::string_view kSegmentPrefix = "segment-";
+constexpr std::string_view kSegmentSuffix = ".journal";
+
+[[noreturn]] void ThrowErrno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+auto Crc32(std::string_view data) -> std::uint32_t {
+    return static_cast<std::uint32_t>(::crc32(
+        0, reinterpret_cast<const Bytef*>(data.data()),
+        static_cast<uInt>(data.size())
+    ));
+}
+
+void AppendU32(std::string& out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+auto ReadU32(std::string_view data) -> std::uint32_t {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(
+                     static_cast<unsigned char>(data[i])
+                 )
+                 << (8 * i);
+    }
+    return value;
+}
+
+auto ReadFile(const std::string& path) -> std::string {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        ThrowErrno("open " + path);
+    }
+    std::string data;
+    char buffer[64 * 1024];
+    while (true) {
+        const auto read = ::read(fd, buffer, sizeof(buffer));
+        if (read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ::close(fd);
+            ThrowErrno("read " + path);
+        }
+        if (read == 0) {
+            break;
+        }
+        data.append(buffer, static_cast<std::size_t>(read));
+    }
+    ::close(fd);
+    return data;
+}
+
+void SyncDirectory(const std::string& dir) {
+    const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        ThrowErrno("open " + dir);
+    }
+    const int result = ::fsync(fd);
+    ::close(fd);
+    if (result != 0) {
+        ThrowErrno("fsync " + dir);
+    }
+}
+
+auto ListSegments(const std::string& dir) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> segments;
+    for (const auto& entry : std::filesystem::directory_iterator{dir}) {
+        const auto name = entry.path().filename().string();
+        if (!name.starts_with(kSegmentPrefix) ||
+            !name.ends_with(kSegmentSuffix)) {
+            continue;
+        }
+        const auto* first = name.data() + kSegmentPrefix.size();
+        const auto* last = name.data() + name.size() - kSegmentSuffix.size();
+        std::uint64_t segment = 0;
+        const auto [end, error] = std::from_chars(first, last, segment);
+        if (error == std::errc{} && end == last) {
+            segments.push_back(segment);
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+} // namespace
+
+Journal::Journal(JournalSettings settings) : settings_(std::move(settings)) {
+    std::filesystem::create_directories(settings_.dir);
+    segments_ = ListSegments(settings_.dir);
+}
+
+Journal::~Journal() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+auto Journal::Replay(const std::function<void(std::string_view)>& apply)
+    -> ReplayStats {
+    ReplayStats stats;
+    for (const auto segment : segments_) {
+        const auto path = SegmentPath(segment);
+        const auto data = ReadFile(path);
+        ++stats.segments;
+
+        std::size_t offset = 0;
+        while (offset + kHeaderSize <= data.size()) {
+            const std::string_view header{data.data() + offset, kHeaderSize};
+            const auto size = ReadU32(header);
+            if (size > data.size() - offset - kHeaderSize) {
+                break;
+            }
+            const std::string_view payload{
+                data.data() + offset + kHeaderSize, size
+            };
+            if (Crc32(payload) != ReadU32(header.substr(4))) {
+                break;
+            }
+            apply(payload);
+            ++stats.records;
+            offset += kHeaderSize + size;
+        }
+
+        if (offset != data.size()) {
+            ++stats.damaged_segments;
+            if (segment == segments_.back() &&
+                ::truncate(path.c_str(), static_cast<off_t>(offset)) != 0) {
+                ThrowErrno("truncate " + path);
+            }
+        }
+    }
+
+    OpenSegment(segments_.empty() ? 1 : segments_.back());
+    return stats;
+}
+
+void Journal::Append(const std::vector<std::string>& records) {
+    if (fd_ < 0) {
+        OpenSegment(segments_.empty() ? 1 : segments_.back());
+    }
+    WriteDurably(records);
+}
+
+auto Journal::NeedsRotation() const -> bool {
+    return segment_bytes_ >= settings_.segment_size;
+}
+
+void Journal::Rotate(const std::vector<std::string>& snapshot) {
+    const auto old_segments = segments_;
+    OpenSegment(segments_.empty() ? 1 : segments_.back() + 1);
+    WriteDurably(snapshot);
+
+    // Only once the snapshot is durable the segments it replaces can go
+    for (const auto segment : old_segments) {
+        std::filesystem::remove(SegmentPath(segment));
+    }
+    segments_.erase(
+        segments_.begin(),
+        segments_.begin() + static_cast<std::ptrdiff_t>(old_segments.size())
+    );
+}
+
+auto Journal::SegmentPath(std::uint64_t segment) const -> std::string {
+    char name[64];
+    std::snprintf(
+        name, sizeof(name), "%s%020llu%s", kSegmentPrefix.data(),
+        static_cast<unsigned long long>(segment), kSegmentSuffix.data()
+    );
+    return settings_.dir + "/" + name;
+}
+
+void Journal::OpenSegment(std::uint64_t segment) {
+    const auto path = SegmentPath(segment);
+    const int fd =
+        ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        ThrowErrno("open " + path);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    fd_ = fd;
+
+    const auto size = ::lseek(fd_, 0, SEEK_END);
+    if (size < 0) {
+        ThrowErrno("lseek " + path);
+    }
+    segment_bytes_ = static_cast<std::size_t>(size);
+    if (segments_.empty() || segments_.back() != segment) {
+        segments_.push_back(segment);
+        // The new file name must survive a crash as well
+        SyncDirectory(settings_.dir);
+    }
+}
+
+void Journal::WriteDurably(const std::vector<std::string>& records) {
+    std::string batch;
+    for (const auto& record : records) {
+        AppendU32(batch, static_cast<std::uint32_t>(record.size()));
+        AppendU32(batch, Crc32(record));
+        batch += record;
+    }
+
+    std::size_t written = 0;
+    while (written < batch.size()) {
+        const auto result =
+            ::write(fd_, batch.data() + written, batch.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const auto error = errno;
+            // A half-written batch would hide everything appended after it
+            // from replay
+            [[maybe_unused]] const auto truncated =
+                ::ftruncate(fd_, static_cast<off_t>(segment_bytes_));
+            errno = error;
+            ThrowErrno("write journal");
+        }
+        written += static_cast<std::size_t>(result);
+    }
+    segment_bytes_ += batch.size();
+    if (::fdatasync(fd_) != 0) {
+        ThrowErrno("fdatasync journal");
+    }
+}
+
+} // namespace Utils
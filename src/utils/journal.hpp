@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Utils {
+
+struct JournalSettings final {
+    std::string dir;
+    // A segment that grew past this is rotated at the next Append
+    std::size_t segment_size = 64 * 1024 * 1024;
+};
+
+// Append-only journal of opaque records in a directory of numbered
+// segments. Every record is framed as
+//
+//   u32 payload size | u32 CRC-32 of the payload | payload
+//
+// (little-endian), so a record torn by a crash or damaged on disk is
+// detected on replay.
+//
+// Append writes the whole batch with one write and makes it durable with
+// one fdatasync, which is what group commit builds on. Rotation starts a
+// new segment with a snapshot that supersedes everything before it, then
+// deletes the older segments; until they are deleted replay still reads
+// them first, so records must be idempotent state updates.
+//
+// Calls block on disk I/O, use it from the fs task processor. Not
+// thread-safe. Errors are thrown as std::system_error.
+class Journal final {
+public:
+    struct ReplayStats final {
+        std::size_t records = 0;
+        std::size_t segments = 0;
+        // Segments whose tail was cut at a damaged or torn record
+        std::size_t damaged_segments = 0;
+    };
+
+    explicit Journal(JournalSettings settings);
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    auto operator=(const Journal&) -> Journal& = delete;
+
+    // Calls `apply` for every intact record, oldest first. The last segment
+    // is truncated after its last intact record so appends continue from
+    // there. Must be called once, before the first Append.
+    auto Replay(const std::function<void(std::string_view)>& apply)
+        -> ReplayStats;
+
+    void Append(const std::vector<std::string>& records);
+
+    [[nodiscard]] auto NeedsRotation() const -> bool;
+
+    // Starts a new segment with `snapshot` and drops the older ones
+    void Rotate(const std::vector<std::string>& snapshot);
+
+private:
+    [[nodiscard]] auto SegmentPath(std::uint64_t segment) const
+        -> std::string;
+    void OpenSegment(std::uint64_t segment);
+    void WriteDurably(const std::vector<std::string>& records);
+
+    const JournalSettings settings_;
+    std::vector<std::uint64_t> segments_;
+    int fd_ = -1;
+    std::size_t segment_bytes_ = 0;
+};
+
+} // namespace Utils
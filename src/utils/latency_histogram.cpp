@@ -0,0 +1,118 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace Utils {
+
+namespace {
+
+constexpr int kSubBucketBits = 11;
+constexpr std::uint64_t kSubBucketCount = 1 << kSubBucketBits;
+constexpr std::uint64_t kSubBucketHalf = kSubBucketCount / 2;
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(std::uint64_t max_value)
+    : max_value_(std::max<std::uint64_t>(max_value, 1)),
+      counts_(IndexOf(max_value_) + 1, 0) {}
+
+auto LatencyHistogram::IndexOf(std::uint64_t value) -> std::size_t {
+    if (value < kSubBucketCount) {
+        return value;
+    }
+    const auto shift = std::bit_width(value) - kSubBucketBits;
+    return kSubBucketCount + (shift - 1) * kSubBucketHalf +
+           ((value >> shift) - kSubBucketHalf);
+}
+
+auto LatencyHistogram::HighestEquivalent(std::size_t index) -> std::uint64_t {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    const auto offset = index - kSubBucketCount;
+    const auto shift = offset / kSubBucketHalf + 1;
+    const auto sub_bucket = offset % kSubBucketHalf + kSubBucketHalf;
+    return (sub_bucket << shift) + (std::uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::Record(std::uint64_t value) {
+    value = std::min(value, max_value_);
+    ++counts_[IndexOf(value)];
+    min_ = total_count_ == 0 ? value : std::min(min_, value);
+    max_ = std::max(max_, value);
+    sum_ += value;
+    ++total_count_;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+    if (other.counts_.size() != counts_.size()) {
+        throw std::invalid_argument(
+            "Cannot merge histograms with different ranges"
+        );
+    }
+    if (other.total_count_ == 0) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    min_ = total_count_ == 0 ? other.min_ : std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+    total_count_ += other.total_count_;
+}
+
+void LatencyHistogram::Reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_count_ = 0;
+    min_ = 0;
+    max_ = 0;
+    sum_ = 0;
+}
+
+auto LatencyHistogram::Percentile(double percentile) const -> std::uint64_t {
+    if (total_count_ == 0) {
+        return 0;
+    }
+
+    const auto clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto target = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(
+               std::ceil(clamped / 100.0 * static_cast<double>(total_count_))
+           )
+    );
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= target) {
+            return std::clamp(HighestEquivalent(i), min_, max_);
+        }
+    }
+    return max_;
+}
+
+auto LatencyHistogram::Count() const -> std::uint64_t {
+    return total_count_;
+}
+
+auto LatencyHistogram::Min() const -> std::uint64_t {
+    return min_;
+}
+
+auto LatencyHistogram::Max() const -> std::uint64_t {
+    return max_;
+}
+
+auto LatencyHistogram::Mean() const -> double {
+    if (total_count_ == 0) {
+        return 0;
+    }
+    return static_cast<double>(sum_ / total_count_);
+}
+
+} // namespace Utils
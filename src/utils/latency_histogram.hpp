@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Utils {
+
+// HDR-style log-linear histogram: values below 2048 are counted exactly,
+// above that every power-of-two range is split into 1024 equal buckets, so
+// any recorded value is reproduced with a relative error below 0.1% while
+// memory stays proportional to log(max_value). Not thread-safe.
+class LatencyHistogram final {
+public:
+    // Values above `max_value` are recorded as `max_value`
+    explicit LatencyHistogram(std::uint64_t max_value);
+
+    void Record(std::uint64_t value);
+    void Merge(const LatencyHistogram& other);
+    void Reset();
+
+    // Smallest recorded value such that `percentile` percent of all recorded
+    // values are less or equal to it, up to the bucket precision
+    [[nodiscard]] auto Percentile(double percentile) const -> std::uint64_t;
+
+    [[nodiscard]] auto Count() const -> std::uint64_t;
+    [[nodiscard]] auto Min() const -> std::uint64_t;
+    [[nodiscard]] auto Max() const -> std::uint64_t;
+    [[nodiscard]] auto Mean() const -> double;
+
+private:
+    [[nodiscard]] static auto IndexOf(std::uint64_t value) -> std::size_t;
+    [[nodiscard]] static auto HighestEquivalent(std::size_t index)
+        -> std::uint64_t;
+
+    std::uint64_t max_value_;
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t total_count_ = 0;
+    std::uint64_t min_ = 0;
+    std::uint64_t max_ = 0;
+    long double sum_ = 0;
+};
+
+} // namespace Utils
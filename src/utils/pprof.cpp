@@ -0,0 +1,195 @@
+#include "pprof.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace Utils {
+
+namespace {
+
+// Field numbers of profile.proto
+namespace Profile {
+constexpr std::uint32_t kSampleType = 1;
+constexpr std::uint32_t kSample = 2;
+constexpr std::uint32_t kMapping = 3;
+constexpr std::uint32_t kLocation = 4;
+constexpr std::uint32_t kStringTable = 6;
+constexpr std::uint32_t kTimeNanos = 9;
+constexpr std::uint32_t kDurationNanos = 10;
+constexpr std::uint32_t kPeriodType = 11;
+constexpr std::uint32_t kPeriod = 12;
+constexpr std::uint32_t kComment = 13;
+} // namespace Profile
+
+constexpr std::uint32_t kWireVarint = 0;
+constexpr std::uint32_t kWireLengthDelimited = 2;
+
+// Just enough of the protobuf wire format for profile.proto
+class ProtoWriter final {
+public:
+    void Varint(std::uint64_t value) {
+        while (value >= 0x80) {
+            out_ += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        out_ += static_cast<char>(value);
+    }
+
+    void Uint(std::uint32_t field, std::uint64_t value) {
+        Varint((field << 3) | kWireVarint);
+        Varint(value);
+    }
+
+    void Bytes(std::uint32_t field, std::string_view bytes) {
+        Varint((field << 3) | kWireLengthDelimited);
+        Varint(bytes.size());
+        out_ += bytes;
+    }
+
+    void Packed(std::uint32_t field, const std::vector<std::uint64_t>& values) {
+        ProtoWriter packed;
+        for (const auto value : values) {
+            packed.Varint(value);
+        }
+        Bytes(field, packed.out_);
+    }
+
+    [[nodiscard]] auto Extract() -> std::string { return std::move(out_); }
+
+private:
+    std::string out_;
+};
+
+class StringTable final {
+public:
+    StringTable() { Index(""); }
+
+    auto Index(const std::string& str) -> std::uint64_t {
+        const auto [it, inserted] = indices_.emplace(str, strings_.size());
+        if (inserted) {
+            strings_.push_back(str);
+        }
+        return it->second;
+    }
+
+    void WriteTo(ProtoWriter& writer) const {
+        for (const auto& str : strings_) {
+            writer.Bytes(Profile::kStringTable, str);
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::uint64_t> indices_;
+    std::vector<std::string> strings_;
+};
+
+auto EncodeValueType(
+    StringTable& strings, const std::string& type, const std::string& unit
+) -> std::string {
+    ProtoWriter writer;
+    writer.Uint(1, strings.Index(type));
+    writer.Uint(2, strings.Index(unit));
+    return writer.Extract();
+}
+
+// Returns the 1-based id of the mapping containing `address`, 0 if none
+auto FindMapping(
+    const std::vector<ProfileMapping>& sorted_mappings, std::uint64_t address
+) -> std::uint64_t {
+    const auto it = std::upper_bound(
+        sorted_mappings.begin(), sorted_mappings.end(), address,
+        [](std::uint64_t value, const ProfileMapping& mapping) {
+            return value < mapping.start;
+        }
+    );
+    if (it == sorted_mappings.begin() || address >= std::prev(it)->limit) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(it - sorted_mappings.begin());
+}
+
+} // namespace
+
+auto EncodePprof(const CpuProfile& profile) -> std::string {
+    StringTable strings;
+    ProtoWriter writer;
+
+    writer.Bytes(
+        Profile::kSampleType, EncodeValueType(strings, "samples", "count")
+    );
+    writer.Bytes(
+        Profile::kSampleType, EncodeValueType(strings, "cpu", "nanoseconds")
+    );
+
+    auto mappings = profile.mappings;
+    std::ranges::sort(mappings, {}, &ProfileMapping::start);
+    for (std::size_t i = 0; i < mappings.size(); ++i) {
+        ProtoWriter mapping;
+        mapping.Uint(1, i + 1);
+        mapping.Uint(2, mappings[i].start);
+        mapping.Uint(3, mappings[i].limit);
+        mapping.Uint(4, mappings[i].offset);
+        mapping.Uint(5, strings.Index(mappings[i].file));
+        writer.Bytes(Profile::kMapping, mapping.Extract());
+    }
+
+    // Equal stacks become one sample, every address one location
+    std::map<std::vector<std::uint64_t>, std::uint64_t> counts;
+    for (const auto& stack : profile.stacks) {
+        ++counts[stack];
+    }
+    std::unordered_map<std::uint64_t, std::uint64_t> location_ids;
+    const auto period = static_cast<std::uint64_t>(profile.period.count());
+    for (const auto& [stack, count] : counts) {
+        std::vector<std::uint64_t> locations;
+        locations.reserve(stack.size());
+        for (const auto address : stack) {
+            const auto [it, inserted] =
+                location_ids.emplace(address, location_ids.size() + 1);
+            if (inserted) {
+                ProtoWriter location;
+                location.Uint(1, it->second);
+                if (const auto mapping = FindMapping(mappings, address)) {
+                    location.Uint(2, mapping);
+                }
+                location.Uint(3, address);
+                writer.Bytes(Profile::kLocation, location.Extract());
+            }
+            locations.push_back(it->second);
+        }
+
+        ProtoWriter sample;
+        sample.Packed(1, locations);
+        sample.Packed(2, {count, count * period});
+        writer.Bytes(Profile::kSample, sample.Extract());
+    }
+
+    using std::chrono::nanoseconds;
+    const auto started_at = std::chrono::duration_cast<nanoseconds>(
+        profile.started_at.time_since_epoch()
+    );
+    writer.Uint(
+        Profile::kTimeNanos, static_cast<std::uint64_t>(started_at.count())
+    );
+    writer.Uint(
+        Profile::kDurationNanos,
+        static_cast<std::uint64_t>(profile.duration.count())
+    );
+    writer.Bytes(
+        Profile::kPeriodType, EncodeValueType(strings, "cpu", "nanoseconds")
+    );
+    writer.Uint(Profile::kPeriod, period);
+    for (const auto& comment : profile.comments) {
+        writer.Uint(Profile::kComment, strings.Index(comment));
+    }
+
+    strings.WriteTo(writer);
+    return writer.Extract();
+}
+
+} // namespace Utils
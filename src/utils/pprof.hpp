@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Utils {
+
+// An executable segment of the process, lets pprof map addresses back to
+// the binary and the shared libraries for symbolization
+struct ProfileMapping final {
+    std::uint64_t start = 0;
+    std::uint64_t limit = 0;
+    std::uint64_t offset = 0;
+    std::string file;
+};
+
+struct CpuProfile final {
+    // Call stacks of the samples, innermost frame first. Equal stacks are
+    // merged into one sample when encoding.
+    std::vector<std::vector<std::uint64_t>> stacks;
+    std::vector<ProfileMapping> mappings;
+    std::chrono::system_clock::time_point started_at;
+    std::chrono::nanoseconds duration{0};
+    // CPU time between two samples
+    std::chrono::nanoseconds period{0};
+    // Free-form lines shown by `pprof -comments`
+    std::vector<std::string> comments;
+};
+
+// Encodes the profile as a perftools profile.proto message, uncompressed.
+// Every sample has two values: the number of samples and the CPU time in
+// nanoseconds. Addresses are left unsymbolized; `pprof <binary> <profile>`
+// resolves them through the mappings.
+auto EncodePprof(const CpuProfile& profile) -> std::string;
+
+} // namespace Utils
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/shared_task_with_result.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+#include "utils/deadline.hpp"
+
+namespace Utils {
+
+// Collapses concurrent calls with equal keys into one execution of the
+// producer. The first caller starts the producer in a shared task, everyone
+// who comes while it is in flight waits for the same result (or exception).
+// The key is forgotten once the flight lands, so nothing is cached between
+// flights.
+//
+// The producer may outlive the caller that started it, so it must capture
+// everything it needs by value.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SingleFlight final {
+public:
+    explicit SingleFlight(std::string_view name) : name_(name) {}
+
+    template <typename Producer>
+    auto Execute(const Key& key, Producer&& producer) -> Value {
+        return Execute(key, {}, std::forward<Producer>(producer));
+    }
+
+    // Waits for the flight until `deadline` at most, then throws
+    // DeadlineExceeded and leaves the flight to the others. The producer is
+    // shared, so it must not depend on the deadline of any single caller.
+    template <typename Producer>
+    auto Execute(
+        const Key& key, userver::engine::Deadline deadline,
+        Producer&& producer
+    ) -> Value {
+        Flight flight;
+        {
+            const std::lock_guard lock{mutex_};
+            auto& slot = in_flight_[key];
+            // A landed flight is still here if everyone waiting for it was
+            // cancelled before it landed
+            if (!slot.task.IsValid() || slot.task.IsFinished()) {
+                slot = Flight{
+                    ++last_id_,
+                    userver::utils::SharedAsync(
+                        std::string{name_}, std::forward<Producer>(producer)
+                    )
+                };
+            }
+            flight = slot;
+        }
+
+        // Any caller that sees the flight land forgets it. A cancelled
+        // caller leaves it in place, so the callers still waiting and the
+        // ones yet to come keep sharing it instead of starting another.
+        const userver::utils::ScopeGuard forget{[this, &key, &flight] {
+            if (flight.task.IsFinished()) {
+                Forget(key, flight.id);
+            }
+        }};
+        flight.task.WaitUntil(deadline);
+        if (!flight.task.IsFinished()) {
+            throw DeadlineExceeded("Request deadline exceeded");
+        }
+        return flight.task.Get();
+    }
+
+private:
+    struct Flight final {
+        std::uint64_t id = 0;
+        userver::engine::SharedTaskWithResult<Value> task;
+    };
+
+    void Forget(const Key& key, std::uint64_t id) {
+        const std::lock_guard lock{mutex_};
+        const auto it = in_flight_.find(key);
+        if (it != in_flight_.end() && it->second.id == id) {
+            in_flight_.erase(it);
+        }
+    }
+
+    std::string_view name_;
+    userver::engine::Mutex mutex_;
+    std::unordered_map<Key, Flight, Hash> in_flight_;
+    std::uint64_t last_id_ = 0;
+};
+
+} // namespace Utils
@@ -0,0 +1,95 @@
+#include "task_processor_metrics.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+#include <userver/utils/statistics/storage.hpp>
+#include <utility>
+
+namespace Utils {
+
+namespace statistics = userver::utils::statistics;
+
+namespace {
+
+constexpr std::string_view kPrefix = "engine.task-processors";
+constexpr std::string_view kTaskProcessorLabel = "task_processor";
+
+class MetricsCollector final : public statistics::BaseFormatBuilder {
+public:
+    void HandleMetric(
+        std::string_view path, statistics::LabelsSpan labels,
+        const statistics::MetricValue& value
+    ) override {
+        std::string_view task_processor;
+        for (const auto& label : labels) {
+            if (label.Name() == kTaskProcessorLabel) {
+                task_processor = label.Value();
+            }
+        }
+        if (task_processor.empty() || value.IsHistogram()) {
+            return;
+        }
+
+        path.remove_prefix(std::min(path.size(), kPrefix.size() + 1));
+        auto& metric =
+            metrics_[std::string{task_processor}][std::string{path}];
+        value.Visit([&metric](const auto& raw) {
+            using Raw = std::decay_t<decltype(raw)>;
+            if constexpr (std::is_same_v<Raw, statistics::Rate>) {
+                metric = {static_cast<double>(raw.value), true};
+            } else if constexpr (std::is_arithmetic_v<Raw>) {
+                metric = {static_cast<double>(raw), false};
+            }
+        });
+    }
+
+    auto Extract() -> std::map<std::string, TaskProcessorMetrics> {
+        return std::move(metrics_);
+    }
+
+private:
+    std::map<std::string, TaskProcessorMetrics> metrics_;
+};
+
+} // namespace
+
+auto ReadTaskProcessorMetrics(
+    const statistics::Storage& storage
+) -> std::map<std::string, TaskProcessorMetrics> {
+    MetricsCollector collector;
+    storage.VisitMetrics(
+        collector,
+        statistics::Request::MakeWithPrefix(std::string{kPrefix})
+    );
+    return collector.Extract();
+}
+
+auto GetCounterRates(
+    const std::map<std::string, TaskProcessorMetrics>& before,
+    const std::map<std::string, TaskProcessorMetrics>& after,
+    std::chrono::steady_clock::duration interval
+) -> std::map<std::string, std::map<std::string, double>> {
+    const auto seconds = std::chrono::duration<double>(interval).count();
+    std::map<std::string, std::map<std::string, double>> rates;
+    if (seconds <= 0) {
+        return rates;
+    }
+    for (const auto& [task_processor, metrics] : after) {
+        const auto previous = before.find(task_processor);
+        if (previous == before.end()) {
+            continue;
+        }
+        for (const auto& [path, metric] : metrics) {
+            const auto old = previous->second.find(path);
+            if (!metric.is_counter || old == previous->second.end()) {
+                continue;
+            }
+            rates[task_processor][path] =
+                (metric.value - old->second.value) / seconds;
+        }
+    }
+    return rates;
+}
+
+} // namespace Utils
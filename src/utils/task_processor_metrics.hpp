@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <userver/utils/statistics/fwd.hpp>
+
+namespace Utils {
+
+struct TaskProcessorMetric final {
+    double value = 0;
+    // Monotonic counter (a statistics::Rate), meaningful as a per second rate
+    bool is_counter = false;
+};
+
+// Metric path relative to `engine.task-processors` -> its value
+using TaskProcessorMetrics = std::map<std::string, TaskProcessorMetric>;
+
+// Task processor name -> its metrics: queue length, alive and running
+// tasks (coroutines), context switches, worker threads, etc. These are the
+// numbers userver itself reports through the statistics storage, read
+// here without going through the monitor handler.
+auto ReadTaskProcessorMetrics(
+    const userver::utils::statistics::Storage& storage
+) -> std::map<std::string, TaskProcessorMetrics>;
+
+// Per second growth of every counter from `before` to `after`
+auto GetCounterRates(
+    const std::map<std::string, TaskProcessorMetrics>& before,
+    const std::map<std::string, TaskProcessorMetrics>& after,
+    std::chrono::steady_clock::duration interval
+) -> std::map<std::string, std::map<std::string, double>>;
+
+} // namespace Utils
@@ -0,0 +1,57 @@
+#include "text_escape.hpp"
+
+#include <cstdio>
+
+namespace Utils {
+
+void AppendJsonString(std::string& out, std::string_view str) {
+    out += '"';
+    for (const char symbol : str) {
+        switch (symbol) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(symbol) < 0x20) {
+                    char escaped[7];
+                    std::snprintf(
+                        escaped, sizeof(escaped), "\\u%04x",
+                        static_cast<unsigned>(symbol)
+                    );
+                    out += escaped;
+                } else {
+                    out += symbol;
+                }
+        }
+    }
+    out += '"';
+}
+
+void AppendCsvField(std::string& out, std::string_view str) {
+    if (str.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out += str;
+        return;
+    }
+    out += '"';
+    for (const char symbol : str) {
+        if (symbol == '"') {
+            out += '"';
+        }
+        out += symbol;
+    }
+    out += '"';
+}
+
+} // namespace Utils
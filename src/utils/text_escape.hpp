@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace Utils {
+
+// Hand-rolled writers for text formats that are produced line by line, where
+// building a formats::json::Value per record would cost more than the
+// record itself.
+
+// Appends `str` as a quoted JSON string
+void AppendJsonString(std::string& out, std::string_view str);
+
+// Appends `str` as one RFC 4180 CSV field: quoted only if it contains a
+// separator, a quote or a line break, with quotes doubled
+void AppendCsvField(std::string& out, std::string_view str);
+
+} // namespace Utils
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+
+// Hierarchical timing wheel: four levels of 64 slots, a tick of `tick`
+// on the first level and 64 times coarser on every next one, so it covers
+// 64^4 ticks (almost two days with a 10ms tick) and later timers are
+// clamped to that horizon.
+//
+// Schedule and Cancel are O(1): a timer is a node of an intrusive list in
+// one slot, nodes live in a pool and are recycled. Advance walks the ticks
+// that passed, moving timers of a coarse slot one level down when the finer
+// level wraps around, so a timer is touched at most once per level.
+//
+// Timers fire no earlier than scheduled: by the first Advance that reaches
+// the tick their time rounds up to, in no particular order within a tick.
+// A timer scheduled for the past waits for the next tick. Not thread-safe.
+template <typename Payload>
+class TimerWheel final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Generation-checked handle: cancelling a timer that already fired or
+    // was cancelled, even if its node was reused since, is a no-op
+    struct TimerId final {
+        std::uint32_t index = kNone;
+        std::uint32_t generation = 0;
+    };
+
+    TimerWheel(Clock::duration tick, Clock::time_point start)
+        : tick_(tick), start_(start) {
+        for (auto& level : slots_) {
+            level.fill(kNone);
+        }
+    }
+
+    auto Schedule(Clock::time_point when, Payload payload) -> TimerId {
+        const auto index = AllocateNode();
+        auto& node = nodes_[index];
+        node.payload = std::move(payload);
+        node.expires = std::max(ToTick(when), current_);
+        Link(index);
+        ++size_;
+        return {index, node.generation};
+    }
+
+    // Returns false if the timer has already fired or was cancelled
+    auto Cancel(TimerId timer) -> bool {
+        if (timer.index >= nodes_.size()) {
+            return false;
+        }
+        auto& node = nodes_[timer.index];
+        if (node.generation != timer.generation || node.slot == kNone) {
+            return false;
+        }
+        Unlink(timer.index);
+        FreeNode(timer.index);
+        --size_;
+        return true;
+    }
+
+    // Fires `fire(Payload&&)` for every timer due by `now`, in order of
+    // their ticks. `fire` may schedule and cancel timers.
+    template <typename Fire>
+    auto Advance(Clock::time_point now, Fire&& fire) -> std::size_t {
+        const auto target = ToTickFloor(now);
+        std::size_t fired = 0;
+        while (current_ <= target) {
+            const auto slot = current_ & kSlotMask;
+            if (slot == 0) {
+                Cascade(1);
+            }
+            auto index = std::exchange(slots_[0][slot], kNone);
+            // Timers scheduled by `fire` go to the next tick at the earliest
+            ++current_;
+            while (index != kNone) {
+                auto& node = nodes_[index];
+                const auto next = node.next;
+                auto payload = std::move(node.payload);
+                node.slot = kNone;
+                FreeNode(index);
+                --size_;
+                ++fired;
+                fire(std::move(payload));
+                index = next;
+            }
+        }
+        return fired;
+    }
+
+    [[nodiscard]] auto Size() const -> std::size_t { return size_; }
+
+    // When the next unprocessed tick starts
+    [[nodiscard]] auto GetNextTickTime() const -> Clock::time_point {
+        return start_ + tick_ * static_cast<Clock::rep>(current_);
+    }
+
+private:
+    static constexpr std::uint32_t kNone =
+        std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t kLevels = 4;
+    static constexpr std::uint64_t kSlotBits = 6;
+    static constexpr std::uint64_t kSlots = 1 << kSlotBits;
+    static constexpr std::uint64_t kSlotMask = kSlots - 1;
+    static constexpr std::uint64_t kHorizon =
+        (std::uint64_t{1} << (kSlotBits * kLevels)) - 1;
+
+    struct Node final {
+        Payload payload{};
+        std::uint64_t expires = 0;
+        std::uint32_t prev = kNone;
+        std::uint32_t next = kNone;
+        // level * kSlots + slot while armed, kNone while free
+        std::uint32_t slot = kNone;
+        std::uint32_t generation = 0;
+    };
+
+    auto ToTickFloor(Clock::time_point time) const -> std::uint64_t {
+        if (time < start_) {
+            return 0;
+        }
+        return static_cast<std::uint64_t>((time - start_) / tick_);
+    }
+
+    // Rounded up, so a timer never fires early
+    auto ToTick(Clock::time_point time) const -> std::uint64_t {
+        const auto tick = ToTickFloor(time);
+        return start_ + tick_ * static_cast<Clock::rep>(tick) < time
+                   ? tick + 1
+                   : tick;
+    }
+
+    auto AllocateNode() -> std::uint32_t {
+        if (free_ == kNone) {
+            nodes_.emplace_back();
+            return static_cast<std::uint32_t>(nodes_.size() - 1);
+        }
+        const auto index = free_;
+        free_ = nodes_[index].next;
+        return index;
+    }
+
+    void FreeNode(std::uint32_t index) {
+        auto& node = nodes_[index];
+        node.payload = Payload{};
+        ++node.generation;
+        node.prev = kNone;
+        node.next = free_;
+        free_ = index;
+    }
+
+    void Link(std::uint32_t index) {
+        auto& node = nodes_[index];
+        const auto delta = std::min(node.expires - current_, kHorizon);
+        node.expires = current_ + delta;
+
+        std::size_t level = 0;
+        while (level + 1 < kLevels &&
+               delta >= (std::uint64_t{1} << (kSlotBits * (level + 1)))) {
+            ++level;
+        }
+        const auto slot = static_cast<std::uint32_t>(
+            (node.expires >> (kSlotBits * level)) & kSlotMask
+        );
+
+        auto& head = slots_[level][slot];
+        node.slot = static_cast<std::uint32_t>(level * kSlots + slot);
+        node.prev = kNone;
+        node.next = head;
+        if (head != kNone) {
+            nodes_[head].prev = index;
+        }
+        head = index;
+    }
+
+    void Unlink(std::uint32_t index) {
+        auto& node = nodes_[index];
+        if (node.prev != kNone) {
+            nodes_[node.prev].next = node.next;
+        } else {
+            slots_[node.slot / kSlots][node.slot % kSlots] = node.next;
+        }
+        if (node.next != kNone) {
+            nodes_[node.next].prev = node.prev;
+        }
+        node.slot = kNone;
+    }
+
+    // Re-links the timers of the slot of `level` that `current_` enters,
+    // which puts them one level lower or more
+    void Cascade(std::size_t level) {
+        if (level >= kLevels) {
+            return;
+        }
+        const auto slot = (current_ >> (kSlotBits * level)) & kSlotMask;
+        if (slot == 0) {
+            Cascade(level + 1);
+        }
+        auto index = std::exchange(slots_[level][slot], kNone);
+        while (index != kNone) {
+            const auto next = nodes_[index].next;
+            Link(index);
+            index = next;
+        }
+    }
+
+    const Clock::duration tick_;
+    const Clock::time_point start_;
+    // The next tick Advance processes
+    std::uint64_t current_ = 0;
+    std::size_t size_ = 0;
+    std::uint32_t free_ = kNone;
+    std::vector<Node> nodes_;
+    std::array<std::array<std::uint32_t, kSlots>, kLevels> slots_{};
+};
+
+} // namespace Utils
@@ -0,0 +1,83 @@
+#include "token_bucket_table.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "utils/hash.hpp"
+
+namespace Utils {
+
+namespace {
+
+// Sweeping tiny shards is not worth it
+constexpr std::size_t kMinSweepSize = 64;
+
+auto SecondsToDuration(double seconds) -> TokenBucketTable::Clock::duration {
+    return std::chrono::duration_cast<TokenBucketTable::Clock::duration>(
+        std::chrono::duration<double>{seconds}
+    );
+}
+
+} // namespace
+
+TokenBucketTable::TokenBucketTable(std::size_t shards)
+    : shard_mask_(std::bit_ceil(std::max<std::size_t>(shards, 1)) - 1),
+      shards_(std::make_unique<Shard[]>(shard_mask_ + 1)) {}
+
+auto TokenBucketTable::TryAcquire(
+    std::string_view key, const TokenBucketSettings& settings,
+    Clock::time_point now
+) -> bool {
+    if (settings.rate <= 0) {
+        return true;
+    }
+
+    // Upper bits pick the shard, std::hash inside it uses its own
+    auto& shard = shards_[(HashString(key) >> 32) & shard_mask_];
+    const std::lock_guard lock{shard.mutex};
+
+    auto it = shard.buckets.find(key);
+    if (it == shard.buckets.end()) {
+        if (shard.buckets.size() >= shard.sweep_at) {
+            Sweep(shard, now);
+        }
+        it = shard.buckets.emplace(key, Bucket{settings.burst, now, now})
+                 .first;
+    }
+
+    auto& bucket = it->second;
+    const std::chrono::duration<double> elapsed = now - bucket.updated_at;
+    bucket.tokens = std::min(
+        settings.burst,
+        bucket.tokens + std::max(elapsed.count(), 0.0) * settings.rate
+    );
+    bucket.updated_at = std::max(bucket.updated_at, now);
+
+    const bool acquired = bucket.tokens >= 1;
+    if (acquired) {
+        bucket.tokens -= 1;
+    }
+    bucket.full_at = bucket.updated_at +
+                     SecondsToDuration(
+                         (settings.burst - bucket.tokens) / settings.rate
+                     );
+    return acquired;
+}
+
+auto TokenBucketTable::GetSize() const -> std::size_t {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i <= shard_mask_; ++i) {
+        const std::lock_guard lock{shards_[i].mutex};
+        size += shards_[i].buckets.size();
+    }
+    return size;
+}
+
+void TokenBucketTable::Sweep(Shard& shard, Clock::time_point now) {
+    std::erase_if(shard.buckets, [now](const auto& item) {
+        return item.second.full_at <= now;
+    });
+    shard.sweep_at = std::max(kMinSweepSize, shard.buckets.size() * 2);
+}
+
+} // namespace Utils
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Utils {
+
+struct TokenBucketSettings final {
+    // Tokens added per second, zero or less means unlimited
+    double rate = 0;
+    // Bucket capacity, the largest burst allowed after a quiet period
+    double burst = 1;
+};
+
+// Token buckets for an unbounded set of keys (players, addresses, ...).
+//
+// The table is split into lock-striped shards chosen by the key hash, so
+// checks of different keys rarely touch the same mutex and a check is a
+// hash, a short critical section and no allocation for a known key.
+//
+// A bucket that was left alone long enough to refill is indistinguishable
+// from a missing one, so such buckets are dropped lazily: a shard sweeps
+// them out whenever it has doubled in size since the last sweep, which keeps
+// memory proportional to the keys active within one refill period.
+class TokenBucketTable final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // `shards` is rounded up to a power of two
+    explicit TokenBucketTable(std::size_t shards = 64);
+
+    // Takes one token from the bucket of `key`. Returns false if it is empty.
+    [[nodiscard]] auto TryAcquire(
+        std::string_view key, const TokenBucketSettings& settings,
+        Clock::time_point now = Clock::now()
+    ) -> bool;
+
+    // Number of buckets currently stored, for tests
+    [[nodiscard]] auto GetSize() const -> std::size_t;
+
+private:
+    struct Bucket final {
+        double tokens;
+        Clock::time_point updated_at;
+        // When the bucket is full again if nobody touches it
+        Clock::time_point full_at;
+    };
+
+    struct StringHash final {
+        using is_transparent = void;
+
+        auto operator()(std::string_view str) const -> std::size_t {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    // Aligned to keep neighbouring mutexes off each other's cache lines. The
+    // critical section never suspends, so a plain std::mutex is enough
+    struct alignas(64) Shard final {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Bucket, StringHash, std::equal_to<>>
+            buckets;
+        std::size_t sweep_at = 0;
+    };
+
+    static void Sweep(Shard& shard, Clock::time_point now);
+
+    std::size_t shard_mask_;
+    std::unique_ptr<Shard[]> shards_;
+};
+
+} // namespace Utils
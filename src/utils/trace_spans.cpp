@@ -0,0 +1,98 @@
+#include "trace_spans.hpp"
+
+#include <cstdint>
+#include <limits>
+
+#include "utils/hash.hpp"
+#include "utils/text_escape.hpp"
+
+namespace Utils {
+
+namespace {
+
+// int64 fields are strings in OTLP/JSON
+void AppendUnixNano(
+    std::string& out, std::chrono::system_clock::time_point time
+) {
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        time.time_since_epoch()
+    );
+    out += '"';
+    out += std::to_string(nanos.count());
+    out += '"';
+}
+
+void AppendStringAttribute(
+    std::string& out, std::string_view key, std::string_view value
+) {
+    out += R"({"key":)";
+    AppendJsonString(out, key);
+    out += R"(,"value":{"stringValue":)";
+    AppendJsonString(out, value);
+    out += "}}";
+}
+
+void AppendSpan(std::string& out, const TraceSpanRecord& span) {
+    out += R"({"traceId":)";
+    AppendJsonString(out, span.trace_id);
+    out += R"(,"spanId":)";
+    AppendJsonString(out, span.span_id);
+    if (!span.parent_span_id.empty()) {
+        out += R"(,"parentSpanId":)";
+        AppendJsonString(out, span.parent_span_id);
+    }
+    out += R"(,"name":)";
+    AppendJsonString(out, span.name);
+    // SPAN_KIND_INTERNAL
+    out += R"(,"kind":1,"startTimeUnixNano":)";
+    AppendUnixNano(out, span.start);
+    out += R"(,"endTimeUnixNano":)";
+    AppendUnixNano(out, span.end);
+    out += R"(,"attributes":[)";
+    for (std::size_t i = 0; i < span.attributes.size(); ++i) {
+        if (i != 0) {
+            out += ',';
+        }
+        AppendStringAttribute(
+            out, span.attributes[i].first, span.attributes[i].second
+        );
+    }
+    out += "]}";
+}
+
+} // namespace
+
+auto IsTraceSampled(std::string_view trace_id, double rate) -> bool {
+    if (rate <= 0.0) {
+        return false;
+    }
+    if (rate >= 1.0) {
+        return true;
+    }
+    const auto threshold = static_cast<std::uint64_t>(
+        rate * static_cast<double>(std::numeric_limits<std::uint64_t>::max())
+    );
+    return HashString(trace_id) < threshold;
+}
+
+auto FormatOtlpJson(
+    std::string_view service_name, const std::vector<TraceSpanRecord>& spans
+) -> std::string {
+    std::string out;
+    out.reserve(256 + spans.size() * 320);
+    out += R"({"resourceSpans":[{"resource":{"attributes":[)";
+    AppendStringAttribute(out, "service.name", service_name);
+    out += R"(]},"scopeSpans":[{"scope":{"name":)";
+    AppendJsonString(out, service_name);
+    out += R"(},"spans":[)";
+    for (std::size_t i = 0; i < spans.size(); ++i) {
+        if (i != 0) {
+            out += ',';
+        }
+        AppendSpan(out, spans[i]);
+    }
+    out += "]}]}]}";
+    return out;
+}
+
+} // namespace Utils
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+
+// A finished span as it is exported
+struct TraceSpanRecord final {
+    std::string name;
+    // Hex ids as generated by userver tracing: 32 digits for the trace and
+    // 16 for spans. The parent is empty for a root span.
+    std::string trace_id;
+    std::string span_id;
+    std::string parent_span_id;
+    std::chrono::system_clock::time_point start;
+    std::chrono::system_clock::time_point end;
+    std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+// Sampling is decided by the trace id alone, so every instance and every
+// span of a request agrees on it and sampled timelines are complete.
+auto IsTraceSampled(std::string_view trace_id, double rate) -> bool;
+
+// Renders spans as one OTLP/JSON ExportTraceServiceRequest: the body an
+// OpenTelemetry collector accepts on /v1/traces, and one line of what its
+// file exporter writes.
+auto FormatOtlpJson(
+    std::string_view service_name, const std::vector<TraceSpanRecord>& spans
+) -> std::string;
+
+} // namespace Utils
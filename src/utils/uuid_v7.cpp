@@ -0,0 +1,72 @@
+#include "uuid_v7.hpp"
+
+#include <random>
+
+namespace Utils {
+
+namespace {
+
+constexpr int kSequenceBits = 12;
+
+auto RandomBits() -> std::uint64_t {
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+    return engine();
+}
+
+} // namespace
+
+auto UuidV7Generator::Generate() -> boost::uuids::uuid {
+    return Generate(Clock::now());
+}
+
+auto UuidV7Generator::Generate(Clock::time_point now) -> boost::uuids::uuid {
+    const auto millis = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            now.time_since_epoch()
+        )
+            .count()
+    );
+    const auto fresh = millis << kSequenceBits;
+
+    auto last = last_.load(std::memory_order_relaxed);
+    std::uint64_t next = 0;
+    do {
+        // A clock going backwards must not reorder ids either
+        next = fresh > last ? fresh : last + 1;
+    } while (!last_.compare_exchange_weak(
+        last, next, std::memory_order_relaxed
+    ));
+
+    const auto random = RandomBits();
+    boost::uuids::uuid id{};
+    // unix_ts_ms, 48 bits
+    for (int i = 0; i < 6; ++i) {
+        id.data[i] = static_cast<std::uint8_t>(
+            next >> (kSequenceBits + 40 - 8 * i)
+        );
+    }
+    // Version 7 and the lower 12 bits: the sequence
+    id.data[6] = static_cast<std::uint8_t>(0x70 | ((next >> 8) & 0x0f));
+    id.data[7] = static_cast<std::uint8_t>(next);
+    // Variant 10 and 62 random bits
+    id.data[8] = static_cast<std::uint8_t>(0x80 | (random >> 58));
+    for (int i = 9; i < 16; ++i) {
+        id.data[i] = static_cast<std::uint8_t>(random >> (8 * (15 - i)));
+    }
+    return id;
+}
+
+auto GenerateUuidV7() -> boost::uuids::uuid {
+    static UuidV7Generator generator;
+    return generator.Generate();
+}
+
+auto GetUuidV7Millis(const boost::uuids::uuid& id) -> std::uint64_t {
+    std::uint64_t millis = 0;
+    for (int i = 0; i < 6; ++i) {
+        millis = (millis << 8) | id.data[i];
+    }
+    return millis;
+}
+
+} // namespace Utils
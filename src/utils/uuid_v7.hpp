@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <boost/uuid/uuid.hpp>
+#include <chrono>
+#include <cstdint>
+
+namespace Utils {
+
+// Time-ordered UUIDv7 (RFC 9562): 48 bits of Unix milliseconds, then a
+// 12-bit sequence in rand_a, then 62 random bits. Ids made by one generator
+// strictly increase even within a millisecond, so inserts land on the right
+// edge of the primary key index instead of on random pages.
+//
+// The timestamp and the sequence share one atomic word. When the sequence
+// of a millisecond runs out it carries into the timestamp, which then runs
+// slightly ahead of the clock until the clock catches up. Lock-free and safe
+// to share between threads.
+class UuidV7Generator final {
+public:
+    using Clock = std::chrono::system_clock;
+
+    [[nodiscard]] auto Generate() -> boost::uuids::uuid;
+
+    // For tests
+    [[nodiscard]] auto Generate(Clock::time_point now) -> boost::uuids::uuid;
+
+private:
+    // Unix milliseconds << 12 | sequence
+    std::atomic<std::uint64_t> last_{0};
+};
+
+// Uses a process-wide generator
+auto GenerateUuidV7() -> boost::uuids::uuid;
+
+// Unix milliseconds stored in a UUIDv7
+auto GetUuidV7Millis(const boost::uuids::uuid& id) -> std::uint64_t;
+
+} // namespace Utils
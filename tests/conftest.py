@@ -4,6 +4,7 @@ import os
 
 import handlers.hello_pb2_grpc as hello_services
 import handlers.cruds_pb2_grpc as grpc_handlers_service
+import handlers.live_pb2_grpc as live_services
 import handlers.cruds_pb2 as service
 import pytest
 
@@ -33,6 +34,11 @@ def grpc_handlers(grpc_channel, service_client):
     return grpc_handlers_service.QuizServiceStub(grpc_channel)
 
 
+@pytest.fixture
+def grpc_live(grpc_channel, service_client):
+    return live_services.LiveSessionServiceStub(grpc_channel)
+
+
 @pytest.fixture
 def sample_pack_title():
     return "Science Quiz"
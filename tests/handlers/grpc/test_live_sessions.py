@@ -0,0 +1,67 @@
+import json
+import uuid
+
+import grpc
+import pytest
+import handlers.live_pb2 as live
+from helpers.endpoints import (
+    create_pack,
+    create_question_with_variants,
+    get_live_session,
+    publish_pack,
+)
+
+
+@pytest.fixture
+async def published_pack(service_client):
+    pack = await create_pack(service_client, 'Forwarded')
+    await create_question_with_variants(
+        service_client,
+        pack["id"],
+        "Question",
+        [{"text": "right", "is_correct": True}]
+    )
+    return await publish_pack(service_client, pack["id"])
+
+
+async def test_forwarded_start_is_served_locally(
+    grpc_live, service_client, published_pack
+):
+    session_id = str(uuid.uuid4())
+    request = live.StartLiveSessionRequest(  # type: ignore
+        session_id=session_id,
+        pack_id=published_pack["pack_id"],
+        version=published_pack["version"],
+        round_duration_ms=30000,
+    )
+    response = await grpc_live.StartSession(request)
+    session = json.loads(response.session_json)
+    assert session["id"] == session_id
+    assert session["question_index"] == 0
+
+    # Starting it again, e.g. on a retry, returns the same session
+    response = await grpc_live.StartSession(request)
+    assert json.loads(response.session_json)["id"] == session_id
+
+    # A single instance owns every session, so HTTP sees it as well
+    fetched = await get_live_session(service_client, session_id)
+    assert fetched["id"] == session_id
+
+    response = await grpc_live.NextQuestion(
+        live.LiveSessionRequest(session_id=session_id)  # type: ignore
+    )
+    assert json.loads(response.session_json)["finished"]
+
+
+async def test_forwarded_unknown_session(grpc_live):
+    request = live.LiveSessionRequest(session_id=str(uuid.uuid4()))  # type: ignore
+    with pytest.raises(grpc.RpcError) as exc_info:
+        await grpc_live.GetSession(request)
+    assert exc_info.value.code() == grpc.StatusCode.NOT_FOUND
+
+
+async def test_forwarded_bad_id(grpc_live):
+    request = live.LiveSessionRequest(session_id="nope")  # type: ignore
+    with pytest.raises(grpc.RpcError) as exc_info:
+        await grpc_live.NextQuestion(request)
+    assert exc_info.value.code() == grpc.StatusCode.INVALID_ARGUMENT
@@ -1,5 +1,7 @@
+import asyncio
 import uuid
 
+import grpc
 import pytest
 import handlers.cruds_pb2 as service
 # import handlers.cruds_pb2_grpc as create_pack_grpc
@@ -43,6 +45,42 @@ async def test_get_all_packs_grpc(grpc_handlers, created_pack_id, sample_pack_ti
     assert created_pack_id in ids
 
 
+async def test_update_pack_title_grpc(grpc_handlers, created_pack_id):
+    request = service.UpdatePackTitleRequest(id=created_pack_id, title="Renamed") # type: ignore
+    response = await grpc_handlers.UpdatePackTitle(request)
+
+    assert response.pack.id == created_pack_id
+    assert response.pack.title == "Renamed"
+
+
+async def test_delete_pack_grpc(grpc_handlers, created_pack_id):
+    request = service.DeletePackRequest(id=created_pack_id) # type: ignore
+    await grpc_handlers.DeletePack(request)
+
+    with pytest.raises(Exception) as exc_info:
+        await grpc_handlers.GetPackById(service.GetPackByIdRequest(id=created_pack_id)) # type: ignore
+
+    assert "NOT_FOUND" in str(exc_info.value)
+
+
+async def test_publish_pack_grpc(grpc_handlers, created_pack_id, created_question_id, sample_pack_title):
+    request = service.PublishPackRequest(id=created_pack_id) # type: ignore
+    published = await grpc_handlers.PublishPack(request)
+
+    assert published.pack_version.pack_id == created_pack_id
+    assert published.pack_version.version == 1
+    assert published.pack_version.title == sample_pack_title
+    assert [q.id for q in published.pack_version.questions] == [created_question_id]
+
+    request = service.GetPackVersionRequest(pack_id=created_pack_id, version=1) # type: ignore
+    response = await grpc_handlers.GetPackVersion(request)
+    assert response.pack_version == published.pack_version
+
+    request = service.GetPackVersionRequest(pack_id=created_pack_id) # type: ignore
+    response = await grpc_handlers.GetPackVersion(request)
+    assert response.pack_version == published.pack_version
+
+
 # === Тесты для Question ===
 
 async def test_create_question_grpc(
@@ -89,6 +127,34 @@ async def test_get_questions_by_pack_id_grpc(
     assert len(response.questions) == 1
 
 
+async def test_create_question_with_variants_grpc(
+    grpc_handlers,
+    created_pack_id,
+    sample_question_text,
+    sample_variant_data
+):
+    request = service.CreateQuestionWithVariantsRequest(
+        pack_id=created_pack_id, # type: ignore
+        text=sample_question_text, # type: ignore
+        variants=[ # type: ignore
+            service.CreateQuestionWithVariantsRequest.VariantDraft(
+                text=text, is_correct=is_correct # type: ignore
+            )
+            for text, is_correct in sample_variant_data
+        ]
+    )
+    response = await grpc_handlers.CreateQuestionWithVariants(request)
+
+    assert response.question.text == sample_question_text
+    assert response.question.pack_id == created_pack_id
+    assert uuid.UUID(response.question.id)
+
+    assert [(v.text, v.is_correct) for v in response.variants] == sample_variant_data
+    for variant in response.variants:
+        assert variant.question_id == response.question.id
+        assert uuid.UUID(variant.id)
+
+
 # === Тесты для Variant ===
 
 async def test_create_variant_grpc(
@@ -148,3 +214,74 @@ async def test_get_variants_by_question_id_grpc(
             correct_found = True
             assert variant.text == "Paris"
     assert correct_found
+
+
+async def test_submit_answer_by_pack_ref_grpc(
+    grpc_handlers,
+    created_pack_id,
+    created_question_id,
+    created_variants_ids,
+    sample_variant_data
+):
+    await grpc_handlers.PublishPack(service.PublishPackRequest(id=created_pack_id)) # type: ignore
+
+    for variant_id, (_, is_correct) in zip(created_variants_ids, sample_variant_data):
+        request = service.SubmitAnswerRequest( # type: ignore
+            player_id="alice", variant_id=variant_id, pack_ref=f"{created_pack_id}@1"
+        )
+        response = await grpc_handlers.SubmitAnswer(request)
+        assert response.is_correct == is_correct
+
+    request = service.SubmitAnswerRequest( # type: ignore
+        player_id="alice", variant_id=created_variants_ids[0], pack_ref="not-a-uuid"
+    )
+    with pytest.raises(Exception) as exc_info:
+        await grpc_handlers.SubmitAnswer(request)
+    assert "INVALID_ARGUMENT" in str(exc_info.value)
+
+
+async def test_answer_stats_grpc(
+    grpc_handlers,
+    created_pack_id,
+    created_question_id,
+    created_variants_ids,
+    sample_variant_data
+):
+    players = ["alice", "bob", "alice"]
+    for player, variant_id, (_, is_correct) in zip(players, created_variants_ids, sample_variant_data):
+        request = service.SubmitAnswerRequest(player_id=player, variant_id=variant_id) # type: ignore
+        response = await grpc_handlers.SubmitAnswer(request)
+        assert response.is_correct == is_correct
+
+    # Ответы сохраняются раз в answer-stats-flush-interval
+    request = service.GetQuestionStatsRequest(question_id=created_question_id) # type: ignore
+    for _ in range(50):
+        stats = await grpc_handlers.GetQuestionStats(request)
+        if stats.attempts == 3:
+            break
+        await asyncio.sleep(0.1)
+
+    assert stats.attempts == 3
+    assert stats.unique_players == 2
+    assert len(stats.variants) == len(created_variants_ids)
+
+    request = service.GetPackStatsRequest(pack_id=created_pack_id) # type: ignore
+    stats = await grpc_handlers.GetPackStats(request)
+    assert stats.answers == 3
+    assert stats.unique_players == 2
+
+
+async def test_rate_limit_grpc(grpc_handlers, created_variants_ids):
+    request = service.SubmitAnswerRequest(player_id="flooder", variant_id=created_variants_ids[0]) # type: ignore
+    metadata = (("x-player-id", "flooder"),)
+
+    async def submit():
+        try:
+            await grpc_handlers.SubmitAnswer(request, metadata=metadata)
+            return grpc.StatusCode.OK
+        except grpc.RpcError as e:
+            return e.code()
+
+    codes = await asyncio.gather(*[submit() for _ in range(100)])
+    assert grpc.StatusCode.RESOURCE_EXHAUSTED in codes
+    assert codes.count(grpc.StatusCode.OK) >= 40
@@ -0,0 +1,37 @@
+import gzip
+
+
+async def test_task_processors(monitor_client):
+    response = await monitor_client.get(
+        '/admin/task-processors', params={'interval_ms': '50'}
+    )
+    assert response.status == 200
+
+    stats = response.json()
+    assert 'main-task-processor' in stats
+    assert stats['main-task-processor']['metrics']
+
+
+async def test_task_processors_bad_interval(monitor_client):
+    response = await monitor_client.get(
+        '/admin/task-processors', params={'interval_ms': 'soon'}
+    )
+    assert response.status == 400
+
+
+async def test_cpu_profile(monitor_client):
+    response = await monitor_client.get(
+        '/admin/cpu-profile', params={'seconds': '1', 'frequency': '200'}
+    )
+    assert response.status == 200
+
+    # A gzipped profile.proto message; the string table always has "samples"
+    profile = gzip.decompress(response.content)
+    assert b'samples' in profile
+
+
+async def test_cpu_profile_bad_args(monitor_client):
+    response = await monitor_client.get(
+        '/admin/cpu-profile', params={'seconds': '3600'}
+    )
+    assert response.status == 400
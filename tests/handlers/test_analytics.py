@@ -0,0 +1,130 @@
+import asyncio
+
+import pytest
+from helpers.endpoints import (
+    create_pack,
+    create_question_with_variants,
+    publish_pack,
+
+    submit_answer,
+    get_question_stats,
+    get_pack_stats,
+)
+from helpers.utils import Routes
+
+
+# Answers are flushed every answer-stats-flush-interval (100ms in tests)
+async def wait_for_stats(get_stats, expected_answers: int, key: str):
+    for _ in range(50):
+        stats = await get_stats()
+        if stats[key] >= expected_answers:
+            return stats
+        await asyncio.sleep(0.1)
+    raise AssertionError('Answer stats were not flushed')
+
+
+@pytest.fixture
+async def sample_question(service_client):
+    pack = await create_pack(service_client, 'Pack')
+    return await create_question_with_variants(
+        service_client,
+        pack["id"],
+        "Question",
+        [
+            {"text": "right", "is_correct": True},
+            {"text": "wrong", "is_correct": False},
+        ]
+    )
+
+
+async def test_submit_answer_returns_correctness(service_client, sample_question):
+    right, wrong = sample_question["variants"]
+
+    assert await submit_answer(service_client, "alice", right["id"]) is True
+    assert await submit_answer(service_client, "alice", wrong["id"]) is False
+
+
+async def test_submit_answer_validation(service_client):
+    response = await service_client.post(
+        Routes.SUBMIT_ANSWER,
+        params={'player_id': 'alice', 'variant_id': 'not-a-uuid'}
+    )
+    assert response.status == 400
+
+    response = await service_client.post(
+        Routes.SUBMIT_ANSWER,
+        params={'player_id': 'alice', 'variant_id': '00000000-0000-0000-0000-000000000001'}
+    )
+    assert response.status == 404
+
+
+async def test_submit_answer_by_published_version(service_client, sample_question):
+    right, wrong = sample_question["variants"]
+    published = await publish_pack(service_client, sample_question["question"]["pack_id"])
+    ref = f'{published["pack_id"]}@{published["version"]}'
+
+    assert await submit_answer(service_client, "alice", right["id"], ref) is True
+    assert await submit_answer(service_client, "alice", wrong["id"], ref) is False
+    assert await submit_answer(service_client, "alice", right["id"], published["pack_id"]) is True
+
+    # Variants outside the version are not found
+    response = await service_client.post(
+        Routes.SUBMIT_ANSWER,
+        params={'player_id': 'alice', 'variant_id': '00000000-0000-0000-0000-000000000001', 'ref': ref}
+    )
+    assert response.status == 404
+
+    response = await service_client.post(
+        Routes.SUBMIT_ANSWER,
+        params={'player_id': 'alice', 'variant_id': right["id"], 'ref': 'not-a-uuid'}
+    )
+    assert response.status == 400
+
+
+async def test_question_stats(service_client, sample_question):
+    question_id = sample_question["question"]["id"]
+    right, wrong = sample_question["variants"]
+
+    await submit_answer(service_client, "alice", right["id"])
+    await submit_answer(service_client, "bob", wrong["id"])
+    await submit_answer(service_client, "carol", right["id"])
+    await submit_answer(service_client, "alice", right["id"])
+
+    stats = await wait_for_stats(
+        lambda: get_question_stats(service_client, question_id), 4, "attempts"
+    )
+    assert stats["question_id"] == question_id
+    assert stats["attempts"] == 4
+    assert stats["correct"] == 3
+    assert stats["unique_players"] == 3
+
+    picks = {variant["variant_id"]: variant for variant in stats["variants"]}
+    assert picks[right["id"]]["picks"] == 3
+    assert picks[right["id"]]["pick_rate"] == pytest.approx(0.75)
+    assert picks[wrong["id"]]["picks"] == 1
+
+
+async def test_pack_stats(service_client, sample_question):
+    pack_id = sample_question["question"]["pack_id"]
+    right, _ = sample_question["variants"]
+
+    for player in ["alice", "bob", "alice"]:
+        await submit_answer(service_client, player, right["id"])
+
+    stats = await wait_for_stats(
+        lambda: get_pack_stats(service_client, pack_id), 3, "answers"
+    )
+    assert stats == {"pack_id": pack_id, "answers": 3, "unique_players": 2}
+
+
+async def test_stats_without_answers(service_client, sample_question):
+    stats = await get_question_stats(service_client, sample_question["question"]["id"])
+    assert stats["attempts"] == 0
+    assert stats["unique_players"] == 0
+    assert all(variant["pick_rate"] == 0 for variant in stats["variants"])
+
+    response = await service_client.get(
+        Routes.GET_PACK_STATS,
+        params={'pack_id': '00000000-0000-0000-0000-000000000001'}
+    )
+    assert response.status == 404
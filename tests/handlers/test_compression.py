@@ -0,0 +1,45 @@
+import pytest
+from helpers.endpoints import create_pack
+from helpers.utils import Routes
+
+
+@pytest.fixture
+async def many_packs(service_client):
+    # Enough to get over the 1024 bytes min-size
+    for i in range(30):
+        await create_pack(service_client, f'Pack number {i}')
+
+
+async def test_gzip_response(service_client, many_packs):
+    plain = await service_client.get(
+        Routes.GET_ALL_PACKS, headers={'Accept-Encoding': 'identity'}
+    )
+    assert plain.status == 200
+    assert 'Content-Encoding' not in plain.headers
+    assert plain.headers['Vary'] == 'Accept-Encoding'
+
+    # The client decodes gzip transparently
+    compressed = await service_client.get(
+        Routes.GET_ALL_PACKS, headers={'Accept-Encoding': 'gzip'}
+    )
+    assert compressed.status == 200
+    assert compressed.headers['Content-Encoding'] == 'gzip'
+    assert compressed.json() == plain.json()
+
+
+async def test_zstd_is_preferred(service_client, many_packs):
+    response = await service_client.get(
+        Routes.GET_ALL_PACKS, headers={'Accept-Encoding': 'gzip, zstd'}
+    )
+    assert response.status == 200
+    assert response.headers['Content-Encoding'] == 'zstd'
+
+
+async def test_small_responses_are_not_compressed(service_client):
+    pack = await create_pack(service_client, 'Pack')
+    response = await service_client.get(
+        Routes.GET_PACK, params={'uuid': pack['id']},
+        headers={'Accept-Encoding': 'gzip'}
+    )
+    assert response.status == 200
+    assert 'Content-Encoding' not in response.headers
@@ -0,0 +1,38 @@
+from helpers.endpoints import create_pack
+from helpers.utils import Routes
+
+
+async def test_exhausted_deadline_is_rejected(service_client):
+    response = await service_client.get(
+        Routes.GET_ALL_PACKS,
+        headers={'X-Deadline': '0'}
+    )
+    assert response.status == 504
+
+
+async def test_request_within_deadline(service_client):
+    response = await service_client.get(
+        Routes.GET_ALL_PACKS,
+        headers={'X-Deadline': '5000'}
+    )
+    assert response.status == 200
+    assert response.json() == []
+
+
+async def test_cancelled_query_is_rejected(service_client, pgsql):
+    pack = await create_pack(service_client, 'Locked')
+
+    # The update waits for the lock until the statement timeout, which the
+    # deadline shrinks to what is left of its 200ms
+    cursor = pgsql['db_1'].cursor()
+    cursor.execute('BEGIN')
+    cursor.execute('LOCK TABLE quiz.packs IN ACCESS EXCLUSIVE MODE')
+    try:
+        response = await service_client.post(
+            Routes.UPDATE_PACK_TITLE,
+            params={'uuid': pack['id'], 'title': 'Unlocked'},
+            headers={'X-Deadline': '200'}
+        )
+    finally:
+        cursor.execute('ROLLBACK')
+    assert response.status == 504
@@ -0,0 +1,115 @@
+import asyncio
+import uuid
+
+import pytest
+from helpers.endpoints import (
+    create_pack,
+    create_question_with_variants,
+    get_live_session,
+    next_live_question,
+    publish_pack,
+    start_live_session,
+)
+from helpers.utils import Routes
+
+
+@pytest.fixture
+async def published_pack(service_client):
+    pack = await create_pack(service_client, 'Live')
+    for i in range(2):
+        await create_question_with_variants(
+            service_client,
+            pack["id"],
+            f"Question {i}",
+            [
+                {"text": "right", "is_correct": True},
+                {"text": "wrong", "is_correct": False},
+            ]
+        )
+    return await publish_pack(service_client, pack["id"])
+
+
+async def test_start_session(service_client, published_pack):
+    session = await start_live_session(
+        service_client, published_pack["pack_id"], round_seconds=30
+    )
+    assert session["pack_id"] == published_pack["pack_id"]
+    assert session["version"] == published_pack["version"]
+    assert session["question_count"] == 2
+    assert session["question_index"] == 0
+    assert not session["finished"]
+    assert 0 < session["round_left_ms"] <= 30000
+
+    # Correctness is not revealed while the round is on
+    variants = session["question"]["variants"]
+    assert len(variants) == 2
+    assert all(set(v) == {"id", "text"} for v in variants)
+
+    assert await get_live_session(service_client, session["id"]) == {
+        **session, "round_left_ms": pytest.approx(
+            session["round_left_ms"], abs=1000
+        )
+    }
+
+
+async def test_host_skips_questions(service_client, published_pack):
+    session = await start_live_session(
+        service_client, published_pack["pack_id"], round_seconds=30
+    )
+
+    session = await next_live_question(service_client, session["id"])
+    assert session["question_index"] == 1
+
+    session = await next_live_question(service_client, session["id"])
+    assert session["finished"]
+    assert "question" not in session
+
+    # Skipping a finished session changes nothing
+    assert await next_live_question(service_client, session["id"]) == session
+
+
+async def test_rounds_time_out(service_client, published_pack):
+    session = await start_live_session(
+        service_client, published_pack["pack_id"], round_seconds=1
+    )
+
+    for _ in range(50):
+        session = await get_live_session(service_client, session["id"])
+        if session["finished"]:
+            break
+        await asyncio.sleep(0.1)
+    assert session["finished"]
+
+
+async def test_start_session_errors(service_client):
+    response = await service_client.post(
+        Routes.LIVE_START_SESSION, params={'ref': 'not-a-ref'}
+    )
+    assert response.status == 400
+
+    response = await service_client.post(
+        Routes.LIVE_START_SESSION,
+        params={'ref': str(uuid.uuid4()), 'round_seconds': '0'}
+    )
+    assert response.status == 400
+
+    response = await service_client.post(
+        Routes.LIVE_START_SESSION, params={'ref': str(uuid.uuid4())}
+    )
+    assert response.status == 404
+
+    response = await service_client.get(
+        Routes.LIVE_GET_SESSION, params={'id': str(uuid.uuid4())}
+    )
+    assert response.status == 404
+
+
+async def test_timer_metrics(service_client, monitor_client, published_pack):
+    await start_live_session(service_client, published_pack["pack_id"])
+
+    metric = await monitor_client.single_metric('live-sessions.sessions')
+    assert metric.value >= 1
+    metric = await monitor_client.single_metric(
+        'live-sessions.timer-lag-ms.max'
+    )
+    assert metric.value >= 0
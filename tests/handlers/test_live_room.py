@@ -0,0 +1,99 @@
+import asyncio
+import json
+import uuid
+
+import pytest
+from helpers.endpoints import (
+    create_pack,
+    create_question_with_variants,
+    next_live_question,
+    publish_pack,
+    start_live_session,
+)
+from helpers.utils import Routes
+
+
+@pytest.fixture
+async def live_session(service_client):
+    pack = await create_pack(service_client, 'Room')
+    for i in range(2):
+        await create_question_with_variants(
+            service_client,
+            pack["id"],
+            f"Question {i}",
+            [
+                {"text": "right", "is_correct": True},
+                {"text": "wrong", "is_correct": False},
+            ]
+        )
+    published = await publish_pack(service_client, pack["id"])
+    return await start_live_session(
+        service_client, published["pack_id"], round_seconds=60
+    )
+
+
+def room_url(session_id):
+    return f'{Routes.LIVE_ROOM}?id={session_id}'
+
+
+async def receive(room):
+    return json.loads(await room.recv())
+
+
+async def test_room_broadcasts_rounds(
+    service_client, websocket_client, live_session
+):
+    session_id = live_session["id"]
+    async with websocket_client.get(room_url(session_id)) as first:
+        async with websocket_client.get(room_url(session_id)) as player:
+            for room in (first, player):
+                message = await receive(room)
+                assert message["type"] == "question"
+                assert message["session"]["question_index"] == 0
+
+            variants = message["session"]["question"]["variants"]
+            await player.send(json.dumps(
+                {"type": "answer", "variant_id": variants[1]["id"]}
+            ))
+            # Only the first answer of a player counts
+            await player.send(json.dumps(
+                {"type": "answer", "variant_id": variants[0]["id"]}
+            ))
+            # Claiming to be the host does not let a player skip
+            await player.send(json.dumps({"type": "next"}))
+            await asyncio.sleep(0.2)
+            await next_live_question(service_client, session_id)
+
+            for room in (first, player):
+                results = await receive(room)
+                assert results["type"] == "results"
+                assert results["question_index"] == 0
+                answers = {v["id"]: v["answers"] for v in results["variants"]}
+                assert answers == {variants[0]["id"]: 0, variants[1]["id"]: 1}
+                assert sum(v["correct"] for v in results["variants"]) == 1
+
+                message = await receive(room)
+                assert message["type"] == "question"
+                assert message["session"]["question_index"] == 1
+
+
+async def test_room_sees_skips_over_http(
+    service_client, websocket_client, live_session
+):
+    session_id = live_session["id"]
+    async with websocket_client.get(room_url(session_id)) as player:
+        assert (await receive(player))["type"] == "question"
+
+        await next_live_question(service_client, session_id)
+        assert (await receive(player))["type"] == "results"
+        assert (await receive(player))["session"]["question_index"] == 1
+
+        await next_live_question(service_client, session_id)
+        assert (await receive(player))["type"] == "results"
+        assert (await receive(player))["session"]["finished"]
+
+
+async def test_room_of_unknown_session(websocket_client):
+    with pytest.raises(Exception):
+        async with websocket_client.get(room_url(uuid.uuid4())):
+            pass
@@ -1,9 +1,21 @@
 import pytest
+import uuid
+
 from helpers.endpoints import (
     create_pack,
+    create_question,
+    create_question_with_variants,
+    delete_pack,
+    export_catalog,
     get_all_packs,
-    get_pack
+    get_pack,
+    get_pack_content,
+    get_pack_version,
+    get_questions_by_pack_id,
+    publish_pack,
+    update_pack_title
 )
+from helpers.utils import Routes
 
 
 async def test_create_pack(service_client):
@@ -32,3 +44,232 @@ async def test_get_all_packs(service_client):
 
     getted_second_pack = all_packs[1]
     assert getted_second_pack == second_pack
+
+
+async def test_update_pack_title(service_client):
+    created_pack = await create_pack(service_client, "old_title")
+
+    await update_pack_title(service_client, created_pack["id"], "new_title")
+
+    getted_pack = await get_pack(service_client, created_pack["id"])
+    assert getted_pack == {"id": created_pack["id"], "title": "new_title"}
+
+
+async def test_update_pack_title_not_found(service_client):
+    response = await service_client.post(
+        Routes.UPDATE_PACK_TITLE,
+        params={'uuid': str(uuid.uuid4()), 'title': "title"}
+    )
+    assert response.status == 404
+
+
+async def test_delete_pack(service_client):
+    created_pack = await create_pack(service_client, "doomed_pack")
+    await create_question(service_client, created_pack["id"], "doomed question")
+
+    await delete_pack(service_client, created_pack["id"])
+
+    assert await get_all_packs(service_client) == []
+    assert await get_questions_by_pack_id(service_client, created_pack["id"]) == []
+
+
+async def test_delete_pack_keeps_published_versions(service_client):
+    pack = await create_pack(service_client, "retired_pack")
+    await create_question(service_client, pack["id"], "kept question")
+    published = await publish_pack(service_client, pack["id"])
+
+    await delete_pack(service_client, pack["id"])
+
+    assert await get_pack_version(service_client, f'{pack["id"]}@1') == published
+    # Without the pack there is no latest version
+    response = await service_client.get(
+        Routes.GET_PACK_VERSION, params={'ref': pack["id"]}
+    )
+    assert response.status == 404
+
+
+async def test_delete_pack_not_found(service_client):
+    response = await service_client.delete(
+        Routes.DELETE_PACK, params={'uuid': str(uuid.uuid4())}
+    )
+    assert response.status == 404
+
+
+async def test_published_version_is_immutable(service_client):
+    pack = await create_pack(service_client, "draft_title")
+    question = await create_question(service_client, pack["id"], "first question")
+
+    first = await publish_pack(service_client, pack["id"])
+    assert first["version"] == 1
+    assert first["title"] == "draft_title"
+    assert [q["id"] for q in first["questions"]] == [question["id"]]
+    assert first["questions"][0]["variants"] == []
+
+    # Editing the draft does not touch the published snapshot
+    await update_pack_title(service_client, pack["id"], "edited_title")
+    await create_question(service_client, pack["id"], "second question")
+
+    assert await get_pack_version(service_client, f'{pack["id"]}@1') == first
+
+    second = await publish_pack(service_client, pack["id"])
+    assert second["version"] == 2
+    assert second["title"] == "edited_title"
+    assert len(second["questions"]) == 2
+
+    assert await get_pack_version(service_client, pack["id"]) == second
+
+
+async def test_get_pack_version_not_found(service_client):
+    pack = await create_pack(service_client, "never_published")
+
+    response = await service_client.get(
+        Routes.GET_PACK_VERSION, params={'ref': pack["id"]}
+    )
+    assert response.status == 404
+
+    response = await service_client.get(
+        Routes.GET_PACK_VERSION, params={'ref': f'{pack["id"]}@1'}
+    )
+    assert response.status == 404
+
+
+async def test_get_pack_version_bad_ref(service_client):
+    response = await service_client.get(
+        Routes.GET_PACK_VERSION, params={'ref': 'not-a-uuid@1'}
+    )
+    assert response.status == 400
+
+
+async def test_get_all_packs_empty(service_client):
+    assert await get_all_packs(service_client) == []
+
+
+async def test_get_pack_content(service_client):
+    pack = await create_pack(service_client, "content")
+    assert await get_pack_content(service_client, pack["id"]) == {
+        **pack, "questions": []
+    }
+
+    created = await create_question_with_variants(
+        service_client,
+        pack["id"],
+        "Capital of France?",
+        [
+            {"text": "Paris", "is_correct": True},
+            {"text": "Lyon", "is_correct": False},
+        ],
+        "https://cdn.example.com/france.png"
+    )
+
+    content = await get_pack_content(service_client, pack["id"])
+    assert content["id"] == pack["id"]
+    assert content["title"] == pack["title"]
+    assert len(content["questions"]) == 1
+
+    question = content["questions"][0]
+    variants = question.pop("variants")
+    assert question == created["question"]
+    assert sorted(variants, key=lambda v: v["id"]) == sorted(
+        created["variants"], key=lambda v: v["id"]
+    )
+
+
+async def test_get_pack_content_not_found(service_client):
+    response = await service_client.get(
+        Routes.GET_PACK_CONTENT, params={'id': str(uuid.uuid4())}
+    )
+    assert response.status == 404
+
+    response = await service_client.get(
+        Routes.GET_PACK_CONTENT, params={'id': 'not-a-uuid'}
+    )
+    assert response.status == 400
+
+
+async def test_export_catalog(service_client):
+    empty = await create_pack(service_client, "empty")
+    pack = await create_pack(service_client, "with, questions")
+    created = await create_question_with_variants(
+        service_client,
+        pack["id"],
+        "Capital of\nFrance?",
+        [
+            {"text": "Paris", "is_correct": True},
+            {"text": "Lyon", "is_correct": False},
+        ]
+    )
+    question = created["question"]
+
+    records = await export_catalog(service_client)
+    packs = {r["id"]: r for r in records if r["type"] == "pack"}
+    assert set(packs) == {empty["id"], pack["id"]}
+    assert packs[pack["id"]]["title"] == "with, questions"
+    assert packs[pack["id"]]["version"] == 0
+
+    assert [r for r in records if r["type"] == "question"] == [{
+        "type": "question",
+        "id": question["id"],
+        "pack_id": pack["id"],
+        "text": "Capital of\nFrance?",
+        "image_url": "",
+    }]
+    variants = [r for r in records if r["type"] == "variant"]
+    assert sorted(variants, key=lambda v: v["id"]) == sorted(
+        (
+            {"type": "variant", "question_id": question["id"], **variant}
+            for variant in created["variants"]
+        ),
+        key=lambda v: v["id"]
+    )
+
+
+async def test_export_catalog_filters(service_client):
+    pack = await create_pack(service_client, "first")
+    await create_pack(service_client, "second")
+
+    records = await export_catalog(service_client, pack_id=pack["id"])
+    assert [r["id"] for r in records] == [pack["id"]]
+
+    updated_at = records[0]["updated_at"]
+    records = await export_catalog(service_client, modified_since=updated_at)
+    assert pack["id"] in {r["id"] for r in records}
+
+    await create_question(service_client, pack["id"], "Touches the pack")
+    records = await export_catalog(
+        service_client, pack_id=pack["id"], modified_since=updated_at
+    )
+    assert records[0]["updated_at"] > updated_at
+
+    assert await export_catalog(
+        service_client, modified_since="2999-01-01T00:00:00Z"
+    ) == []
+    assert await export_catalog(
+        service_client, pack_id=str(uuid.uuid4())
+    ) == []
+
+
+async def test_export_catalog_csv(service_client):
+    pack = await create_pack(service_client, 'Say "hi"')
+
+    response = await service_client.get(
+        Routes.EXPORT_CATALOG, params={'format': 'csv'}
+    )
+    assert response.status == 200
+    assert response.headers['Content-Type'].startswith('text/csv')
+
+    lines = response.text.split('\r\n')
+    assert lines[0] == (
+        'type,id,parent_id,text,image_url,is_correct,version,updated_at'
+    )
+    assert lines[1].startswith(f'pack,{pack["id"]},,"Say ""hi""",,,0,')
+    assert lines[2:] == ['']
+
+
+@pytest.mark.parametrize('params', [
+    {'format': 'xml'},
+    {'pack_id': 'not-a-uuid'},
+    {'modified_since': 'yesterday'},
+])
+async def test_export_catalog_bad_request(service_client, params):
+    response = await service_client.get(Routes.EXPORT_CATALOG, params=params)
+    assert response.status == 400
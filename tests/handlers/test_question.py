@@ -1,8 +1,11 @@
 import pytest
+from helpers.utils import Routes
 from helpers.endpoints import (
     create_pack,
 
     create_question,
+    create_question_with_variants,
+    get_variants_by_question_id,
     get_question_by_id,
     get_questions_by_pack_id
 )
@@ -43,3 +46,28 @@ async def test_get_questions_by_pack_id(service_client, sample_packs):
     assert questions_from_second_pack == [second_question]
 
     assert len(questions_from_non_existing_pack) == 0
+
+
+async def test_create_question_with_variants(service_client, sample_packs):
+    variants = [
+        {"text": "London", "is_correct": False},
+        {"text": "Paris", "is_correct": True},
+    ]
+    created = await create_question_with_variants(
+        service_client, sample_packs[0]["id"], "Capital of France?", variants
+    )
+
+    getted_question = await get_question_by_id(service_client, created["question"]["id"])
+    assert getted_question == created["question"]
+
+    getted_variants = await get_variants_by_question_id(service_client, created["question"]["id"])
+    assert sorted(getted_variants, key=lambda v: v["text"]) == \
+        sorted(created["variants"], key=lambda v: v["text"])
+
+
+async def test_create_question_with_variants_bad_body(service_client):
+    response = await service_client.post(
+        Routes.CREATE_QUESTION_WITH_VARIANTS,
+        data='not a json'
+    )
+    assert response.status == 400
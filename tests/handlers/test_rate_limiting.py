@@ -0,0 +1,59 @@
+import asyncio
+
+import pytest
+from helpers.endpoints import (
+    create_pack,
+    create_question_with_variants,
+)
+from helpers.utils import Routes
+
+
+@pytest.fixture
+async def variant_id(service_client):
+    pack = await create_pack(service_client, 'Pack')
+    created = await create_question_with_variants(
+        service_client,
+        pack["id"],
+        "Question",
+        [{"text": "right", "is_correct": True}]
+    )
+    return created["variants"][0]["id"]
+
+
+async def submit(service_client, player: str, variant_id: str) -> int:
+    response = await service_client.post(
+        Routes.SUBMIT_ANSWER,
+        params={'player_id': player, 'variant_id': variant_id},
+        headers={'X-Player-Id': player}
+    )
+    return response.status
+
+
+# handler-submit-answer allows bursts of 40 and 20 answers per second per
+# player, four times that per address, see QUIZ_RATE_LIMITS in
+# configs/static_config.yaml
+async def test_flooding_player_is_limited(service_client, variant_id):
+    statuses = await asyncio.gather(
+        *[submit(service_client, "flooder", variant_id) for _ in range(100)]
+    )
+
+    assert set(statuses) == {200, 429}
+    assert statuses.count(200) >= 40
+
+    # Other players are not affected
+    assert await submit(service_client, "bystander", variant_id) == 200
+
+
+async def test_rotating_player_ids_are_limited(service_client, variant_id):
+    statuses = await asyncio.gather(
+        *[
+            submit(service_client, f"flooder-{i}", variant_id)
+            for i in range(400)
+        ]
+    )
+
+    # Every id is new, but they all come from one address
+    assert set(statuses) == {200, 429}
+
+    # Let the address bucket refill for the tests that follow
+    await asyncio.sleep(2)
@@ -1,6 +1,8 @@
+import json
+
 from helpers.utils import Routes
 from helpers.validators import validate_uuid
-from typing import Dict, Any, List
+from typing import Dict, Any, List, Optional
 
 
 async def create_pack(service_client, title: str) -> Dict[str, Any]:
@@ -36,6 +38,57 @@ async def get_all_packs(service_client) -> List[Dict[str, Any]]:
     return response_json
 
 
+async def update_pack_title(service_client, uuid: str, title: str) -> Dict[str, Any]:
+    response = await service_client.post(
+        Routes.UPDATE_PACK_TITLE,
+        params={'uuid': uuid, 'title': title}
+    )
+    assert response.status == 200
+    response_json = response.json()
+
+    assert response_json == {"id": uuid, "title": title}
+
+    return response_json
+
+
+async def delete_pack(service_client, uuid: str) -> None:
+    response = await service_client.delete(Routes.DELETE_PACK, params={'uuid': uuid})
+    assert response.status == 200
+
+
+async def publish_pack(service_client, uuid: str) -> Dict[str, Any]:
+    response = await service_client.post(Routes.PUBLISH_PACK, params={'uuid': uuid})
+    assert response.status == 200
+    response_json = response.json()
+
+    assert response_json["pack_id"] == uuid
+    assert response_json["version"] >= 1
+
+    return response_json
+
+
+async def get_pack_version(service_client, ref: str) -> Dict[str, Any]:
+    response = await service_client.get(Routes.GET_PACK_VERSION, params={'ref': ref})
+    assert response.status == 200
+
+    return response.json()
+
+
+async def get_pack_content(service_client, uuid: str) -> Dict[str, Any]:
+    response = await service_client.get(Routes.GET_PACK_CONTENT, params={'id': uuid})
+    assert response.status == 200
+
+    return response.json()
+
+
+async def export_catalog(service_client, **params) -> List[Dict[str, Any]]:
+    response = await service_client.get(Routes.EXPORT_CATALOG, params=params)
+    assert response.status == 200
+    assert response.headers['Content-Type'] == 'application/x-ndjson'
+
+    return [json.loads(line) for line in response.text.splitlines()]
+
+
 # ------------------------------------------------------------------------------
 
 
@@ -64,6 +117,47 @@ async def create_question(service_client, pack_id: str, text: str, image_url: st
     return response_json
 
 
+async def create_question_with_variants(
+    service_client,
+    pack_id: str,
+    text: str,
+    variants: List[Dict[str, Any]],
+    image_url: str = ""
+) -> Dict[str, Any]:
+    responce = await service_client.post(
+        Routes.CREATE_QUESTION_WITH_VARIANTS,
+        json={
+            'pack_id': pack_id,
+            'text': text,
+            'image_url': image_url,
+            'variants': variants
+        }
+    )
+    assert responce.status == 200
+
+    response_json = responce.json()
+
+    question = response_json["question"]
+    assert "id" in question
+    assert question == {
+        "id": question["id"],
+        "pack_id": pack_id,
+        "text": text,
+        "image_url": image_url
+    }
+
+    assert len(response_json["variants"]) == len(variants)
+    for created, expected in zip(response_json["variants"], variants):
+        assert created == {
+            "id": created["id"],
+            "question_id": question["id"],
+            "text": expected["text"],
+            "is_correct": expected["is_correct"]
+        }
+
+    return response_json
+
+
 async def get_question_by_id(service_client, id: str) -> Dict[str, Any]:
     responce = await service_client.get(Routes.GET_QUESTION_BY_ID, params={'id': id})
     assert responce.status == 200
@@ -118,3 +212,57 @@ async def get_variants_by_question_id(service_client, question_id: str) -> Dict[
     assert responce.status == 200
 
     return responce.json()
+
+
+# ------------------------------------------------------------------------------
+
+
+async def submit_answer(service_client, player_id: str, variant_id: str, ref: Optional[str] = None) -> bool:
+    params = {'player_id': player_id, 'variant_id': variant_id}
+    if ref is not None:
+        params['ref'] = ref
+    response = await service_client.post(Routes.SUBMIT_ANSWER, params=params)
+    assert response.status == 200
+
+    return response.json()["is_correct"]
+
+
+async def get_question_stats(service_client, question_id: str) -> Dict[str, Any]:
+    response = await service_client.get(Routes.GET_QUESTION_STATS, params={'question_id': question_id})
+    assert response.status == 200
+
+    return response.json()
+
+
+async def get_pack_stats(service_client, pack_id: str) -> Dict[str, Any]:
+    response = await service_client.get(Routes.GET_PACK_STATS, params={'pack_id': pack_id})
+    assert response.status == 200
+
+    return response.json()
+
+
+# ------------------------------------------------------------------------------
+
+
+async def start_live_session(service_client, ref: str, round_seconds: Optional[int] = None) -> Dict[str, Any]:
+    params = {'ref': ref}
+    if round_seconds is not None:
+        params['round_seconds'] = str(round_seconds)
+    response = await service_client.post(Routes.LIVE_START_SESSION, params=params)
+    assert response.status == 200
+
+    return response.json()
+
+
+async def get_live_session(service_client, session_id: str) -> Dict[str, Any]:
+    response = await service_client.get(Routes.LIVE_GET_SESSION, params={'id': session_id})
+    assert response.status == 200
+
+    return response.json()
+
+
+async def next_live_question(service_client, session_id: str) -> Dict[str, Any]:
+    response = await service_client.post(Routes.LIVE_NEXT_QUESTION, params={'id': session_id})
+    assert response.status == 200
+
+    return response.json()
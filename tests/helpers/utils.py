@@ -4,8 +4,15 @@ class Routes(str, Enum):
     CREATE_PACK                     = "/create-pack"
     GET_PACK                        = "/get-pack"
     GET_ALL_PACKS                   = "/get-all-packs"
+    GET_PACK_CONTENT                = "/get-pack-content"
+    UPDATE_PACK_TITLE               = "/update-pack-title"
+    DELETE_PACK                     = "/delete-pack"
+    PUBLISH_PACK                    = "/publish-pack"
+    GET_PACK_VERSION                = "/get-pack-version"
+    EXPORT_CATALOG                  = "/export-catalog"
 
     CREATE_QUESTION                 = "/create-question"
+    CREATE_QUESTION_WITH_VARIANTS   = "/create-question-with-variants"
     GET_QUESTION_BY_ID              = "/get-question-by-id"
     GET_QUESTIONS_BY_PACK_ID        = "/get-questions-by-pack-id"
 
@@ -13,6 +20,15 @@ class Routes(str, Enum):
     GET_VARIANT_BY_ID               = "/get-variant-by-id"
     GET_VARIANTS_BY_QUESTION_ID     = "/get-variants-by-question-id"
 
+    SUBMIT_ANSWER                   = "/submit-answer"
+    GET_QUESTION_STATS              = "/question-stats"
+    GET_PACK_STATS                  = "/pack-stats"
+
+    LIVE_START_SESSION              = "/live/start-session"
+    LIVE_GET_SESSION                = "/live/get-session"
+    LIVE_NEXT_QUESTION              = "/live/next-question"
+    LIVE_ROOM                       = "live/room"
+
 
     def __str__(self) -> str:
         return self.value
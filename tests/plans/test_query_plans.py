@@ -0,0 +1,163 @@
+import dataclasses
+import json
+import pathlib
+
+import pytest
+
+# Ids from postgresql/data/query_plans_data.sql
+PACK = "md5('pack-42')::uuid"
+QUESTION = "md5('question-42-7')::uuid"
+VARIANT = "md5('variant-42-7-3')::uuid"
+NEW_VARIANTS = (
+    "ARRAY["
+    "ROW(md5('new-variant-1')::uuid, NULL, 'Yes', true), "
+    "ROW(md5('new-variant-2')::uuid, NULL, 'No', false)"
+    "]::quiz.variant[]",
+)
+
+SORT_NODES = {'Sort', 'Incremental Sort'}
+
+
+@dataclasses.dataclass(frozen=True)
+class Case:
+    params: tuple = ()
+    # Shared buffers (hit + read) the whole statement may touch
+    budget: int = 16
+    # Sorting one pack worth of rows is fine, sorting a table is not
+    allow_sort: bool = False
+
+
+# Every file in src/queries must be listed here. Budgets are the buffers
+# observed on PostgreSQL 16 with query_plans_data.sql, rounded up with some
+# headroom
+CASES = {
+    'check_variant_correctness_by_id': Case((VARIANT,)),
+    # The first insert into a fresh table extends it, later ones take ~14
+    'create_pack': Case(("md5('new-pack')::uuid", "'New pack'"), budget=32),
+    'create_question': Case(
+        ("md5('new-question')::uuid", PACK, "'New question'", 'NULL')
+    ),
+    'create_question_with_variants': Case(
+        ("md5('new-question')::uuid", PACK, "'New question'", 'NULL')
+        + NEW_VARIANTS,
+        budget=32,
+        # Returns the variants in the order of the input array
+        allow_sort=True,
+    ),
+    'create_variant': Case(
+        ("md5('new-variant')::uuid", QUESTION, "'New variant'", 'false')
+    ),
+    'delete_pack': Case((PACK,)),
+    'export_pack': Case((PACK, 'NULL')),
+    'export_pack_rows': Case((PACK,), budget=192, allow_sort=True),
+    # An incremental export reads the tail of idx_packs_updated_at; a full
+    # one walks the whole index by design, through a cursor
+    'export_packs': Case(("'2026-01-02 09:00:00+00'",)),
+    # Both lists are read in full, but only from idx_packs_title
+    'get_all_packs': Case(budget=128),
+    'get_all_packs_json': Case(budget=128),
+    'get_pack_by_id': Case((PACK,)),
+    # The ordered json_agg sorts the questions of the pack
+    'get_pack_content_json': Case((PACK,), budget=192, allow_sort=True),
+    'get_pack_latest_version': Case((PACK,)),
+    'get_pack_stats': Case((PACK,)),
+    'get_pack_stats_players': Case((f'ARRAY[{PACK}]',)),
+    'get_pack_version': Case((PACK, '1')),
+    'get_question_by_id': Case((QUESTION,)),
+    'get_question_stats': Case((QUESTION,)),
+    'get_question_stats_players': Case((f'ARRAY[{QUESTION}]',)),
+    'get_questions_and_variants_by_pack_id': Case((PACK,), budget=192),
+    'get_questions_by_pack_id': Case((PACK,), budget=32),
+    'get_questions_by_pack_id_json': Case((PACK,), budget=32),
+    'get_variant_by_id': Case((VARIANT,)),
+    'get_variant_stats_by_question_id': Case((QUESTION,), budget=32),
+    'get_variants_by_question_id': Case((QUESTION,)),
+    'lock_answer_stats': Case(),
+    'publish_pack': Case((PACK,), budget=256, allow_sort=True),
+    'save_pack_stats': Case(
+        (f'ARRAY[{PACK}]', 'ARRAY[1]::bigint[]', "ARRAY['00']")
+    ),
+    'save_question_stats': Case(
+        (
+            f'ARRAY[{QUESTION}]',
+            'ARRAY[1]::bigint[]',
+            'ARRAY[1]::bigint[]',
+            "ARRAY['00']",
+        )
+    ),
+    'save_variant_stats': Case(
+        (f'ARRAY[{VARIANT}]', 'ARRAY[1]::bigint[]'), budget=32
+    ),
+    # Also maintains idx_packs_title and idx_packs_updated_at
+    'update_pack_title': Case((PACK, "'Renamed pack'"), budget=32),
+}
+
+
+def _queries_dir():
+    return pathlib.Path(__file__).parents[2] / 'src' / 'queries'
+
+
+def _load_query(name):
+    return (_queries_dir() / f'{name}.sql').read_text().strip().rstrip(';')
+
+
+def _walk(node):
+    yield node
+    for child in node.get('Plans', []):
+        yield from _walk(child)
+
+
+def _explain(cursor, name, case):
+    # The service runs prepared statements, which switch to the generic plan
+    cursor.execute('BEGIN')
+    try:
+        cursor.execute('SET LOCAL plan_cache_mode = force_generic_plan')
+        cursor.execute(f'PREPARE plan_check AS {_load_query(name)}')
+        args = f'({", ".join(case.params)})' if case.params else ''
+        cursor.execute(
+            'EXPLAIN (ANALYZE, BUFFERS, FORMAT JSON) '
+            f'EXECUTE plan_check{args}'
+        )
+        plan = cursor.fetchone()[0]
+    finally:
+        cursor.execute('ROLLBACK')
+        cursor.execute('DEALLOCATE ALL')
+    if isinstance(plan, str):
+        plan = json.loads(plan)
+    return plan[0]['Plan']
+
+
+def _check_plan(name, case, plan):
+    problems = []
+    for node in _walk(plan):
+        node_type = node['Node Type']
+        if node_type == 'Seq Scan':
+            problems.append(f'seq scan on {node["Relation Name"]}')
+        if node_type in SORT_NODES and not case.allow_sort:
+            problems.append(f'{node_type.lower()} by {node.get("Sort Key")}')
+
+    buffers = plan.get('Shared Hit Blocks', 0) + plan.get(
+        'Shared Read Blocks', 0
+    )
+    if buffers > case.budget:
+        problems.append(f'{buffers} buffers, budget is {case.budget}')
+    return [f'{name}: {problem}' for problem in problems]
+
+
+def test_every_query_has_a_case():
+    queries = {path.stem for path in _queries_dir().glob('*.sql')}
+    assert queries == set(CASES)
+
+
+@pytest.mark.pgsql('db_1', files=['query_plans_data.sql'])
+def test_query_plans(pgsql):
+    cursor = pgsql['db_1'].cursor()
+    # Fresh statistics, and a visibility map for index-only scans
+    cursor.execute('VACUUM ANALYZE')
+
+    problems = []
+    for name, case in sorted(CASES.items()):
+        plan = _explain(cursor, name, case)
+        problems.extend(_check_plan(name, case, plan))
+
+    assert not problems, '\n'.join(problems)
@@ -0,0 +1,167 @@
+#include "utils/adaptive_limiter.hpp"
+
+#include <optional>
+#include <vector>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using Utils::AdaptiveLimiter;
+using Utils::AdaptiveLimiterSettings;
+using namespace std::chrono_literals;
+
+constexpr AdaptiveLimiterSettings kSettings{
+    .initial_limit = 4,
+    .min_limit = 2,
+    .max_limit = 8,
+    .tolerance = 2.0,
+    .backoff = 0.5,
+};
+
+} // namespace
+
+UTEST(AdaptiveLimiterTest, ShedsAboveLimit) {
+    AdaptiveLimiter limiter{kSettings};
+
+    std::vector<AdaptiveLimiter::Slot> slots;
+    for (int i = 0; i < 4; ++i) {
+        auto slot = limiter.TryAcquire();
+        ASSERT_TRUE(slot.has_value());
+        slots.push_back(std::move(*slot));
+    }
+    EXPECT_EQ(limiter.GetInFlight(), 4);
+    EXPECT_FALSE(limiter.TryAcquire().has_value());
+
+    slots.pop_back();
+    EXPECT_EQ(limiter.GetInFlight(), 3);
+    EXPECT_TRUE(limiter.TryAcquire().has_value());
+}
+
+UTEST(AdaptiveLimiterTest, BacksOffOnSlowResponses) {
+    AdaptiveLimiter limiter{kSettings};
+    const auto now = AdaptiveLimiter::Clock::now();
+
+    limiter.OnSample(10ms, now);
+    EXPECT_EQ(limiter.GetLimit(), 4);
+
+    limiter.OnSample(100ms, now + 1s);
+    EXPECT_EQ(limiter.GetLimit(), 2);
+
+    // Never goes below the minimum
+    limiter.OnSample(100ms, now + 2s);
+    EXPECT_EQ(limiter.GetLimit(), 2);
+}
+
+UTEST(AdaptiveLimiterTest, BacksOffOncePerRoundTrip) {
+    AdaptiveLimiter limiter{
+        AdaptiveLimiterSettings{.initial_limit = 8, .backoff = 0.5}
+    };
+    const auto now = AdaptiveLimiter::Clock::now();
+
+    limiter.OnSample(10ms, now);
+    limiter.OnSample(100ms, now + 1s);
+    EXPECT_EQ(limiter.GetLimit(), 4);
+
+    limiter.OnSample(100ms, now + 1s + 10ms);
+    EXPECT_EQ(limiter.GetLimit(), 4);
+}
+
+UTEST(AdaptiveLimiterTest, GrowsWhileSaturatedAndFast) {
+    AdaptiveLimiter limiter{kSettings};
+    const auto now = AdaptiveLimiter::Clock::now();
+
+    std::vector<AdaptiveLimiter::Slot> slots;
+    for (int i = 0; i < 4; ++i) {
+        slots.push_back(std::move(*limiter.TryAcquire()));
+    }
+    for (int i = 0; i < 100; ++i) {
+        limiter.OnSample(10ms, now);
+    }
+    EXPECT_EQ(limiter.GetLimit(), 8);
+}
+
+UTEST(AdaptiveLimiterTest, DoesNotGrowWhenIdle) {
+    AdaptiveLimiter limiter{kSettings};
+    const auto now = AdaptiveLimiter::Clock::now();
+
+    for (int i = 0; i < 100; ++i) {
+        limiter.OnSample(10ms, now);
+    }
+    EXPECT_EQ(limiter.GetLimit(), 4);
+}
+
+UTEST(AdaptiveLimiterTest, CancelledSlotsAreNoSamples) {
+    AdaptiveLimiter limiter{kSettings};
+    const auto now = AdaptiveLimiter::Clock::now();
+    limiter.OnSample(10ms, now);
+
+    // Fast errors, had they been reported, would set a baseline of
+    // microseconds and make the next regular response look congested
+    for (int i = 0; i < 10; ++i) {
+        auto slot = limiter.TryAcquire();
+        ASSERT_TRUE(slot.has_value());
+        slot->Cancel();
+    }
+    EXPECT_EQ(limiter.GetInFlight(), 0);
+
+    limiter.OnSample(15ms, now + 1s);
+    EXPECT_EQ(limiter.GetLimit(), 4);
+}
+
+UTEST(AdaptiveLimiterTest, RejectionReleasesTheBudget) {
+    AdaptiveLimiter budget{kSettings};
+    AdaptiveLimiter endpoint{kSettings};
+    const auto now = AdaptiveLimiter::Clock::now();
+    budget.OnSample(10ms, now);
+    endpoint.OnSample(10ms, now);
+
+    std::vector<AdaptiveLimiter::Slot> slots;
+    for (int i = 0; i < 4; ++i) {
+        auto slot = endpoint.TryAcquire(&budget);
+        ASSERT_TRUE(slot.has_value());
+        slots.push_back(std::move(*slot));
+    }
+    EXPECT_EQ(budget.GetInFlight(), 4);
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_FALSE(endpoint.TryAcquire(&budget).has_value());
+    }
+    EXPECT_EQ(budget.GetInFlight(), 4);
+
+    for (auto& slot : slots) {
+        slot.Cancel();
+    }
+    EXPECT_EQ(budget.GetInFlight(), 0);
+    EXPECT_EQ(endpoint.GetInFlight(), 0);
+
+    budget.OnSample(15ms, now + 1s);
+    EXPECT_EQ(budget.GetLimit(), 4);
+}
+
+UTEST(AdaptiveLimiterTest, BudgetFollowsEndpointVerdicts) {
+    AdaptiveLimiter budget{kSettings};
+    const auto now = AdaptiveLimiter::Clock::now();
+
+    // A slow endpoint at its usual latency is no congestion for the budget
+    // a fast one shares with it
+    budget.OnVerdict(false, 1ms, now);
+    budget.OnVerdict(false, 100ms, now + 1s);
+    EXPECT_EQ(budget.GetLimit(), 4);
+
+    budget.OnVerdict(true, 100ms, now + 2s);
+    EXPECT_EQ(budget.GetLimit(), 2);
+}
+
+UTEST(AdaptiveLimiterTest, BaselineForgetsOldMinimum) {
+    AdaptiveLimiter limiter{kSettings};
+    const auto now = AdaptiveLimiter::Clock::now();
+
+    // Two windows later the lucky sample no longer counts and the backend,
+    // slower for good, sets the baseline
+    limiter.OnSample(1ms, now);
+    limiter.OnSample(10ms, now + 25s);
+    EXPECT_EQ(limiter.GetLimit(), 4);
+
+    limiter.OnSample(30ms, now + 26s);
+    EXPECT_EQ(limiter.GetLimit(), 2);
+}
@@ -0,0 +1,114 @@
+#include "logic/analytics/answer_aggregator.hpp"
+
+#include <string>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/boost_uuid4.hpp>
+
+namespace {
+
+struct Ids final {
+    boost::uuids::uuid pack_id =
+        userver::utils::generators::GenerateBoostUuid();
+    boost::uuids::uuid question_id =
+        userver::utils::generators::GenerateBoostUuid();
+    boost::uuids::uuid right = userver::utils::generators::GenerateBoostUuid();
+    boost::uuids::uuid wrong = userver::utils::generators::GenerateBoostUuid();
+};
+
+void Answer(
+    game_userver::AnswerAggregator& aggregator, const Ids& ids,
+    std::string_view player, bool is_correct
+) {
+    aggregator.Record(
+        {ids.pack_id, ids.question_id, is_correct ? ids.right : ids.wrong,
+         is_correct, player}
+    );
+}
+
+} // namespace
+
+UTEST(AnswerAggregatorTest, EmptyDeltaWithoutAnswers) {
+    const game_userver::AnswerAggregator aggregator;
+    EXPECT_TRUE(aggregator.CollectDelta().IsEmpty());
+}
+
+UTEST(AnswerAggregatorTest, CountsAnswers) {
+    game_userver::AnswerAggregator aggregator;
+    const Ids ids;
+    Answer(aggregator, ids, "alice", true);
+    Answer(aggregator, ids, "bob", false);
+    Answer(aggregator, ids, "alice", false);
+
+    const auto delta = aggregator.CollectDelta();
+    ASSERT_EQ(delta.packs.size(), 1);
+    EXPECT_EQ(delta.packs[0].pack_id, ids.pack_id);
+    EXPECT_EQ(delta.packs[0].answers, 3);
+
+    ASSERT_EQ(delta.questions.size(), 1);
+    EXPECT_EQ(delta.questions[0].attempts, 3);
+    EXPECT_EQ(delta.questions[0].correct, 1);
+
+    Utils::HyperLogLog players;
+    ASSERT_TRUE(players.MergeSerialized(delta.questions[0].players));
+    EXPECT_EQ(players.Estimate(), 2);
+
+    ASSERT_EQ(delta.variants.size(), 2);
+    for (const auto& variant : delta.variants) {
+        EXPECT_EQ(variant.picks, variant.variant_id == ids.right ? 1 : 2);
+    }
+}
+
+UTEST(AnswerAggregatorTest, CommittedAnswersAreNotCollectedAgain) {
+    game_userver::AnswerAggregator aggregator;
+    const Ids ids;
+    Answer(aggregator, ids, "alice", true);
+    aggregator.CommitDelta(aggregator.CollectDelta());
+    EXPECT_TRUE(aggregator.CollectDelta().IsEmpty());
+
+    Answer(aggregator, ids, "bob", true);
+    const auto delta = aggregator.CollectDelta();
+    ASSERT_EQ(delta.questions.size(), 1);
+    EXPECT_EQ(delta.questions[0].attempts, 1);
+    EXPECT_EQ(delta.questions[0].correct, 1);
+    ASSERT_EQ(delta.variants.size(), 1);
+    EXPECT_EQ(delta.variants[0].variant_id, ids.right);
+}
+
+UTEST(AnswerAggregatorTest, UncommittedDeltaIsCollectedAgain) {
+    game_userver::AnswerAggregator aggregator;
+    const Ids ids;
+    Answer(aggregator, ids, "alice", true);
+    const auto lost = aggregator.CollectDelta();
+    Answer(aggregator, ids, "bob", false);
+
+    const auto delta = aggregator.CollectDelta();
+    ASSERT_EQ(delta.packs.size(), 1);
+    EXPECT_EQ(delta.packs[0].answers, 2);
+    EXPECT_EQ(lost.packs[0].answers, 1);
+}
+
+UTEST(AnswerAggregatorTest, CommittedEntriesAreDropped) {
+    game_userver::AnswerAggregator aggregator;
+    const Ids ids;
+    Answer(aggregator, ids, "alice", true);
+    Answer(aggregator, ids, "bob", false);
+    EXPECT_EQ(aggregator.GetSize(), 4);
+
+    aggregator.CommitDelta(aggregator.CollectDelta());
+    EXPECT_EQ(aggregator.GetSize(), 0);
+}
+
+UTEST(AnswerAggregatorTest, EntriesAnsweredMeanwhileAreKept) {
+    game_userver::AnswerAggregator aggregator;
+    const Ids ids;
+    Answer(aggregator, ids, "alice", true);
+    const auto delta = aggregator.CollectDelta();
+    Answer(aggregator, ids, "bob", true);
+
+    aggregator.CommitDelta(delta);
+    // The pack, the question and the right variant have a new answer
+    EXPECT_EQ(aggregator.GetSize(), 3);
+    const auto next = aggregator.CollectDelta();
+    ASSERT_EQ(next.packs.size(), 1);
+    EXPECT_EQ(next.packs[0].answers, 1);
+}
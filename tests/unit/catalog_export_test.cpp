@@ -0,0 +1,113 @@
+#include "models/catalog_export.hpp"
+
+#include <algorithm>
+#include <boost/uuid/uuid_io.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/boost_uuid4.hpp>
+
+namespace {
+
+using Models::ExportFormat;
+using userver::utils::generators::GenerateBoostUuid;
+
+struct Fixture {
+    Models::ExportedPack pack{
+        GenerateBoostUuid(), "Capitals, \"hard\"", 2,
+        "2026-03-01T10:00:00.000000Z"
+    };
+    boost::uuids::uuid question_id = GenerateBoostUuid();
+    boost::uuids::uuid variant_id = GenerateBoostUuid();
+    std::vector<Models::ExportedQuestionRow> rows;
+
+    Fixture() {
+        rows.push_back(
+            {question_id, "Capital of\nFrance?", "", variant_id, "Paris",
+             true}
+        );
+        rows.push_back(
+            {question_id, "Capital of\nFrance?", "", GenerateBoostUuid(),
+             "Lyon", false}
+        );
+        rows.push_back(
+            {GenerateBoostUuid(), "Empty", "https://cdn/1.png", std::nullopt,
+             std::nullopt, std::nullopt}
+        );
+    }
+};
+
+auto CountLines(const std::string& text) -> std::size_t {
+    return static_cast<std::size_t>(
+        std::count(text.begin(), text.end(), '\n')
+    );
+}
+
+} // namespace
+
+TEST(CatalogExportTest, ParsesFormat) {
+    EXPECT_EQ(Models::ParseExportFormat(""), ExportFormat::kNdjson);
+    EXPECT_EQ(Models::ParseExportFormat("ndjson"), ExportFormat::kNdjson);
+    EXPECT_EQ(Models::ParseExportFormat("csv"), ExportFormat::kCsv);
+    EXPECT_EQ(Models::ParseExportFormat("xml"), std::nullopt);
+}
+
+TEST(CatalogExportTest, NdjsonHasOneRecordPerLine) {
+    const Fixture fixture;
+    std::string out;
+    Models::AppendExportedPack(
+        out, ExportFormat::kNdjson, fixture.pack, fixture.rows
+    );
+
+    // The pack, two questions and two variants
+    EXPECT_EQ(CountLines(out), 5);
+    EXPECT_TRUE(Models::GetExportHeader(ExportFormat::kNdjson).empty());
+    EXPECT_EQ(out.find(R"({"type":"pack","id":")"), 0);
+    EXPECT_NE(
+        out.find(R"("title":"Capitals, \"hard\"","version":2)"),
+        std::string::npos
+    );
+    EXPECT_NE(out.find(R"("text":"Capital of\nFrance?")"), std::string::npos);
+    EXPECT_NE(
+        out.find(
+            R"({"type":"variant","id":")" +
+            boost::uuids::to_string(fixture.variant_id) +
+            R"(","question_id":")" +
+            boost::uuids::to_string(fixture.question_id) +
+            R"(","text":"Paris","is_correct":true})"
+        ),
+        std::string::npos
+    );
+}
+
+TEST(CatalogExportTest, CsvQuotesOnlyWhenNeeded) {
+    const Fixture fixture;
+    std::string out;
+    Models::AppendExportedPack(
+        out, ExportFormat::kCsv, fixture.pack, fixture.rows
+    );
+
+    EXPECT_EQ(
+        out.substr(0, out.find("\r\n")),
+        "pack," + boost::uuids::to_string(fixture.pack.id) +
+            R"(,,"Capitals, ""hard""",,,2,2026-03-01T10:00:00.000000Z)"
+    );
+    EXPECT_NE(out.find("\"Capital of\nFrance?\""), std::string::npos);
+    EXPECT_NE(out.find(",Paris,,true,,\r\n"), std::string::npos);
+    EXPECT_NE(out.find(",Empty,https://cdn/1.png,,,\r\n"), std::string::npos);
+}
+
+TEST(CatalogExportTest, CsvRecordsMatchHeader) {
+    Fixture fixture;
+    fixture.pack.title = "Capitals";
+    std::string out{Models::GetExportHeader(ExportFormat::kCsv)};
+    Models::AppendExportedPack(
+        out, ExportFormat::kCsv, fixture.pack, {fixture.rows.back()}
+    );
+
+    std::size_t begin = 0;
+    while (begin < out.size()) {
+        const auto end = out.find("\r\n", begin);
+        const auto line = out.substr(begin, end - begin);
+        EXPECT_EQ(std::count(line.begin(), line.end(), ','), 7) << line;
+        begin = end + 2;
+    }
+}
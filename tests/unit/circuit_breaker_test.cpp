@@ -0,0 +1,88 @@
+#include "utils/circuit_breaker.hpp"
+
+#include <chrono>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using Decision = Utils::CircuitBreaker::Decision;
+
+constexpr Utils::CircuitBreakerSettings kSettings{
+    .failure_threshold = 3,
+    .open_duration = std::chrono::seconds{5},
+};
+
+const Utils::CircuitBreaker::Clock::time_point kNow{};
+
+} // namespace
+
+UTEST(CircuitBreakerTest, OpensAfterConsecutiveFailures) {
+    Utils::CircuitBreaker breaker{kSettings};
+
+    breaker.OnFailure(kNow);
+    breaker.OnFailure(kNow);
+    EXPECT_EQ(breaker.Acquire(kNow), Decision::kAllow);
+
+    breaker.OnFailure(kNow);
+    EXPECT_TRUE(breaker.IsOpen());
+    EXPECT_EQ(breaker.Acquire(kNow), Decision::kReject);
+}
+
+UTEST(CircuitBreakerTest, SuccessResetsFailures) {
+    Utils::CircuitBreaker breaker{kSettings};
+
+    breaker.OnFailure(kNow);
+    breaker.OnFailure(kNow);
+    breaker.OnSuccess();
+    breaker.OnFailure(kNow);
+    breaker.OnFailure(kNow);
+    EXPECT_FALSE(breaker.IsOpen());
+}
+
+UTEST(CircuitBreakerTest, LetsOneProbeThroughAfterOpenDuration) {
+    Utils::CircuitBreaker breaker{kSettings};
+    for (int i = 0; i < 3; ++i) {
+        breaker.OnFailure(kNow);
+    }
+
+    const auto later = kNow + std::chrono::seconds{5};
+    EXPECT_EQ(breaker.Acquire(later), Decision::kProbe);
+    EXPECT_EQ(breaker.Acquire(later), Decision::kReject);
+
+    breaker.OnSuccess();
+    EXPECT_FALSE(breaker.IsOpen());
+    EXPECT_EQ(breaker.Acquire(later), Decision::kAllow);
+}
+
+UTEST(CircuitBreakerTest, FailedProbeReopens) {
+    Utils::CircuitBreaker breaker{kSettings};
+    for (int i = 0; i < 3; ++i) {
+        breaker.OnFailure(kNow);
+    }
+
+    const auto later = kNow + std::chrono::seconds{5};
+    EXPECT_EQ(breaker.Acquire(later), Decision::kProbe);
+    breaker.OnFailure(later);
+
+    EXPECT_EQ(
+        breaker.Acquire(later + std::chrono::seconds{4}), Decision::kReject
+    );
+    EXPECT_EQ(
+        breaker.Acquire(later + std::chrono::seconds{5}), Decision::kProbe
+    );
+}
+
+UTEST(CircuitBreakerTest, AbandonedProbeLetsAnotherOneThrough) {
+    Utils::CircuitBreaker breaker{kSettings};
+    for (int i = 0; i < 3; ++i) {
+        breaker.OnFailure(kNow);
+    }
+
+    const auto later = kNow + std::chrono::seconds{6};
+    EXPECT_EQ(breaker.Acquire(later), Decision::kProbe);
+    EXPECT_EQ(breaker.Acquire(later), Decision::kReject);
+
+    breaker.OnProbeAbandoned();
+    EXPECT_TRUE(breaker.IsOpen());
+    EXPECT_EQ(breaker.Acquire(later), Decision::kProbe);
+}
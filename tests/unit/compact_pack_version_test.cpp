@@ -0,0 +1,108 @@
+#include "models/compact_pack_version.hpp"
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/boost_uuid4.hpp>
+
+namespace {
+
+using userver::utils::generators::GenerateBoostUuid;
+
+auto MakePackVersion() -> Models::PackVersion {
+    Models::PackVersion pack_version;
+    pack_version.pack_id = GenerateBoostUuid();
+    pack_version.version = 3;
+    pack_version.title = "Capitals";
+    for (int i = 0; i < 5; ++i) {
+        const auto question_id = GenerateBoostUuid();
+        pack_version.questions.push_back(
+            {question_id, pack_version.pack_id,
+             "Question " + std::to_string(i),
+             i % 2 == 0 ? "https://cdn.example.com/" + std::to_string(i) : ""}
+        );
+        for (int j = 0; j < 4; ++j) {
+            pack_version.variants.push_back(
+                {GenerateBoostUuid(), question_id,
+                 "Variant " + std::to_string(j), j == i % 4}
+            );
+        }
+    }
+    return pack_version;
+}
+
+} // namespace
+
+UTEST(CompactPackVersionTest, KeepsContent) {
+    const auto pack_version = MakePackVersion();
+    const Models::CompactPackVersion compact{pack_version};
+
+    EXPECT_EQ(compact.GetPackId(), pack_version.pack_id);
+    EXPECT_EQ(compact.GetVersion(), 3);
+    EXPECT_EQ(compact.GetTitle(), "Capitals");
+    ASSERT_EQ(compact.GetQuestionCount(), 5);
+    EXPECT_EQ(compact.GetVariantCount(), 20);
+
+    for (const auto& question : pack_version.questions) {
+        const auto index = compact.FindQuestion(question.id);
+        ASSERT_TRUE(index.has_value());
+        EXPECT_EQ(compact.GetQuestionText(*index), question.text);
+        EXPECT_EQ(compact.GetImageUrl(*index), question.image_url);
+        EXPECT_EQ(
+            compact.GetLastVariant(*index) - compact.GetFirstVariant(*index),
+            4
+        );
+    }
+
+    for (const auto& variant : pack_version.variants) {
+        const auto index = compact.FindQuestion(variant.question_id);
+        ASSERT_TRUE(index.has_value());
+        bool found = false;
+        for (auto j = compact.GetFirstVariant(*index);
+             j < compact.GetLastVariant(*index); ++j) {
+            if (compact.GetVariantId(j) == variant.id) {
+                found = true;
+                EXPECT_EQ(compact.GetVariantText(j), variant.text);
+                EXPECT_EQ(compact.IsCorrect(j), variant.is_correct);
+            }
+        }
+        EXPECT_TRUE(found);
+    }
+}
+
+UTEST(CompactPackVersionTest, ChecksAnswers) {
+    const auto pack_version = MakePackVersion();
+    const Models::CompactPackVersion compact{pack_version};
+
+    for (const auto& variant : pack_version.variants) {
+        EXPECT_EQ(
+            compact.CheckAnswer(variant.question_id, variant.id),
+            variant.is_correct
+        );
+
+        const auto answer = compact.FindAnswer(variant.id);
+        ASSERT_TRUE(answer.has_value());
+        EXPECT_EQ(answer->question_id, variant.question_id);
+        EXPECT_EQ(answer->pack_id, pack_version.pack_id);
+        EXPECT_EQ(answer->is_correct, variant.is_correct);
+    }
+
+    const auto unknown = GenerateBoostUuid();
+    EXPECT_FALSE(compact.FindAnswer(unknown).has_value());
+    EXPECT_FALSE(
+        compact.CheckAnswer(pack_version.questions[0].id, unknown).has_value()
+    );
+    EXPECT_FALSE(compact
+                     .CheckAnswer(
+                         pack_version.questions[0].id,
+                         pack_version.variants.back().id
+                     )
+                     .has_value());
+}
+
+UTEST(CompactPackVersionTest, EmptyPack) {
+    Models::PackVersion pack_version;
+    pack_version.pack_id = GenerateBoostUuid();
+    const Models::CompactPackVersion compact{pack_version};
+
+    EXPECT_EQ(compact.GetQuestionCount(), 0);
+    EXPECT_FALSE(compact.FindAnswer(GenerateBoostUuid()).has_value());
+}
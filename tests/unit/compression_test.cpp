@@ -0,0 +1,86 @@
+#include "utils/compression.hpp"
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include <string>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using Utils::ContentEncoding;
+
+auto MakeJson() -> std::string {
+    std::string json = "[";
+    for (int i = 0; i < 100; ++i) {
+        json += R"({"id": ")" + std::to_string(i) + R"(", "title": "Pack"},)";
+    }
+    json.back() = ']';
+    return json;
+}
+
+auto Gunzip(const std::string& compressed, std::size_t size) -> std::string {
+    z_stream stream{};
+    EXPECT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+    std::string data(size, '\0');
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    stream.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    stream.next_out = reinterpret_cast<Bytef*>(data.data());
+    stream.avail_out = static_cast<uInt>(data.size());
+    EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+    data.resize(stream.total_out);
+    inflateEnd(&stream);
+    return data;
+}
+
+} // namespace
+
+UTEST(CompressionTest, NegotiatesEncoding) {
+    EXPECT_EQ(Utils::NegotiateEncoding(""), ContentEncoding::kIdentity);
+    EXPECT_EQ(Utils::NegotiateEncoding("br"), ContentEncoding::kIdentity);
+    EXPECT_EQ(Utils::NegotiateEncoding("gzip"), ContentEncoding::kGzip);
+    EXPECT_EQ(
+        Utils::NegotiateEncoding("gzip, deflate, br, zstd"),
+        ContentEncoding::kZstd
+    );
+    EXPECT_EQ(
+        Utils::NegotiateEncoding("zstd;q=0.5, GZIP"), ContentEncoding::kGzip
+    );
+    EXPECT_EQ(
+        Utils::NegotiateEncoding("gzip;q=0, zstd;q=0"),
+        ContentEncoding::kIdentity
+    );
+    EXPECT_EQ(Utils::NegotiateEncoding("*"), ContentEncoding::kZstd);
+    EXPECT_EQ(
+        Utils::NegotiateEncoding("zstd;q=0, *;q=0.1"), ContentEncoding::kGzip
+    );
+}
+
+UTEST(CompressionTest, GzipRoundTrip) {
+    const auto json = MakeJson();
+    const auto compressed =
+        Utils::Compress(json, ContentEncoding::kGzip, Z_BEST_COMPRESSION);
+    EXPECT_LT(compressed.size(), json.size() / 4);
+    EXPECT_EQ(Gunzip(compressed, json.size()), json);
+}
+
+UTEST(CompressionTest, ZstdRoundTrip) {
+    const auto json = MakeJson();
+    const auto compressed = Utils::Compress(json, ContentEncoding::kZstd, 3);
+    EXPECT_LT(compressed.size(), json.size() / 4);
+
+    std::string decompressed(json.size(), '\0');
+    const auto size = ZSTD_decompress(
+        decompressed.data(), decompressed.size(), compressed.data(),
+        compressed.size()
+    );
+    ASSERT_EQ(ZSTD_isError(size), 0);
+    decompressed.resize(size);
+    EXPECT_EQ(decompressed, json);
+}
+
+UTEST(CompressionTest, IdentityKeepsData) {
+    EXPECT_EQ(Utils::Compress("data", ContentEncoding::kIdentity, 0), "data");
+}
@@ -0,0 +1,79 @@
+#include "utils/hash_ring.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <userver/utest/utest.hpp>
+#include <vector>
+
+#include "utils/hash.hpp"
+
+namespace {
+
+constexpr std::size_t kVirtualNodes = 128;
+constexpr int kKeys = 30'000;
+
+auto KeyHash(int key) -> std::uint64_t {
+    return Utils::HashString("session-" + std::to_string(key));
+}
+
+} // namespace
+
+UTEST(HashRingTest, SingleNodeOwnsEverything) {
+    const Utils::HashRing ring{{"node-1"}, kVirtualNodes};
+    for (int key = 0; key < 1000; ++key) {
+        EXPECT_EQ(ring.GetNode(KeyHash(key)), 0);
+    }
+}
+
+UTEST(HashRingTest, SpreadsKeysEvenly) {
+    const Utils::HashRing ring{{"node-1", "node-2", "node-3"}, kVirtualNodes};
+    std::vector<int> owned(3, 0);
+    for (int key = 0; key < kKeys; ++key) {
+        ++owned[ring.GetNode(KeyHash(key))];
+    }
+    for (const auto count : owned) {
+        EXPECT_GT(count, kKeys / 4);
+        EXPECT_LT(count, kKeys / 2);
+    }
+}
+
+UTEST(HashRingTest, OwnersDoNotDependOnNodeOrder) {
+    const Utils::HashRing ring{{"node-1", "node-2", "node-3"}, kVirtualNodes};
+    const Utils::HashRing reordered{
+        {"node-3", "node-1", "node-2"}, kVirtualNodes
+    };
+    for (int key = 0; key < 1000; ++key) {
+        EXPECT_EQ(
+            ring.GetNodes()[ring.GetNode(KeyHash(key))],
+            reordered.GetNodes()[reordered.GetNode(KeyHash(key))]
+        );
+    }
+}
+
+UTEST(HashRingTest, AddedNodeTakesKeysOnlyForItself) {
+    const Utils::HashRing ring{{"node-1", "node-2", "node-3"}, kVirtualNodes};
+    const Utils::HashRing grown{
+        {"node-1", "node-2", "node-3", "node-4"}, kVirtualNodes
+    };
+    int moved = 0;
+    for (int key = 0; key < kKeys; ++key) {
+        const auto before = ring.GetNode(KeyHash(key));
+        const auto after = grown.GetNode(KeyHash(key));
+        if (before != after) {
+            EXPECT_EQ(after, 3);
+            ++moved;
+        }
+    }
+    EXPECT_GT(moved, kKeys / 6);
+    EXPECT_LT(moved, kKeys / 3);
+}
+
+UTEST(HashRingTest, RejectsBadNodes) {
+    EXPECT_THROW(Utils::HashRing({}, kVirtualNodes), std::invalid_argument);
+    EXPECT_THROW(
+        Utils::HashRing({"node-1", "node-1"}, kVirtualNodes),
+        std::invalid_argument
+    );
+}
@@ -0,0 +1,87 @@
+#include "utils/hedging.hpp"
+
+#include <chrono>
+#include <userver/utest/utest.hpp>
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+UTEST(HedgeBudgetTest, StartsWithBurst) {
+    Utils::HedgeBudget budget{0.1, 2};
+
+    EXPECT_TRUE(budget.TryHedge());
+    EXPECT_TRUE(budget.TryHedge());
+    EXPECT_FALSE(budget.TryHedge());
+}
+
+UTEST(HedgeBudgetTest, EarnsRatioOfRequests) {
+    Utils::HedgeBudget budget{0.1, 2};
+    while (budget.TryHedge()) {
+    }
+
+    for (int i = 0; i < 9; ++i) {
+        budget.OnRequest();
+    }
+    EXPECT_FALSE(budget.TryHedge());
+    budget.OnRequest();
+    EXPECT_TRUE(budget.TryHedge());
+    EXPECT_FALSE(budget.TryHedge());
+}
+
+UTEST(HedgeBudgetTest, SavesAtMostBurst) {
+    Utils::HedgeBudget budget{0.5, 1};
+
+    for (int i = 0; i < 100; ++i) {
+        budget.OnRequest();
+    }
+    EXPECT_TRUE(budget.TryHedge());
+    EXPECT_FALSE(budget.TryHedge());
+}
+
+UTEST(HedgeDelayTest, UsesMaxDelayUntilWindowIsFull) {
+    Utils::HedgeDelay delay{{
+        .percentile = 90,
+        .min_delay = milliseconds{1},
+        .max_delay = milliseconds{50},
+        .window = 10,
+    }};
+
+    for (int i = 0; i < 9; ++i) {
+        delay.Record(microseconds{3000});
+    }
+    EXPECT_EQ(delay.Get(), milliseconds{50});
+}
+
+UTEST(HedgeDelayTest, FollowsPercentile) {
+    Utils::HedgeDelay delay{{
+        .percentile = 90,
+        .min_delay = milliseconds{1},
+        .max_delay = milliseconds{50},
+        .window = 100,
+    }};
+
+    for (int i = 1; i <= 100; ++i) {
+        delay.Record(microseconds{i * 100});
+    }
+    // Up to the histogram precision
+    EXPECT_NEAR(delay.Get().count(), 9000, 10);
+}
+
+UTEST(HedgeDelayTest, ClampsToBounds) {
+    Utils::HedgeDelay delay{{
+        .percentile = 50,
+        .min_delay = milliseconds{2},
+        .max_delay = milliseconds{5},
+        .window = 10,
+    }};
+
+    for (int i = 0; i < 10; ++i) {
+        delay.Record(microseconds{100});
+    }
+    EXPECT_EQ(delay.Get(), milliseconds{2});
+
+    for (int i = 0; i < 10; ++i) {
+        delay.Record(milliseconds{20});
+    }
+    EXPECT_EQ(delay.Get(), milliseconds{5});
+}
@@ -0,0 +1,74 @@
+#include "utils/hyper_log_log.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+auto RelativeError(std::uint64_t estimate, std::uint64_t expected) -> double {
+    return std::abs(
+               static_cast<double>(estimate) - static_cast<double>(expected)
+           ) /
+           static_cast<double>(expected);
+}
+
+} // namespace
+
+UTEST(HyperLogLogTest, EmptyIsZero) {
+    const Utils::HyperLogLog sketch;
+    EXPECT_EQ(sketch.Estimate(), 0);
+}
+
+UTEST(HyperLogLogTest, SmallCardinalityIsAlmostExact) {
+    Utils::HyperLogLog sketch;
+    for (int i = 0; i < 100; ++i) {
+        sketch.Add("player-" + std::to_string(i));
+        // Repeats must not count
+        sketch.Add("player-" + std::to_string(i));
+    }
+    EXPECT_LE(RelativeError(sketch.Estimate(), 100), 0.02);
+}
+
+UTEST(HyperLogLogTest, LargeCardinalityWithinError) {
+    Utils::HyperLogLog sketch;
+    for (int i = 0; i < 200'000; ++i) {
+        sketch.Add("player-" + std::to_string(i));
+    }
+    // ~3 standard errors
+    EXPECT_LE(RelativeError(sketch.Estimate(), 200'000), 0.05);
+}
+
+UTEST(HyperLogLogTest, MergeIsUnionAndIdempotent) {
+    Utils::HyperLogLog first;
+    Utils::HyperLogLog second;
+    for (int i = 0; i < 30'000; ++i) {
+        first.Add("player-" + std::to_string(i));
+        second.Add("player-" + std::to_string(i + 15'000));
+    }
+
+    first.Merge(second);
+    const auto merged = first.Estimate();
+    EXPECT_LE(RelativeError(merged, 45'000), 0.05);
+
+    first.Merge(second);
+    EXPECT_EQ(first.Estimate(), merged);
+}
+
+UTEST(HyperLogLogTest, SerializationRoundTrip) {
+    Utils::HyperLogLog sketch;
+    for (int i = 0; i < 10'000; ++i) {
+        sketch.Add("player-" + std::to_string(i));
+    }
+
+    const auto serialized = sketch.Serialize();
+    EXPECT_EQ(serialized.size(), Utils::HyperLogLog::kSerializedSize);
+
+    Utils::HyperLogLog restored;
+    ASSERT_TRUE(restored.MergeSerialized(serialized));
+    EXPECT_EQ(restored.Estimate(), sketch.Estimate());
+    EXPECT_EQ(restored.Serialize(), serialized);
+
+    EXPECT_FALSE(restored.MergeSerialized("garbage"));
+}
@@ -0,0 +1,147 @@
+#include "utils/journal.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+class TempDir final {
+public:
+    TempDir()
+        : path_(
+              std::filesystem::temp_directory_path() /
+              ("journal-test-" + std::to_string(std::random_device{}()))
+          ) {}
+    ~TempDir() { std::filesystem::remove_all(path_); }
+
+    [[nodiscard]] auto Get() const -> std::string { return path_.string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+auto ReplayAll(Utils::Journal& journal, Utils::Journal::ReplayStats* stats)
+    -> std::vector<std::string> {
+    std::vector<std::string> records;
+    const auto result = journal.Replay([&records](std::string_view record) {
+        records.emplace_back(record);
+    });
+    if (stats != nullptr) {
+        *stats = result;
+    }
+    return records;
+}
+
+auto CountSegments(const std::string& dir) -> std::size_t {
+    return static_cast<std::size_t>(std::distance(
+        std::filesystem::directory_iterator{dir},
+        std::filesystem::directory_iterator{}
+    ));
+}
+
+auto LastSegment(const std::string& dir) -> std::filesystem::path {
+    std::filesystem::path last;
+    for (const auto& entry : std::filesystem::directory_iterator{dir}) {
+        last = std::max(last, entry.path());
+    }
+    return last;
+}
+
+} // namespace
+
+UTEST(JournalTest, ReplaysAppendedRecords) {
+    const TempDir dir;
+    {
+        Utils::Journal journal{{dir.Get()}};
+        EXPECT_TRUE(ReplayAll(journal, nullptr).empty());
+        journal.Append({"first", ""});
+        journal.Append({std::string(100000, 'x')});
+    }
+
+    Utils::Journal journal{{dir.Get()}};
+    Utils::Journal::ReplayStats stats;
+    const auto records = ReplayAll(journal, &stats);
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0], "first");
+    EXPECT_EQ(records[1], "");
+    EXPECT_EQ(records[2], std::string(100000, 'x'));
+    EXPECT_EQ(stats.records, 3);
+    EXPECT_EQ(stats.damaged_segments, 0);
+}
+
+UTEST(JournalTest, TornTailIsCutAndAppendsContinue) {
+    const TempDir dir;
+    {
+        Utils::Journal journal{{dir.Get()}};
+        ReplayAll(journal, nullptr);
+        journal.Append({"kept"});
+        journal.Append({"torn record"});
+    }
+    const auto segment = LastSegment(dir.Get());
+    std::filesystem::resize_file(
+        segment, std::filesystem::file_size(segment) - 3
+    );
+
+    {
+        Utils::Journal journal{{dir.Get()}};
+        Utils::Journal::ReplayStats stats;
+        EXPECT_EQ(ReplayAll(journal, &stats), std::vector<std::string>{"kept"});
+        EXPECT_EQ(stats.damaged_segments, 1);
+        journal.Append({"after"});
+    }
+
+    Utils::Journal journal{{dir.Get()}};
+    Utils::Journal::ReplayStats stats;
+    EXPECT_EQ(
+        ReplayAll(journal, &stats), (std::vector<std::string>{"kept", "after"})
+    );
+    EXPECT_EQ(stats.damaged_segments, 0);
+}
+
+UTEST(JournalTest, DamagedRecordStopsReplay) {
+    const TempDir dir;
+    {
+        Utils::Journal journal{{dir.Get()}};
+        ReplayAll(journal, nullptr);
+        journal.Append({"good", "flipped", "lost"});
+    }
+    {
+        // The first byte of the payload of the second record
+        std::fstream file{
+            LastSegment(dir.Get()),
+            std::ios::in | std::ios::out | std::ios::binary
+        };
+        file.seekp(8 + 4 + 8);
+        file.put('F');
+    }
+
+    Utils::Journal journal{{dir.Get()}};
+    EXPECT_EQ(ReplayAll(journal, nullptr), std::vector<std::string>{"good"});
+}
+
+UTEST(JournalTest, RotationReplacesOldSegments) {
+    const TempDir dir;
+    {
+        Utils::Journal journal{{dir.Get(), 64}};
+        ReplayAll(journal, nullptr);
+        journal.Append({"old 1", "old 2"});
+        EXPECT_FALSE(journal.NeedsRotation());
+        journal.Append({std::string(64, 'o')});
+        EXPECT_TRUE(journal.NeedsRotation());
+
+        journal.Rotate({"snapshot"});
+        EXPECT_FALSE(journal.NeedsRotation());
+        journal.Append({"new"});
+    }
+    EXPECT_EQ(CountSegments(dir.Get()), 1);
+
+    Utils::Journal journal{{dir.Get(), 64}};
+    EXPECT_EQ(
+        ReplayAll(journal, nullptr),
+        (std::vector<std::string>{"snapshot", "new"})
+    );
+}
@@ -0,0 +1,73 @@
+#include "utils/latency_histogram.hpp"
+
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+constexpr std::uint64_t kMaxValue = 60'000'000;
+
+} // namespace
+
+UTEST(LatencyHistogramTest, Empty) {
+    const Utils::LatencyHistogram histogram{kMaxValue};
+
+    EXPECT_EQ(histogram.Count(), 0);
+    EXPECT_EQ(histogram.Percentile(99), 0);
+    EXPECT_EQ(histogram.Mean(), 0);
+}
+
+UTEST(LatencyHistogramTest, SmallValuesAreExact) {
+    Utils::LatencyHistogram histogram{kMaxValue};
+    for (std::uint64_t value = 1; value <= 1000; ++value) {
+        histogram.Record(value);
+    }
+
+    EXPECT_EQ(histogram.Count(), 1000);
+    EXPECT_EQ(histogram.Min(), 1);
+    EXPECT_EQ(histogram.Max(), 1000);
+    EXPECT_EQ(histogram.Percentile(50), 500);
+    EXPECT_EQ(histogram.Percentile(99), 990);
+    EXPECT_EQ(histogram.Percentile(100), 1000);
+    EXPECT_DOUBLE_EQ(histogram.Mean(), 500.5);
+}
+
+UTEST(LatencyHistogramTest, LargeValuesWithinPrecision) {
+    Utils::LatencyHistogram histogram{kMaxValue};
+    for (std::uint64_t value = 1; value <= 100'000; ++value) {
+        histogram.Record(value * 100);
+    }
+
+    const auto expect_near = [](std::uint64_t actual, double expected) {
+        EXPECT_NEAR(static_cast<double>(actual), expected, expected * 0.001);
+    };
+    expect_near(histogram.Percentile(50), 5'000'000);
+    expect_near(histogram.Percentile(90), 9'000'000);
+    expect_near(histogram.Percentile(99.9), 9'990'000);
+    EXPECT_EQ(histogram.Percentile(100), 10'000'000);
+}
+
+UTEST(LatencyHistogramTest, ValuesAboveMaxAreClamped) {
+    Utils::LatencyHistogram histogram{1000};
+    histogram.Record(5000);
+
+    EXPECT_EQ(histogram.Max(), 1000);
+    EXPECT_EQ(histogram.Percentile(50), 1000);
+}
+
+UTEST(LatencyHistogramTest, Merge) {
+    Utils::LatencyHistogram first{kMaxValue};
+    Utils::LatencyHistogram second{kMaxValue};
+    first.Record(10);
+    second.Record(20);
+    second.Record(30);
+
+    first.Merge(second);
+
+    EXPECT_EQ(first.Count(), 3);
+    EXPECT_EQ(first.Min(), 10);
+    EXPECT_EQ(first.Max(), 30);
+    EXPECT_EQ(first.Percentile(50), 20);
+
+    first.Reset();
+    EXPECT_EQ(first.Count(), 0);
+}
@@ -0,0 +1,144 @@
+#include "models/live_room.hpp"
+
+#include <boost/uuid/uuid_io.hpp>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/boost_uuid4.hpp>
+#include <utility>
+
+#include "components/live_rooms/room_registry.hpp"
+
+namespace {
+
+using userver::utils::generators::GenerateBoostUuid;
+
+auto MakeSession() -> Models::LiveSession {
+    Models::PackVersion pack_version;
+    pack_version.pack_id = GenerateBoostUuid();
+    pack_version.version = 1;
+    pack_version.title = "Rivers";
+    for (int i = 0; i < 2; ++i) {
+        const auto question_id = GenerateBoostUuid();
+        pack_version.questions.push_back(
+            {question_id, pack_version.pack_id,
+             "Question " + std::to_string(i), ""}
+        );
+        for (int j = 0; j < 3; ++j) {
+            pack_version.variants.push_back(
+                {GenerateBoostUuid(), question_id,
+                 "Variant " + std::to_string(j), j == 1}
+            );
+        }
+    }
+
+    Models::LiveSession session;
+    session.id = GenerateBoostUuid();
+    session.pack =
+        std::make_shared<const Models::CompactPackVersion>(pack_version);
+    session.round_duration = std::chrono::seconds{10};
+    session.question = 1;
+    session.round_ends_at =
+        std::chrono::steady_clock::now() + session.round_duration;
+    return session;
+}
+
+} // namespace
+
+UTEST(LiveRoomTest, ParsesCommands) {
+    const auto variantId = GenerateBoostUuid();
+    const auto answer = Models::ParseRoomCommand(
+        R"({"type":"answer","variant_id":")" +
+        boost::uuids::to_string(variantId) + R"("})"
+    );
+    ASSERT_TRUE(answer.has_value());
+    EXPECT_EQ(answer->variant_id, variantId);
+}
+
+UTEST(LiveRoomTest, RejectsMalformedCommands) {
+    EXPECT_FALSE(Models::ParseRoomCommand("not json").has_value());
+    EXPECT_FALSE(Models::ParseRoomCommand(R"({"type":"leave"})").has_value());
+    // Skipping is left to the HTTP API
+    EXPECT_FALSE(Models::ParseRoomCommand(R"({"type":"next"})").has_value());
+    EXPECT_FALSE(
+        Models::ParseRoomCommand(R"({"type":"answer","variant_id":"x"})")
+            .has_value()
+    );
+    EXPECT_FALSE(Models::ParseRoomCommand(R"([1, 2])").has_value());
+}
+
+UTEST(LiveRoomTest, ResultsRevealCorrectnessAndCounts) {
+    const auto session = MakeSession();
+    const auto message = userver::formats::json::FromString(
+        Models::MakeResultsMessage(session, 0, {4, 7, 0})
+    );
+
+    EXPECT_EQ(message["type"].As<std::string>(), "results");
+    EXPECT_EQ(message["question_index"].As<int>(), 0);
+    EXPECT_EQ(
+        message["question_id"].As<std::string>(),
+        boost::uuids::to_string(session.pack->GetQuestionId(0))
+    );
+    const auto variants = message["variants"];
+    ASSERT_EQ(variants.GetSize(), 3);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(variants[i]["correct"].As<bool>(), i == 1);
+    }
+    EXPECT_EQ(variants[0]["answers"].As<int>(), 4);
+    EXPECT_EQ(variants[1]["answers"].As<int>(), 7);
+    EXPECT_EQ(variants[2]["answers"].As<int>(), 0);
+}
+
+UTEST(LiveRoomTest, QuestionWrapsTheSession) {
+    const auto session = MakeSession();
+    const auto message = userver::formats::json::FromString(
+        Models::MakeQuestionMessage(session)
+    );
+
+    EXPECT_EQ(message["type"].As<std::string>(), "question");
+    EXPECT_EQ(message["session"]["question_index"].As<int>(), 1);
+    EXPECT_FALSE(message["session"]["question"]["variants"][0].HasMember(
+        "correct"
+    ));
+}
+
+UTEST(LiveRoomTest, JoinLooksUpAgainARoomLeftInBetween) {
+    using game_userver::LiveRoomRegistry;
+
+    LiveRoomRegistry registry;
+    const auto session = MakeSession();
+    const auto queue = LiveRoomRegistry::Queue::Create(4);
+    const auto room = registry.Join(session, 1, queue->GetProducer());
+    ASSERT_TRUE(room);
+
+    // Another participant finds the room, then its last one leaves before
+    // the room is locked to enter it
+    const auto found = registry.FindOrCreate(session);
+    ASSERT_EQ(found, room);
+    registry.Leave(room, 1);
+    EXPECT_EQ(registry.GetSize(), 0);
+
+    const auto otherQueue = LiveRoomRegistry::Queue::Create(4);
+    auto producer = otherQueue->GetProducer();
+    EXPECT_EQ(
+        LiveRoomRegistry::TryEnter(*found, 2, producer),
+        LiveRoomRegistry::EnterResult::kRemoved
+    );
+    {
+        const std::lock_guard lock{found->mutex};
+        EXPECT_TRUE(found->participants.empty());
+    }
+
+    const auto joined = registry.Join(session, 2, std::move(producer));
+    ASSERT_TRUE(joined);
+    EXPECT_NE(joined, room);
+    EXPECT_EQ(registry.Find(session.id), joined);
+    {
+        const std::lock_guard lock{joined->mutex};
+        EXPECT_EQ(joined->participants.count(2), 1);
+    }
+}
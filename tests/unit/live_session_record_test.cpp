@@ -0,0 +1,38 @@
+#include "models/live_session_record.hpp"
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/boost_uuid4.hpp>
+
+using Models::LiveSessionRecord;
+using userver::utils::generators::GenerateBoostUuid;
+
+UTEST(LiveSessionRecordTest, RoundTrips) {
+    const LiveSessionRecord record{
+        LiveSessionRecord::Kind::kStarted,
+        GenerateBoostUuid(),
+        GenerateBoostUuid(),
+        7,
+        20000,
+        3,
+        -1,
+    };
+
+    const auto encoded = Models::EncodeLiveSessionRecord(record);
+    const auto decoded = Models::DecodeLiveSessionRecord(encoded);
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(decoded->kind, record.kind);
+    EXPECT_EQ(decoded->session_id, record.session_id);
+    EXPECT_EQ(decoded->pack_id, record.pack_id);
+    EXPECT_EQ(decoded->version, 7);
+    EXPECT_EQ(decoded->round_duration_ms, 20000);
+    EXPECT_EQ(decoded->question, 3);
+    EXPECT_EQ(decoded->round_ends_at_ms, -1);
+}
+
+UTEST(LiveSessionRecordTest, RejectsGarbage) {
+    auto encoded = Models::EncodeLiveSessionRecord({});
+    EXPECT_FALSE(Models::DecodeLiveSessionRecord(encoded.substr(1)));
+
+    encoded[0] = 42;
+    EXPECT_FALSE(Models::DecodeLiveSessionRecord(encoded));
+}
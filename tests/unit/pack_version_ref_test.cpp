@@ -0,0 +1,38 @@
+#include "models/pack_version.hpp"
+
+#include <boost/uuid/uuid_io.hpp>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+constexpr auto kPackId = "123e4567-e89b-42d3-a456-556642440000";
+
+} // namespace
+
+UTEST(PackVersionRefTest, PackIdOnlyMeansLatest) {
+    const auto ref = Models::ParsePackVersionRef(kPackId);
+
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(boost::uuids::to_string(ref->pack_id), kPackId);
+    EXPECT_FALSE(ref->version.has_value());
+}
+
+UTEST(PackVersionRefTest, PackIdWithVersion) {
+    const auto ref =
+        Models::ParsePackVersionRef(std::string{kPackId} + "@12");
+
+    ASSERT_TRUE(ref.has_value());
+    EXPECT_EQ(boost::uuids::to_string(ref->pack_id), kPackId);
+    EXPECT_EQ(ref->version, 12);
+}
+
+UTEST(PackVersionRefTest, Malformed) {
+    const std::string pack_id{kPackId};
+
+    EXPECT_FALSE(Models::ParsePackVersionRef("").has_value());
+    EXPECT_FALSE(Models::ParsePackVersionRef("not-a-uuid@1").has_value());
+    EXPECT_FALSE(Models::ParsePackVersionRef(pack_id + "@").has_value());
+    EXPECT_FALSE(Models::ParsePackVersionRef(pack_id + "@0").has_value());
+    EXPECT_FALSE(Models::ParsePackVersionRef(pack_id + "@-1").has_value());
+    EXPECT_FALSE(Models::ParsePackVersionRef(pack_id + "@1x").has_value());
+}
@@ -0,0 +1,117 @@
+#include "utils/pprof.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <userver/utest/utest.hpp>
+#include <vector>
+
+namespace {
+
+// Minimal protobuf reader: top-level fields of a message, varints and
+// length-delimited ones only
+struct Fields final {
+    std::multimap<std::uint32_t, std::uint64_t> varints;
+    std::multimap<std::uint32_t, std::string> bytes;
+};
+
+auto ReadVarint(std::string_view& data) -> std::uint64_t {
+    std::uint64_t value = 0;
+    for (int shift = 0; !data.empty(); shift += 7) {
+        const auto byte = static_cast<unsigned char>(data.front());
+        data.remove_prefix(1);
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    return value;
+}
+
+auto ReadFields(std::string_view data) -> Fields {
+    Fields fields;
+    while (!data.empty()) {
+        const auto key = ReadVarint(data);
+        const auto field = static_cast<std::uint32_t>(key >> 3);
+        if ((key & 7) == 0) {
+            fields.varints.emplace(field, ReadVarint(data));
+        } else {
+            const auto size = ReadVarint(data);
+            fields.bytes.emplace(field, std::string{data.substr(0, size)});
+            data.remove_prefix(size);
+        }
+    }
+    return fields;
+}
+
+auto ReadPacked(std::string_view data) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> values;
+    while (!data.empty()) {
+        values.push_back(ReadVarint(data));
+    }
+    return values;
+}
+
+auto MakeProfile() -> Utils::CpuProfile {
+    Utils::CpuProfile profile;
+    profile.stacks = {{0x1010, 0x1020}, {0x1010, 0x1020}, {0x2000}};
+    profile.mappings = {{0x1000, 0x1800, 0, "/usr/bin/game_userver"}};
+    profile.duration = std::chrono::seconds{1};
+    profile.period = std::chrono::milliseconds{10};
+    profile.comments = {"main-task-processor tasks.queued = 3"};
+    return profile;
+}
+
+} // namespace
+
+UTEST(PprofTest, MergesEqualStacks) {
+    const auto profile = ReadFields(Utils::EncodePprof(MakeProfile()));
+
+    std::vector<std::vector<std::uint64_t>> values;
+    for (auto [it, end] = profile.bytes.equal_range(2); it != end; ++it) {
+        const auto sample = ReadFields(it->second);
+        values.push_back(ReadPacked(sample.bytes.find(2)->second));
+    }
+    ASSERT_EQ(values.size(), 2);
+    // Stacks are ordered, so {0x1010, 0x1020} comes first
+    EXPECT_EQ(values[0], (std::vector<std::uint64_t>{2, 20000000}));
+    EXPECT_EQ(values[1], (std::vector<std::uint64_t>{1, 10000000}));
+
+    EXPECT_EQ(profile.bytes.count(4), 3);
+    EXPECT_EQ(profile.varints.find(10)->second, 1000000000);
+    EXPECT_EQ(profile.varints.find(12)->second, 10000000);
+}
+
+UTEST(PprofTest, LocationsReferToMappings) {
+    const auto profile = ReadFields(Utils::EncodePprof(MakeProfile()));
+
+    std::map<std::uint64_t, std::uint64_t> mapping_by_address;
+    for (auto [it, end] = profile.bytes.equal_range(4); it != end; ++it) {
+        const auto location = ReadFields(it->second);
+        const auto mapping = location.varints.find(2);
+        mapping_by_address[location.varints.find(3)->second] =
+            mapping == location.varints.end() ? 0 : mapping->second;
+    }
+    EXPECT_EQ(mapping_by_address[0x1010], 1);
+    EXPECT_EQ(mapping_by_address[0x1020], 1);
+    // Outside of every mapping
+    EXPECT_EQ(mapping_by_address[0x2000], 0);
+}
+
+UTEST(PprofTest, StringTableStartsEmpty) {
+    const auto profile = ReadFields(Utils::EncodePprof(MakeProfile()));
+
+    std::vector<std::string> strings;
+    for (auto [it, end] = profile.bytes.equal_range(6); it != end; ++it) {
+        strings.push_back(it->second);
+    }
+    ASSERT_FALSE(strings.empty());
+    EXPECT_EQ(strings[0], "");
+
+    const auto comment = profile.varints.find(13);
+    ASSERT_NE(comment, profile.varints.end());
+    EXPECT_EQ(
+        strings.at(comment->second), "main-task-processor tasks.queued = 3"
+    );
+}
@@ -0,0 +1,60 @@
+#include "tools/load_generator/replay_request.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <userver/utest/utest.hpp>
+#include <utility>
+#include <vector>
+
+using game_userver::load_generator::ParseReplayRequest;
+using game_userver::load_generator::Protocol;
+
+UTEST(ReplayRequestTest, ParsesHttpRequest) {
+    const auto request = ParseReplayRequest(
+        R"({"protocol": "http", "method": "post", "path": "/create-pack",)"
+        R"( "query": {"title": "Quiz"}, "headers": {"X-Deadline": "500"},)"
+        R"( "body": {"text": "x"}})"
+    );
+    ASSERT_TRUE(request);
+    EXPECT_EQ(request->protocol, Protocol::kHttp);
+    EXPECT_EQ(request->method, "POST");
+    EXPECT_EQ(request->url_path, "/create-pack?title=Quiz");
+    const std::vector<std::pair<std::string, std::string>> headers{
+        {"X-Deadline", "500"}
+    };
+    EXPECT_EQ(request->headers, headers);
+    EXPECT_EQ(request->body, R"({"text":"x"})");
+    EXPECT_EQ(request->GetEndpoint(), "http POST /create-pack");
+}
+
+UTEST(ReplayRequestTest, ParsesGrpcRequest) {
+    const auto request = ParseReplayRequest(
+        R"({"protocol": "grpc", "method": "GetPackById",)"
+        R"( "request": {"id": "1"}})"
+    );
+    ASSERT_TRUE(request);
+    EXPECT_EQ(request->protocol, Protocol::kGrpc);
+    EXPECT_EQ(request->method, "GetPackById");
+    EXPECT_EQ(request->body, R"({"id":"1"})");
+    EXPECT_EQ(request->GetEndpoint(), "grpc QuizService/GetPackById");
+}
+
+UTEST(ReplayRequestTest, SkipsUnrelatedLines) {
+    EXPECT_FALSE(ParseReplayRequest(R"({"request_id": "user-030"})"));
+    EXPECT_FALSE(ParseReplayRequest(R"({"protocol": "ftp", "path": "/"})"));
+}
+
+UTEST(ReplayRequestTest, RejectsMissingFields) {
+    EXPECT_ANY_THROW(ParseReplayRequest(R"({"protocol": "http"})"));
+    EXPECT_ANY_THROW(ParseReplayRequest(R"({"protocol": "grpc"})"));
+    EXPECT_ANY_THROW(ParseReplayRequest("not json"));
+}
+
+UTEST(ReplayRequestTest, RejectsUnsupportedMethod) {
+    EXPECT_THROW(
+        ParseReplayRequest(
+            R"({"protocol": "http", "method": "TRACE", "path": "/ping"})"
+        ),
+        std::runtime_error
+    );
+}
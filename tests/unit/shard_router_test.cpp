@@ -0,0 +1,66 @@
+#include "storage/shard_router.hpp"
+
+#include <boost/uuid/uuid.hpp>
+#include <stdexcept>
+#include <vector>
+#include <userver/utest/utest.hpp>
+
+#include "utils/string_to_uuid.hpp"
+
+namespace {
+
+auto MakeRouter(std::size_t shard_count) -> NStorage::ShardRouter {
+    // Routing never touches the clusters themselves
+    return NStorage::ShardRouter{
+        std::vector<NStorage::ClusterPtr>(shard_count)
+    };
+}
+
+} // namespace
+
+UTEST(ShardRouterTest, ShardOfIsStable) {
+    const auto id = Utils::StringToUuid("123e4567-e89b-42d3-a456-556642440000");
+
+    // Instances must agree on the shard, so the hash must never change
+    EXPECT_EQ(NStorage::GetShardOf(id, 1), 0);
+    EXPECT_EQ(NStorage::GetShardOf(id, 8), NStorage::GetShardOf(id, 8));
+    EXPECT_LT(NStorage::GetShardOf(id, 8), 8);
+}
+
+UTEST(ShardRouterTest, IdsSpreadEvenly) {
+    constexpr std::size_t kShards = 4;
+    constexpr int kIds = 4000;
+
+    std::vector<int> hits(kShards);
+    for (int i = 0; i < kIds; ++i) {
+        ++hits[NStorage::GetShardOf(NStorage::ShardRouter::MakeId(), kShards)];
+    }
+    for (const auto count : hits) {
+        EXPECT_GT(count, kIds / kShards * 8 / 10);
+        EXPECT_LT(count, kIds / kShards * 12 / 10);
+    }
+}
+
+UTEST(ShardRouterTest, ChildIdsLandOnParentShard) {
+    const auto router = MakeRouter(5);
+
+    for (int i = 0; i < 100; ++i) {
+        const auto pack_id = NStorage::ShardRouter::MakeId();
+        const auto question_id = router.MakeIdNextTo(pack_id);
+        const auto variant_id = router.MakeIdNextTo(question_id);
+
+        EXPECT_NE(question_id, pack_id);
+        EXPECT_EQ(
+            NStorage::GetShardOf(question_id, 5),
+            NStorage::GetShardOf(pack_id, 5)
+        );
+        EXPECT_EQ(
+            NStorage::GetShardOf(variant_id, 5),
+            NStorage::GetShardOf(pack_id, 5)
+        );
+    }
+}
+
+UTEST(ShardRouterTest, NoShardsIsAnError) {
+    EXPECT_THROW(MakeRouter(0), std::invalid_argument);
+}
@@ -0,0 +1,124 @@
+#include "utils/single_flight.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+#include "utils/deadline.hpp"
+
+UTEST_MT(SingleFlightTest, ConcurrentCallsShareOneExecution, 4) {
+    Utils::SingleFlight<int, int> flight{"test"};
+    std::atomic<int> calls{0};
+    userver::engine::SingleConsumerEvent release;
+
+    std::vector<userver::engine::TaskWithResult<int>> tasks;
+    for (int i = 0; i < 10; ++i) {
+        tasks.push_back(userver::utils::Async("caller", [&] {
+            return flight.Execute(42, [&calls, &release] {
+                ++calls;
+                EXPECT_TRUE(release.WaitForEvent());
+                return 7;
+            });
+        }));
+    }
+
+    userver::engine::SleepFor(std::chrono::milliseconds{50});
+    release.Send();
+
+    for (auto& task : tasks) {
+        EXPECT_EQ(task.Get(), 7);
+    }
+    EXPECT_EQ(calls.load(), 1);
+}
+
+UTEST(SingleFlightTest, SequentialCallsAreNotCached) {
+    Utils::SingleFlight<int, int> flight{"test"};
+    int calls = 0;
+
+    EXPECT_EQ(flight.Execute(1, [&calls] { return ++calls; }), 1);
+    EXPECT_EQ(flight.Execute(1, [&calls] { return ++calls; }), 2);
+}
+
+UTEST(SingleFlightTest, DifferentKeysRunSeparately) {
+    Utils::SingleFlight<int, int> flight{"test"};
+
+    EXPECT_EQ(flight.Execute(1, [] { return 1; }), 1);
+    EXPECT_EQ(flight.Execute(2, [] { return 2; }), 2);
+}
+
+UTEST(SingleFlightTest, ExceptionIsPropagated) {
+    Utils::SingleFlight<int, int> flight{"test"};
+
+    EXPECT_THROW(
+        {
+            flight.Execute(1, []() -> int {
+                throw std::runtime_error("db is down");
+            });
+        },
+        std::runtime_error
+    );
+    EXPECT_EQ(flight.Execute(1, [] { return 3; }), 3);
+}
+
+UTEST_MT(SingleFlightTest, CancelledLeaderKeepsTheFlight, 2) {
+    Utils::SingleFlight<int, int> flight{"test"};
+    std::atomic<int> calls{0};
+    userver::engine::SingleConsumerEvent release;
+
+    auto leader = userver::utils::Async("leader", [&] {
+        return flight.Execute(1, [&calls, &release] {
+            ++calls;
+            EXPECT_TRUE(release.WaitForEvent());
+            return 7;
+        });
+    });
+    userver::engine::SleepFor(std::chrono::milliseconds{50});
+    leader.SyncCancel();
+
+    auto follower = userver::utils::Async("follower", [&] {
+        return flight.Execute(1, [&calls] {
+            ++calls;
+            return 8;
+        });
+    });
+    userver::engine::SleepFor(std::chrono::milliseconds{50});
+    release.Send();
+
+    EXPECT_EQ(follower.Get(), 7);
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(flight.Execute(1, [] { return 9; }), 9);
+}
+
+UTEST_MT(SingleFlightTest, CallerWaitsUntilItsDeadline, 2) {
+    Utils::SingleFlight<int, int> flight{"test"};
+    userver::engine::SingleConsumerEvent release;
+
+    auto patient = userver::utils::Async("patient", [&] {
+        return flight.Execute(1, [&release] {
+            EXPECT_TRUE(release.WaitForEvent());
+            return 7;
+        });
+    });
+    userver::engine::SleepFor(std::chrono::milliseconds{20});
+
+    EXPECT_THROW(
+        flight.Execute(
+            1,
+            userver::engine::Deadline::FromDuration(
+                std::chrono::milliseconds{10}
+            ),
+            [] { return 8; }
+        ),
+        Utils::DeadlineExceeded
+    );
+
+    // The flight goes on for those who can wait
+    release.Send();
+    EXPECT_EQ(patient.Get(), 7);
+}
@@ -0,0 +1,154 @@
+#include "utils/timer_wheel.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using Wheel = Utils::TimerWheel<int>;
+using std::chrono::milliseconds;
+
+const Wheel::Clock::time_point kStart{};
+constexpr milliseconds kTick{10};
+
+auto AdvanceTo(Wheel& wheel, milliseconds at) -> std::vector<int> {
+    std::vector<int> fired;
+    wheel.Advance(kStart + at, [&fired](int payload) {
+        fired.push_back(payload);
+    });
+    return fired;
+}
+
+} // namespace
+
+UTEST(TimerWheelTest, FiresNoEarlierThanScheduled) {
+    Wheel wheel{kTick, kStart};
+    wheel.Schedule(kStart + milliseconds{25}, 1);
+    wheel.Schedule(kStart + milliseconds{50}, 2);
+
+    EXPECT_TRUE(AdvanceTo(wheel, milliseconds{29}).empty());
+    EXPECT_EQ(AdvanceTo(wheel, milliseconds{30}), std::vector<int>{1});
+    EXPECT_TRUE(AdvanceTo(wheel, milliseconds{49}).empty());
+    EXPECT_EQ(AdvanceTo(wheel, milliseconds{50}), std::vector<int>{2});
+    EXPECT_EQ(wheel.Size(), 0);
+}
+
+UTEST(TimerWheelTest, PastTimersFireOnNextTick) {
+    Wheel wheel{kTick, kStart};
+    EXPECT_TRUE(AdvanceTo(wheel, milliseconds{100}).empty());
+
+    wheel.Schedule(kStart, 1);
+    EXPECT_TRUE(AdvanceTo(wheel, milliseconds{109}).empty());
+    EXPECT_EQ(AdvanceTo(wheel, milliseconds{110}), std::vector<int>{1});
+}
+
+UTEST(TimerWheelTest, CancelIsExact) {
+    Wheel wheel{kTick, kStart};
+    const auto first = wheel.Schedule(kStart + milliseconds{50}, 1);
+    wheel.Schedule(kStart + milliseconds{50}, 2);
+
+    EXPECT_TRUE(wheel.Cancel(first));
+    EXPECT_FALSE(wheel.Cancel(first));
+    EXPECT_EQ(wheel.Size(), 1);
+
+    // The node of the cancelled timer is reused, the old handle stays dead
+    wheel.Schedule(kStart + milliseconds{60}, 3);
+    EXPECT_FALSE(wheel.Cancel(first));
+
+    EXPECT_EQ(AdvanceTo(wheel, milliseconds{60}), (std::vector<int>{2, 3}));
+}
+
+UTEST(TimerWheelTest, CascadesThroughAllLevels) {
+    Wheel wheel{kTick, kStart};
+    // One tick short of, at and past every level boundary
+    const std::vector<std::int64_t> ticks{
+        63,     64,     65,     4095,    4096,
+        4097,   262143, 262144, 262145,  16777214,
+    };
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        wheel.Schedule(kStart + kTick * ticks[i], static_cast<int>(i));
+    }
+
+    std::int64_t now = 0;
+    std::vector<int> fired;
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        // Jumps in coarse steps up to one tick short of the timer
+        while (now + 1000 < ticks[i]) {
+            now += 1000;
+            EXPECT_TRUE(AdvanceTo(wheel, kTick * now).empty()) << now;
+        }
+        now = ticks[i] - 1;
+        EXPECT_TRUE(AdvanceTo(wheel, kTick * now).empty()) << ticks[i];
+        now = ticks[i];
+        EXPECT_EQ(
+            AdvanceTo(wheel, kTick * now),
+            std::vector<int>{static_cast<int>(i)}
+        );
+    }
+    EXPECT_EQ(wheel.Size(), 0);
+}
+
+UTEST(TimerWheelTest, ClampsToHorizon) {
+    Wheel wheel{kTick, kStart};
+    wheel.Schedule(kStart + std::chrono::hours{24 * 365}, 1);
+    EXPECT_EQ(wheel.Size(), 1);
+    EXPECT_EQ(
+        AdvanceTo(wheel, kTick * ((std::int64_t{1} << 24) - 1)),
+        std::vector<int>{1}
+    );
+}
+
+UTEST(TimerWheelTest, FireMayReschedule) {
+    Wheel wheel{kTick, kStart};
+    wheel.Schedule(kStart + milliseconds{10}, 3);
+
+    std::vector<int> fired;
+    const auto fire = [&](int payload) {
+        fired.push_back(payload);
+        if (payload > 1) {
+            // Due right now, still waits for the next tick
+            wheel.Schedule(kStart, payload - 1);
+        }
+    };
+    wheel.Advance(kStart + milliseconds{10}, fire);
+    EXPECT_EQ(fired, std::vector<int>{3});
+    wheel.Advance(kStart + milliseconds{30}, fire);
+    EXPECT_EQ(fired, (std::vector<int>{3, 2, 1}));
+}
+
+UTEST(TimerWheelTest, MatchesSortedOrder) {
+    Wheel wheel{kTick, kStart};
+    std::mt19937 random{42};
+    std::uniform_int_distribution<std::int64_t> delay{0, 300000};
+
+    std::vector<std::pair<std::int64_t, int>> expected;
+    std::vector<Wheel::TimerId> ids;
+    for (int i = 0; i < 5000; ++i) {
+        const auto at = delay(random);
+        ids.push_back(wheel.Schedule(kStart + milliseconds{at}, i));
+        expected.emplace_back(at, i);
+    }
+    for (int i = 0; i < 5000; i += 3) {
+        EXPECT_TRUE(wheel.Cancel(ids[i]));
+    }
+
+    std::int64_t now = 0;
+    std::vector<std::pair<std::int64_t, int>> fired;
+    while (wheel.Size() > 0) {
+        now += 777;
+        wheel.Advance(kStart + milliseconds{now}, [&](int payload) {
+            fired.emplace_back(now, payload);
+        });
+    }
+
+    ASSERT_EQ(fired.size(), 5000 - 1667);
+    for (const auto& [fired_at, payload] : fired) {
+        const auto at = expected[payload].first;
+        EXPECT_NE(payload % 3, 0);
+        EXPECT_GE(fired_at, at);
+        // Fired by the first Advance past the timer's tick
+        EXPECT_LT(fired_at - 777, at + 10);
+    }
+}
@@ -0,0 +1,81 @@
+#include "utils/token_bucket_table.hpp"
+
+#include <string>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+using Utils::TokenBucketSettings;
+using Utils::TokenBucketTable;
+using namespace std::chrono_literals;
+
+constexpr TokenBucketSettings kSettings{.rate = 10, .burst = 3};
+
+} // namespace
+
+UTEST(TokenBucketTableTest, AllowsBurstThenRejects) {
+    TokenBucketTable table;
+    const auto now = TokenBucketTable::Clock::now();
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(table.TryAcquire("player", kSettings, now));
+    }
+    EXPECT_FALSE(table.TryAcquire("player", kSettings, now));
+}
+
+UTEST(TokenBucketTableTest, RefillsOverTime) {
+    TokenBucketTable table;
+    const auto now = TokenBucketTable::Clock::now();
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(table.TryAcquire("player", kSettings, now));
+    }
+    EXPECT_FALSE(table.TryAcquire("player", kSettings, now + 50ms));
+    EXPECT_TRUE(table.TryAcquire("player", kSettings, now + 100ms));
+    EXPECT_FALSE(table.TryAcquire("player", kSettings, now + 100ms));
+
+    // Never refills above the burst
+    const auto later = now + 10s;
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(table.TryAcquire("player", kSettings, later));
+    }
+    EXPECT_FALSE(table.TryAcquire("player", kSettings, later));
+}
+
+UTEST(TokenBucketTableTest, KeysAreIndependent) {
+    TokenBucketTable table;
+    const auto now = TokenBucketTable::Clock::now();
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(table.TryAcquire("alice", kSettings, now));
+    }
+    EXPECT_FALSE(table.TryAcquire("alice", kSettings, now));
+    EXPECT_TRUE(table.TryAcquire("bob", kSettings, now));
+}
+
+UTEST(TokenBucketTableTest, ZeroRateIsUnlimited) {
+    TokenBucketTable table;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(table.TryAcquire("player", {}));
+    }
+    EXPECT_EQ(table.GetSize(), 0);
+}
+
+UTEST(TokenBucketTableTest, RefilledBucketsExpire) {
+    TokenBucketTable table{1};
+    const auto now = TokenBucketTable::Clock::now();
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(table.TryAcquire(std::to_string(i), kSettings, now));
+    }
+    EXPECT_EQ(table.GetSize(), 1000);
+
+    // Every old bucket is full again after 0.1s, so they are swept out
+    const auto later = now + 1s;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(
+            table.TryAcquire("new-" + std::to_string(i), kSettings, later)
+        );
+    }
+    EXPECT_LT(table.GetSize(), 1500);
+}
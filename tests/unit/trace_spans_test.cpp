@@ -0,0 +1,86 @@
+#include "utils/trace_spans.hpp"
+
+#include <chrono>
+#include <string>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/utest/utest.hpp>
+
+namespace {
+
+auto MakeSpan() -> Utils::TraceSpanRecord {
+    const std::chrono::system_clock::time_point start{
+        std::chrono::seconds{1700000000}
+    };
+    return {
+        "storage.GetPackById",
+        "0123456789abcdef0123456789abcdef",
+        "0123456789abcdef",
+        "fedcba9876543210",
+        start,
+        start + std::chrono::microseconds{1500},
+        {{"db.system", "postgresql"}, {"note", "quote \" and\nnewline"}}
+    };
+}
+
+} // namespace
+
+UTEST(TraceSpansTest, FormatsOtlpJson) {
+    const auto json = userver::formats::json::FromString(
+        Utils::FormatOtlpJson("game_userver", {MakeSpan()})
+    );
+
+    const auto resource = json["resourceSpans"][0];
+    EXPECT_EQ(
+        resource["resource"]["attributes"][0]["value"]["stringValue"]
+            .As<std::string>(),
+        "game_userver"
+    );
+
+    const auto span = resource["scopeSpans"][0]["spans"][0];
+    EXPECT_EQ(span["name"].As<std::string>(), "storage.GetPackById");
+    EXPECT_EQ(
+        span["traceId"].As<std::string>(), "0123456789abcdef0123456789abcdef"
+    );
+    EXPECT_EQ(span["parentSpanId"].As<std::string>(), "fedcba9876543210");
+    EXPECT_EQ(
+        span["startTimeUnixNano"].As<std::string>(), "1700000000000000000"
+    );
+    EXPECT_EQ(
+        span["endTimeUnixNano"].As<std::string>(), "1700000000001500000"
+    );
+    EXPECT_EQ(
+        span["attributes"][1]["value"]["stringValue"].As<std::string>(),
+        "quote \" and\nnewline"
+    );
+}
+
+UTEST(TraceSpansTest, RootSpanHasNoParent) {
+    auto root = MakeSpan();
+    root.parent_span_id.clear();
+    root.attributes.clear();
+
+    const auto json = userver::formats::json::FromString(
+        Utils::FormatOtlpJson("game_userver", {root})
+    );
+    const auto span = json["resourceSpans"][0]["scopeSpans"][0]["spans"][0];
+    EXPECT_FALSE(span.HasMember("parentSpanId"));
+    EXPECT_TRUE(span["attributes"].IsEmpty());
+}
+
+UTEST(TraceSpansTest, SamplingIsPerTrace) {
+    const std::string trace_id = "0123456789abcdef0123456789abcdef";
+    EXPECT_FALSE(Utils::IsTraceSampled(trace_id, 0.0));
+    EXPECT_TRUE(Utils::IsTraceSampled(trace_id, 1.0));
+    EXPECT_EQ(
+        Utils::IsTraceSampled(trace_id, 0.5),
+        Utils::IsTraceSampled(trace_id, 0.5)
+    );
+
+    int sampled = 0;
+    for (int i = 0; i < 10000; ++i) {
+        sampled += Utils::IsTraceSampled(std::to_string(i), 0.1) ? 1 : 0;
+    }
+    EXPECT_GT(sampled, 800);
+    EXPECT_LT(sampled, 1200);
+}
@@ -0,0 +1,71 @@
+#include "utils/uuid_v7.hpp"
+
+#include <boost/uuid/uuid.hpp>
+#include <chrono>
+#include <set>
+#include <vector>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+namespace {
+
+const Utils::UuidV7Generator::Clock::time_point kNow{
+    std::chrono::milliseconds{1'700'000'000'123}
+};
+
+} // namespace
+
+UTEST(UuidV7Test, HasVersionVariantAndTimestamp) {
+    Utils::UuidV7Generator generator;
+    const auto id = generator.Generate(kNow);
+
+    EXPECT_EQ(id.data[6] >> 4, 7);
+    EXPECT_EQ(id.data[8] & 0xc0, 0x80);
+    EXPECT_EQ(Utils::GetUuidV7Millis(id), 1'700'000'000'123ULL);
+}
+
+UTEST(UuidV7Test, IncreasesWithinOneMillisecond) {
+    Utils::UuidV7Generator generator;
+
+    auto previous = generator.Generate(kNow);
+    // More ids than the sequence holds, so it carries into the timestamp
+    for (int i = 0; i < 5000; ++i) {
+        const auto id = generator.Generate(kNow);
+        EXPECT_LT(previous, id);
+        previous = id;
+    }
+    EXPECT_EQ(Utils::GetUuidV7Millis(previous), 1'700'000'000'124ULL);
+}
+
+UTEST(UuidV7Test, ClockGoingBackwardsKeepsOrder) {
+    Utils::UuidV7Generator generator;
+
+    const auto first = generator.Generate(kNow);
+    const auto second = generator.Generate(kNow - std::chrono::seconds{1});
+    EXPECT_LT(first, second);
+}
+
+UTEST_MT(UuidV7Test, ConcurrentIdsAreUnique, 4) {
+    Utils::UuidV7Generator generator;
+
+    using Ids = std::vector<boost::uuids::uuid>;
+    std::vector<userver::engine::TaskWithResult<Ids>> tasks;
+    for (int i = 0; i < 4; ++i) {
+        tasks.push_back(userver::utils::Async("generator", [&generator] {
+            Ids ids;
+            for (int j = 0; j < 1000; ++j) {
+                ids.push_back(generator.Generate());
+            }
+            return ids;
+        }));
+    }
+
+    std::set<boost::uuids::uuid> unique;
+    for (auto& task : tasks) {
+        for (const auto& id : task.Get()) {
+            unique.insert(id);
+        }
+    }
+    EXPECT_EQ(unique.size(), 4000);
+}